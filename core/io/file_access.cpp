@@ -34,6 +34,7 @@
 #include "core/crypto/crypto_core.h"
 #include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
+#include "core/io/file_access_memory.h"
 #include "core/io/file_access_pack.h"
 #include "core/io/marshalls.h"
 #include "core/os/os.h"
@@ -44,6 +45,7 @@ FileAccess::FileCloseFailNotify FileAccess::close_fail_notify = nullptr;
 
 bool FileAccess::backup_save = false;
 thread_local Error FileAccess::last_file_open_error = OK;
+thread_local const FileAccess::PrefetchedFile *FileAccess::thread_prefetched_file = nullptr;
 
 Ref<FileAccess> FileAccess::create(AccessType p_access) {
 	ERR_FAIL_INDEX_V(p_access, ACCESS_MAX, nullptr);
@@ -88,9 +90,21 @@ Error FileAccess::reopen(const String &p_path, int p_mode_flags) {
 }
 
 Ref<FileAccess> FileAccess::open(const String &p_path, int p_mode_flags, Error *r_error) {
+	Ref<FileAccess> ret;
+
+	// Contents already read ahead for this thread.
+	if (thread_prefetched_file && !(p_mode_flags & WRITE) && thread_prefetched_file->path == p_path) {
+		Ref<FileAccessMemory> fam;
+		fam.instantiate();
+		fam->open_custom(thread_prefetched_file->data);
+		if (r_error) {
+			*r_error = OK;
+		}
+		return fam;
+	}
+
 	//try packed data first
 
-	Ref<FileAccess> ret;
 	if (!(p_mode_flags & WRITE) && PackedData::get_singleton() && !PackedData::get_singleton()->is_disabled()) {
 		ret = PackedData::get_singleton()->try_open_path(p_path);
 		if (ret.is_valid()) {
@@ -87,6 +87,13 @@ public:
 	typedef void (*FileCloseFailNotify)(const String &);
 
 	typedef Ref<FileAccess> (*CreateFunc)();
+
+	// File contents read ahead of time (e.g. by the resource loader I/O stage).
+	struct PrefetchedFile {
+		String path;
+		Vector<uint8_t> data;
+	};
+
 	bool big_endian = false;
 	bool real_is_double = false;
 
@@ -112,6 +119,7 @@ protected:
 private:
 	static bool backup_save;
 	thread_local static Error last_file_open_error;
+	thread_local static const PrefetchedFile *thread_prefetched_file;
 
 	AccessType _access_type = ACCESS_FILESYSTEM;
 	static CreateFunc create_func[ACCESS_MAX]; /** default file access creation function for a platform */
@@ -125,6 +133,10 @@ private:
 public:
 	static void set_file_close_fail_notify_callback(FileCloseFailNotify p_cbk) { close_fail_notify = p_cbk; }
 
+	// While set, opening the prefetched path for reading on the calling thread is served from memory.
+	static void set_thread_prefetched_file(const PrefetchedFile *p_file) { thread_prefetched_file = p_file; }
+	static const PrefetchedFile *get_thread_prefetched_file() { return thread_prefetched_file; }
+
 	virtual bool is_open() const = 0; ///< true when file is open
 
 	virtual String get_path() const { return ""; } /// returns the path for the current open file
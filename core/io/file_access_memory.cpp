@@ -78,6 +78,15 @@ Error FileAccessMemory::open_custom(const uint8_t *p_data, uint64_t p_len) {
 	return OK;
 }
 
+Error FileAccessMemory::open_custom(const Vector<uint8_t> &p_data) {
+	// The buffer is shared, not copied, so it must not be written to.
+	shared_data = p_data;
+	data = (uint8_t *)shared_data.ptr();
+	length = shared_data.size();
+	pos = 0;
+	return OK;
+}
+
 Error FileAccessMemory::open_internal(const String &p_path, int p_mode_flags) {
 	ERR_FAIL_NULL_V(files, ERR_FILE_NOT_FOUND);
 
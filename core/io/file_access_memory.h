@@ -37,6 +37,7 @@ class FileAccessMemory : public FileAccess {
 	uint8_t *data = nullptr;
 	uint64_t length = 0;
 	mutable uint64_t pos = 0;
+	Vector<uint8_t> shared_data; // Keeps the buffer alive when opened with open_custom(const Vector<uint8_t> &).
 
 	static Ref<FileAccess> create();
 
@@ -45,6 +46,7 @@ public:
 	static void cleanup();
 
 	virtual Error open_custom(const uint8_t *p_data, uint64_t p_len); ///< open a file
+	Error open_custom(const Vector<uint8_t> &p_data); ///< open a file for reading, sharing the buffer instead of copying it
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override; ///< open a file
 	virtual bool is_open() const override; ///< true when file is open
 
@@ -36,9 +36,12 @@
 #include "core/io/image_loader.h"
 #include "core/io/resource_loader.h"
 #include "core/math/math_funcs.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/sort_array.h"
 #include "core/variant/dictionary.h"
+#include "core/variant/typed_array.h"
 
 #include <stdio.h>
 #include <cmath>
@@ -459,67 +462,87 @@ int Image::get_mipmap_count() const {
 	}
 }
 
+// Images with fewer pixels than this are processed on the calling thread,
+// as dispatching to the WorkerThreadPool would cost more than it saves.
+static constexpr uint64_t IMAGE_PARALLEL_MIN_PIXELS = 256 * 256;
+
+// Splits a row based image operation into horizontal stripes processed by the WorkerThreadPool.
+// p_func(from, to) is called for each stripe and must only write to rows in [from, to).
+template <typename F>
+static void _image_process_rows(uint32_t p_rows, uint64_t p_pixels, const F &p_func) {
+	if (p_pixels < IMAGE_PARALLEL_MIN_PIXELS) {
+		p_func(0, p_rows);
+		return;
+	}
+	// A few more stripes than threads helps balance uneven rows.
+	WorkerThreadPool::process_ranges(p_rows, 2, p_func, SNAME("ImageProcessRows"));
+}
+
 //using template generates perfectly optimized code due to constant expression reduction and unused variable removal present in all compilers
 template <uint32_t read_bytes, bool read_alpha, uint32_t write_bytes, bool write_alpha, bool read_gray, bool write_gray>
 static void _convert(int p_width, int p_height, const uint8_t *p_src, uint8_t *p_dst) {
 	constexpr uint32_t max_bytes = MAX(read_bytes, write_bytes);
 
-	for (int y = 0; y < p_height; y++) {
-		for (int x = 0; x < p_width; x++) {
-			const uint8_t *rofs = &p_src[((y * p_width) + x) * (read_bytes + (read_alpha ? 1 : 0))];
-			uint8_t *wofs = &p_dst[((y * p_width) + x) * (write_bytes + (write_alpha ? 1 : 0))];
+	_image_process_rows(p_height, uint64_t(p_width) * p_height, [&](int p_from, int p_to) {
+		for (int y = p_from; y < p_to; y++) {
+			for (int x = 0; x < p_width; x++) {
+				const uint8_t *rofs = &p_src[((y * p_width) + x) * (read_bytes + (read_alpha ? 1 : 0))];
+				uint8_t *wofs = &p_dst[((y * p_width) + x) * (write_bytes + (write_alpha ? 1 : 0))];
 
-			uint8_t rgba[4] = { 0, 0, 0, 255 };
+				uint8_t rgba[4] = { 0, 0, 0, 255 };
 
-			if constexpr (read_gray) {
-				rgba[0] = rofs[0];
-				rgba[1] = rofs[0];
-				rgba[2] = rofs[0];
-			} else {
-				for (uint32_t i = 0; i < max_bytes; i++) {
-					rgba[i] = (i < read_bytes) ? rofs[i] : 0;
+				if constexpr (read_gray) {
+					rgba[0] = rofs[0];
+					rgba[1] = rofs[0];
+					rgba[2] = rofs[0];
+				} else {
+					for (uint32_t i = 0; i < max_bytes; i++) {
+						rgba[i] = (i < read_bytes) ? rofs[i] : 0;
+					}
 				}
-			}
 
-			if constexpr (read_alpha || write_alpha) {
-				rgba[3] = read_alpha ? rofs[read_bytes] : 255;
-			}
+				if constexpr (read_alpha || write_alpha) {
+					rgba[3] = read_alpha ? rofs[read_bytes] : 255;
+				}
 
-			if constexpr (write_gray) {
-				// REC.709
-				const uint8_t luminance = (13938U * rgba[0] + 46869U * rgba[1] + 4729U * rgba[2] + 32768U) >> 16U;
-				wofs[0] = luminance;
-			} else {
-				for (uint32_t i = 0; i < write_bytes; i++) {
-					wofs[i] = rgba[i];
+				if constexpr (write_gray) {
+					// REC.709
+					const uint8_t luminance = (13938U * rgba[0] + 46869U * rgba[1] + 4729U * rgba[2] + 32768U) >> 16U;
+					wofs[0] = luminance;
+				} else {
+					for (uint32_t i = 0; i < write_bytes; i++) {
+						wofs[i] = rgba[i];
+					}
 				}
-			}
 
-			if constexpr (write_alpha) {
-				wofs[write_bytes] = rgba[3];
+				if constexpr (write_alpha) {
+					wofs[write_bytes] = rgba[3];
+				}
 			}
 		}
-	}
+	});
 }
 
 template <typename T, uint32_t read_channels, uint32_t write_channels, T def_zero, T def_one>
 static void _convert_fast(int p_width, int p_height, const T *p_src, T *p_dst) {
-	uint32_t dst_count = 0;
-	uint32_t src_count = 0;
+	_image_process_rows(p_height, uint64_t(p_width) * p_height, [&](int p_from, int p_to) {
+		uint32_t dst_count = p_from * p_width * write_channels;
+		uint32_t src_count = p_from * p_width * read_channels;
 
-	const int resolution = p_width * p_height;
+		const int resolution = (p_to - p_from) * p_width;
 
-	for (int i = 0; i < resolution; i++) {
-		memcpy(p_dst + dst_count, p_src + src_count, MIN(read_channels, write_channels) * sizeof(T));
+		for (int i = 0; i < resolution; i++) {
+			memcpy(p_dst + dst_count, p_src + src_count, MIN(read_channels, write_channels) * sizeof(T));
 
-		if constexpr (write_channels > read_channels) {
-			const T def_value[4] = { def_zero, def_zero, def_zero, def_one };
-			memcpy(p_dst + dst_count + read_channels, &def_value[read_channels], (write_channels - read_channels) * sizeof(T));
-		}
+			if constexpr (write_channels > read_channels) {
+				const T def_value[4] = { def_zero, def_zero, def_zero, def_one };
+				memcpy(p_dst + dst_count + read_channels, &def_value[read_channels], (write_channels - read_channels) * sizeof(T));
+			}
 
-		dst_count += write_channels;
-		src_count += read_channels;
-	}
+			dst_count += write_channels;
+			src_count += read_channels;
+		}
+	});
 }
 
 static bool _are_formats_compatible(Image::Format p_format0, Image::Format p_format1) {
@@ -784,84 +807,87 @@ static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_
 	int height = p_src_height;
 	double xfac = (double)width / p_dst_width;
 	double yfac = (double)height / p_dst_height;
-	// coordinates of source points and coefficients
-	double ox, oy, dx, dy;
-	int ox1, oy1, ox2, oy2;
 	// destination pixel values
 	// width and height decreased by 1
 	int ymax = height - 1;
 	int xmax = width - 1;
 	// temporary pointer
 
-	for (uint32_t y = 0; y < p_dst_height; y++) {
-		// Y coordinates
-		oy = (double)y * yfac - 0.5f;
-		oy1 = (int)oy;
-		dy = oy - (double)oy1;
+	_image_process_rows(p_dst_height, uint64_t(p_dst_width) * p_dst_height, [&](uint32_t p_from, uint32_t p_to) {
+		// coordinates of source points and coefficients
+		double ox, oy, dx, dy;
+		int ox1, oy1, ox2, oy2;
 
-		for (uint32_t x = 0; x < p_dst_width; x++) {
-			// X coordinates
-			ox = (double)x * xfac - 0.5f;
-			ox1 = (int)ox;
-			dx = ox - (double)ox1;
+		for (uint32_t y = p_from; y < p_to; y++) {
+			// Y coordinates
+			oy = (double)y * yfac - 0.5f;
+			oy1 = (int)oy;
+			dy = oy - (double)oy1;
 
-			// initial pixel value
+			for (uint32_t x = 0; x < p_dst_width; x++) {
+				// X coordinates
+				ox = (double)x * xfac - 0.5f;
+				ox1 = (int)ox;
+				dx = ox - (double)ox1;
 
-			T *__restrict dst = ((T *)p_dst) + (y * p_dst_width + x) * CC;
+				// initial pixel value
 
-			double color[CC];
-			for (int i = 0; i < CC; i++) {
-				color[i] = 0;
-			}
-
-			for (int n = -1; n < 3; n++) {
-				// get Y coefficient
-				[[maybe_unused]] double k1 = _bicubic_interp_kernel(dy - (double)n);
+				T *__restrict dst = ((T *)p_dst) + (y * p_dst_width + x) * CC;
 
-				oy2 = oy1 + n;
-				if (oy2 < 0) {
-					oy2 = 0;
-				}
-				if (oy2 > ymax) {
-					oy2 = ymax;
+				double color[CC];
+				for (int i = 0; i < CC; i++) {
+					color[i] = 0;
 				}
 
-				for (int m = -1; m < 3; m++) {
-					// get X coefficient
-					[[maybe_unused]] double k2 = k1 * _bicubic_interp_kernel((double)m - dx);
+				for (int n = -1; n < 3; n++) {
+					// get Y coefficient
+					[[maybe_unused]] double k1 = _bicubic_interp_kernel(dy - (double)n);
 
-					ox2 = ox1 + m;
-					if (ox2 < 0) {
-						ox2 = 0;
+					oy2 = oy1 + n;
+					if (oy2 < 0) {
+						oy2 = 0;
 					}
-					if (ox2 > xmax) {
-						ox2 = xmax;
+					if (oy2 > ymax) {
+						oy2 = ymax;
 					}
 
-					// get pixel of original image
-					const T *__restrict p = ((T *)p_src) + (oy2 * p_src_width + ox2) * CC;
+					for (int m = -1; m < 3; m++) {
+						// get X coefficient
+						[[maybe_unused]] double k2 = k1 * _bicubic_interp_kernel((double)m - dx);
 
-					for (int i = 0; i < CC; i++) {
-						if constexpr (sizeof(T) == 2) { //half float
-							color[i] = Math::half_to_float(p[i]);
-						} else {
-							color[i] += p[i] * k2;
+						ox2 = ox1 + m;
+						if (ox2 < 0) {
+							ox2 = 0;
+						}
+						if (ox2 > xmax) {
+							ox2 = xmax;
+						}
+
+						// get pixel of original image
+						const T *__restrict p = ((T *)p_src) + (oy2 * p_src_width + ox2) * CC;
+
+						for (int i = 0; i < CC; i++) {
+							if constexpr (sizeof(T) == 2) { //half float
+								color[i] = Math::half_to_float(p[i]);
+							} else {
+								color[i] += p[i] * k2;
+							}
 						}
 					}
 				}
-			}
 
-			for (int i = 0; i < CC; i++) {
-				if constexpr (sizeof(T) == 1) { //byte
-					dst[i] = CLAMP(Math::fast_ftoi(color[i]), 0, 255);
-				} else if constexpr (sizeof(T) == 2) { //half float
-					dst[i] = Math::make_half_float(color[i]);
-				} else {
-					dst[i] = color[i];
+				for (int i = 0; i < CC; i++) {
+					if constexpr (sizeof(T) == 1) { //byte
+						dst[i] = CLAMP(Math::fast_ftoi(color[i]), 0, 255);
+					} else if constexpr (sizeof(T) == 2) { //half float
+						dst[i] = Math::make_half_float(color[i]);
+					} else {
+						dst[i] = color[i];
+					}
 				}
 			}
 		}
-	}
+	});
 }
 
 template <int CC, typename T>
@@ -871,106 +897,129 @@ static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict
 	constexpr uint32_t FRAC_HALF = (FRAC_LEN >> 1);
 	constexpr uint32_t FRAC_MASK = FRAC_LEN - 1;
 
-	for (uint32_t i = 0; i < p_dst_height; i++) {
-		// Add 0.5 in order to interpolate based on pixel center
-		uint32_t src_yofs_up_fp = (i + 0.5) * p_src_height * FRAC_LEN / p_dst_height;
-		// Calculate nearest src pixel center above current, and truncate to get y index
-		uint32_t src_yofs_up = src_yofs_up_fp >= FRAC_HALF ? (src_yofs_up_fp - FRAC_HALF) >> FRAC_BITS : 0;
-		uint32_t src_yofs_down = (src_yofs_up_fp + FRAC_HALF) >> FRAC_BITS;
-		if (src_yofs_down >= p_src_height) {
-			src_yofs_down = p_src_height - 1;
+	// The horizontal sample positions are the same for every row, so compute them once
+	// (left offset, right offset and fraction per destination column).
+	uint32_t *x_table = memnew_arr(uint32_t, p_dst_width * 3);
+	for (uint32_t j = 0; j < p_dst_width; j++) {
+		uint32_t src_xofs_left_fp = (j + 0.5) * p_src_width * FRAC_LEN / p_dst_width;
+		uint32_t src_xofs_left = src_xofs_left_fp >= FRAC_HALF ? (src_xofs_left_fp - FRAC_HALF) >> FRAC_BITS : 0;
+		uint32_t src_xofs_right = (src_xofs_left_fp + FRAC_HALF) >> FRAC_BITS;
+		if (src_xofs_right >= p_src_width) {
+			src_xofs_right = p_src_width - 1;
 		}
-		// Calculate distance to pixel center of src_yofs_up
-		uint32_t src_yofs_frac = src_yofs_up_fp & FRAC_MASK;
-		src_yofs_frac = src_yofs_frac >= FRAC_HALF ? src_yofs_frac - FRAC_HALF : src_yofs_frac + FRAC_HALF;
-
-		uint32_t y_ofs_up = src_yofs_up * p_src_width * CC;
-		uint32_t y_ofs_down = src_yofs_down * p_src_width * CC;
-
-		for (uint32_t j = 0; j < p_dst_width; j++) {
-			uint32_t src_xofs_left_fp = (j + 0.5) * p_src_width * FRAC_LEN / p_dst_width;
-			uint32_t src_xofs_left = src_xofs_left_fp >= FRAC_HALF ? (src_xofs_left_fp - FRAC_HALF) >> FRAC_BITS : 0;
-			uint32_t src_xofs_right = (src_xofs_left_fp + FRAC_HALF) >> FRAC_BITS;
-			if (src_xofs_right >= p_src_width) {
-				src_xofs_right = p_src_width - 1;
+		uint32_t src_xofs_frac = src_xofs_left_fp & FRAC_MASK;
+		src_xofs_frac = src_xofs_frac >= FRAC_HALF ? src_xofs_frac - FRAC_HALF : src_xofs_frac + FRAC_HALF;
+
+		x_table[j * 3 + 0] = src_xofs_left * CC;
+		x_table[j * 3 + 1] = src_xofs_right * CC;
+		x_table[j * 3 + 2] = src_xofs_frac;
+	}
+
+	_image_process_rows(p_dst_height, uint64_t(p_dst_width) * p_dst_height, [&](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			// Add 0.5 in order to interpolate based on pixel center
+			uint32_t src_yofs_up_fp = (i + 0.5) * p_src_height * FRAC_LEN / p_dst_height;
+			// Calculate nearest src pixel center above current, and truncate to get y index
+			uint32_t src_yofs_up = src_yofs_up_fp >= FRAC_HALF ? (src_yofs_up_fp - FRAC_HALF) >> FRAC_BITS : 0;
+			uint32_t src_yofs_down = (src_yofs_up_fp + FRAC_HALF) >> FRAC_BITS;
+			if (src_yofs_down >= p_src_height) {
+				src_yofs_down = p_src_height - 1;
 			}
-			uint32_t src_xofs_frac = src_xofs_left_fp & FRAC_MASK;
-			src_xofs_frac = src_xofs_frac >= FRAC_HALF ? src_xofs_frac - FRAC_HALF : src_xofs_frac + FRAC_HALF;
-
-			src_xofs_left *= CC;
-			src_xofs_right *= CC;
-
-			for (uint32_t l = 0; l < CC; l++) {
-				if constexpr (sizeof(T) == 1) { //uint8
-					uint32_t p00 = p_src[y_ofs_up + src_xofs_left + l] << FRAC_BITS;
-					uint32_t p10 = p_src[y_ofs_up + src_xofs_right + l] << FRAC_BITS;
-					uint32_t p01 = p_src[y_ofs_down + src_xofs_left + l] << FRAC_BITS;
-					uint32_t p11 = p_src[y_ofs_down + src_xofs_right + l] << FRAC_BITS;
-
-					uint32_t interp_up = p00 + (((p10 - p00) * src_xofs_frac) >> FRAC_BITS);
-					uint32_t interp_down = p01 + (((p11 - p01) * src_xofs_frac) >> FRAC_BITS);
-					uint32_t interp = interp_up + (((interp_down - interp_up) * src_yofs_frac) >> FRAC_BITS);
-					interp >>= FRAC_BITS;
-					p_dst[i * p_dst_width * CC + j * CC + l] = uint8_t(interp);
-				} else if constexpr (sizeof(T) == 2) { //half float
-
-					float xofs_frac = float(src_xofs_frac) / (1 << FRAC_BITS);
-					float yofs_frac = float(src_yofs_frac) / (1 << FRAC_BITS);
-					const T *src = ((const T *)p_src);
-					T *dst = ((T *)p_dst);
-
-					float p00 = Math::half_to_float(src[y_ofs_up + src_xofs_left + l]);
-					float p10 = Math::half_to_float(src[y_ofs_up + src_xofs_right + l]);
-					float p01 = Math::half_to_float(src[y_ofs_down + src_xofs_left + l]);
-					float p11 = Math::half_to_float(src[y_ofs_down + src_xofs_right + l]);
-
-					float interp_up = p00 + (p10 - p00) * xofs_frac;
-					float interp_down = p01 + (p11 - p01) * xofs_frac;
-					float interp = interp_up + ((interp_down - interp_up) * yofs_frac);
-
-					dst[i * p_dst_width * CC + j * CC + l] = Math::make_half_float(interp);
-				} else if constexpr (sizeof(T) == 4) { //float
-
-					float xofs_frac = float(src_xofs_frac) / (1 << FRAC_BITS);
-					float yofs_frac = float(src_yofs_frac) / (1 << FRAC_BITS);
-					const T *src = ((const T *)p_src);
-					T *dst = ((T *)p_dst);
-
-					float p00 = src[y_ofs_up + src_xofs_left + l];
-					float p10 = src[y_ofs_up + src_xofs_right + l];
-					float p01 = src[y_ofs_down + src_xofs_left + l];
-					float p11 = src[y_ofs_down + src_xofs_right + l];
-
-					float interp_up = p00 + (p10 - p00) * xofs_frac;
-					float interp_down = p01 + (p11 - p01) * xofs_frac;
-					float interp = interp_up + ((interp_down - interp_up) * yofs_frac);
-
-					dst[i * p_dst_width * CC + j * CC + l] = interp;
+			// Calculate distance to pixel center of src_yofs_up
+			uint32_t src_yofs_frac = src_yofs_up_fp & FRAC_MASK;
+			src_yofs_frac = src_yofs_frac >= FRAC_HALF ? src_yofs_frac - FRAC_HALF : src_yofs_frac + FRAC_HALF;
+
+			uint32_t y_ofs_up = src_yofs_up * p_src_width * CC;
+			uint32_t y_ofs_down = src_yofs_down * p_src_width * CC;
+
+			for (uint32_t j = 0; j < p_dst_width; j++) {
+				const uint32_t src_xofs_left = x_table[j * 3 + 0];
+				const uint32_t src_xofs_right = x_table[j * 3 + 1];
+				const uint32_t src_xofs_frac = x_table[j * 3 + 2];
+
+				for (uint32_t l = 0; l < CC; l++) {
+					if constexpr (sizeof(T) == 1) { //uint8
+						uint32_t p00 = p_src[y_ofs_up + src_xofs_left + l] << FRAC_BITS;
+						uint32_t p10 = p_src[y_ofs_up + src_xofs_right + l] << FRAC_BITS;
+						uint32_t p01 = p_src[y_ofs_down + src_xofs_left + l] << FRAC_BITS;
+						uint32_t p11 = p_src[y_ofs_down + src_xofs_right + l] << FRAC_BITS;
+
+						uint32_t interp_up = p00 + (((p10 - p00) * src_xofs_frac) >> FRAC_BITS);
+						uint32_t interp_down = p01 + (((p11 - p01) * src_xofs_frac) >> FRAC_BITS);
+						uint32_t interp = interp_up + (((interp_down - interp_up) * src_yofs_frac) >> FRAC_BITS);
+						interp >>= FRAC_BITS;
+						p_dst[i * p_dst_width * CC + j * CC + l] = uint8_t(interp);
+					} else if constexpr (sizeof(T) == 2) { //half float
+
+						float xofs_frac = float(src_xofs_frac) / (1 << FRAC_BITS);
+						float yofs_frac = float(src_yofs_frac) / (1 << FRAC_BITS);
+						const T *src = ((const T *)p_src);
+						T *dst = ((T *)p_dst);
+
+						float p00 = Math::half_to_float(src[y_ofs_up + src_xofs_left + l]);
+						float p10 = Math::half_to_float(src[y_ofs_up + src_xofs_right + l]);
+						float p01 = Math::half_to_float(src[y_ofs_down + src_xofs_left + l]);
+						float p11 = Math::half_to_float(src[y_ofs_down + src_xofs_right + l]);
+
+						float interp_up = p00 + (p10 - p00) * xofs_frac;
+						float interp_down = p01 + (p11 - p01) * xofs_frac;
+						float interp = interp_up + ((interp_down - interp_up) * yofs_frac);
+
+						dst[i * p_dst_width * CC + j * CC + l] = Math::make_half_float(interp);
+					} else if constexpr (sizeof(T) == 4) { //float
+
+						float xofs_frac = float(src_xofs_frac) / (1 << FRAC_BITS);
+						float yofs_frac = float(src_yofs_frac) / (1 << FRAC_BITS);
+						const T *src = ((const T *)p_src);
+						T *dst = ((T *)p_dst);
+
+						float p00 = src[y_ofs_up + src_xofs_left + l];
+						float p10 = src[y_ofs_up + src_xofs_right + l];
+						float p01 = src[y_ofs_down + src_xofs_left + l];
+						float p11 = src[y_ofs_down + src_xofs_right + l];
+
+						float interp_up = p00 + (p10 - p00) * xofs_frac;
+						float interp_down = p01 + (p11 - p01) * xofs_frac;
+						float interp = interp_up + ((interp_down - interp_up) * yofs_frac);
+
+						dst[i * p_dst_width * CC + j * CC + l] = interp;
+					}
 				}
 			}
 		}
-	}
+	});
+
+	memdelete_arr(x_table);
 }
 
 template <int CC, typename T>
 static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
-	for (uint32_t i = 0; i < p_dst_height; i++) {
-		uint32_t src_yofs = i * p_src_height / p_dst_height;
-		uint32_t y_ofs = src_yofs * p_src_width * CC;
+	// The source column of each destination column is the same for every row, so compute them once.
+	uint32_t *x_table = memnew_arr(uint32_t, p_dst_width);
+	for (uint32_t j = 0; j < p_dst_width; j++) {
+		x_table[j] = uint64_t(j) * p_src_width / p_dst_width * CC;
+	}
+
+	_image_process_rows(p_dst_height, uint64_t(p_dst_width) * p_dst_height, [&](uint32_t p_from, uint32_t p_to) {
+		const T *src = ((const T *)p_src);
+		T *dst = ((T *)p_dst);
 
-		for (uint32_t j = 0; j < p_dst_width; j++) {
-			uint32_t src_xofs = j * p_src_width / p_dst_width;
-			src_xofs *= CC;
+		for (uint32_t i = p_from; i < p_to; i++) {
+			uint32_t src_yofs = i * p_src_height / p_dst_height;
+			const T *src_row = src + src_yofs * p_src_width * CC;
+			T *dst_row = dst + i * p_dst_width * CC;
 
-			for (uint32_t l = 0; l < CC; l++) {
-				const T *src = ((const T *)p_src);
-				T *dst = ((T *)p_dst);
+			for (uint32_t j = 0; j < p_dst_width; j++) {
+				const T *src_pixel = src_row + x_table[j];
 
-				T p = src[y_ofs + src_xofs + l];
-				dst[i * p_dst_width * CC + j * CC + l] = p;
+				for (uint32_t l = 0; l < CC; l++) {
+					dst_row[j * CC + l] = src_pixel[l];
+				}
 			}
 		}
-	}
+	});
+
+	memdelete_arr(x_table);
 }
 
 #define LANCZOS_TYPE 3
@@ -996,47 +1045,50 @@ static void _scale_lanczos(const uint8_t *__restrict p_src, uint8_t *__restrict
 		float scale_factor = MAX(x_scale, 1); // A larger kernel is required only when downscaling
 		int32_t half_kernel = LANCZOS_TYPE * scale_factor;
 
-		float *kernel = memnew_arr(float, half_kernel * 2);
+		// Columns of the intermediate buffer are independent, so the first pass is split by column.
+		_image_process_rows(dst_width, uint64_t(dst_width) * src_height, [&](int32_t p_from, int32_t p_to) {
+			float *kernel = memnew_arr(float, half_kernel * 2);
 
-		for (int32_t buffer_x = 0; buffer_x < dst_width; buffer_x++) {
-			// The corresponding point on the source image
-			float src_x = (buffer_x + 0.5f) * x_scale; // Offset by 0.5 so it uses the pixel's center
-			int32_t start_x = MAX(0, int32_t(src_x) - half_kernel + 1);
-			int32_t end_x = MIN(src_width - 1, int32_t(src_x) + half_kernel);
+			for (int32_t buffer_x = p_from; buffer_x < p_to; buffer_x++) {
+				// The corresponding point on the source image
+				float src_x = (buffer_x + 0.5f) * x_scale; // Offset by 0.5 so it uses the pixel's center
+				int32_t start_x = MAX(0, int32_t(src_x) - half_kernel + 1);
+				int32_t end_x = MIN(src_width - 1, int32_t(src_x) + half_kernel);
 
-			// Create the kernel used by all the pixels of the column
-			for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
-				kernel[target_x - start_x] = _lanczos((target_x + 0.5f - src_x) / scale_factor);
-			}
+				// Create the kernel used by all the pixels of the column
+				for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
+					kernel[target_x - start_x] = _lanczos((target_x + 0.5f - src_x) / scale_factor);
+				}
 
-			for (int32_t buffer_y = 0; buffer_y < src_height; buffer_y++) {
-				float pixel[CC] = { 0 };
-				float weight = 0;
+				for (int32_t buffer_y = 0; buffer_y < src_height; buffer_y++) {
+					float pixel[CC] = { 0 };
+					float weight = 0;
 
-				for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
-					float lanczos_val = kernel[target_x - start_x];
-					weight += lanczos_val;
+					for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
+						float lanczos_val = kernel[target_x - start_x];
+						weight += lanczos_val;
 
-					const T *__restrict src_data = ((const T *)p_src) + (buffer_y * src_width + target_x) * CC;
+						const T *__restrict src_data = ((const T *)p_src) + (buffer_y * src_width + target_x) * CC;
 
-					for (uint32_t i = 0; i < CC; i++) {
-						if constexpr (sizeof(T) == 2) { //half float
-							pixel[i] += Math::half_to_float(src_data[i]) * lanczos_val;
-						} else {
-							pixel[i] += src_data[i] * lanczos_val;
+						for (uint32_t i = 0; i < CC; i++) {
+							if constexpr (sizeof(T) == 2) { //half float
+								pixel[i] += Math::half_to_float(src_data[i]) * lanczos_val;
+							} else {
+								pixel[i] += src_data[i] * lanczos_val;
+							}
 						}
 					}
-				}
 
-				float *dst_data = ((float *)buffer) + (buffer_y * dst_width + buffer_x) * CC;
+					float *dst_data = ((float *)buffer) + (buffer_y * dst_width + buffer_x) * CC;
 
-				for (uint32_t i = 0; i < CC; i++) {
-					dst_data[i] = pixel[i] / weight; // Normalize the sum of all the samples
+					for (uint32_t i = 0; i < CC; i++) {
+						dst_data[i] = pixel[i] / weight; // Normalize the sum of all the samples
+					}
 				}
 			}
-		}
 
-		memdelete_arr(kernel);
+			memdelete_arr(kernel);
+		});
 	} // End of first pass
 
 	{ // SECOND PASS (vertical + result)
@@ -1046,49 +1098,51 @@ static void _scale_lanczos(const uint8_t *__restrict p_src, uint8_t *__restrict
 		float scale_factor = MAX(y_scale, 1);
 		int32_t half_kernel = LANCZOS_TYPE * scale_factor;
 
-		float *kernel = memnew_arr(float, half_kernel * 2);
+		_image_process_rows(dst_height, uint64_t(dst_width) * dst_height, [&](int32_t p_from, int32_t p_to) {
+			float *kernel = memnew_arr(float, half_kernel * 2);
 
-		for (int32_t dst_y = 0; dst_y < dst_height; dst_y++) {
-			float buffer_y = (dst_y + 0.5f) * y_scale;
-			int32_t start_y = MAX(0, int32_t(buffer_y) - half_kernel + 1);
-			int32_t end_y = MIN(src_height - 1, int32_t(buffer_y) + half_kernel);
+			for (int32_t dst_y = p_from; dst_y < p_to; dst_y++) {
+				float buffer_y = (dst_y + 0.5f) * y_scale;
+				int32_t start_y = MAX(0, int32_t(buffer_y) - half_kernel + 1);
+				int32_t end_y = MIN(src_height - 1, int32_t(buffer_y) + half_kernel);
 
-			for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
-				kernel[target_y - start_y] = _lanczos((target_y + 0.5f - buffer_y) / scale_factor);
-			}
+				for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
+					kernel[target_y - start_y] = _lanczos((target_y + 0.5f - buffer_y) / scale_factor);
+				}
 
-			for (int32_t dst_x = 0; dst_x < dst_width; dst_x++) {
-				float pixel[CC] = { 0 };
-				float weight = 0;
+				for (int32_t dst_x = 0; dst_x < dst_width; dst_x++) {
+					float pixel[CC] = { 0 };
+					float weight = 0;
 
-				for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
-					float lanczos_val = kernel[target_y - start_y];
-					weight += lanczos_val;
+					for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
+						float lanczos_val = kernel[target_y - start_y];
+						weight += lanczos_val;
 
-					float *buffer_data = ((float *)buffer) + (target_y * dst_width + dst_x) * CC;
+						float *buffer_data = ((float *)buffer) + (target_y * dst_width + dst_x) * CC;
 
-					for (uint32_t i = 0; i < CC; i++) {
-						pixel[i] += buffer_data[i] * lanczos_val;
+						for (uint32_t i = 0; i < CC; i++) {
+							pixel[i] += buffer_data[i] * lanczos_val;
+						}
 					}
-				}
-
-				T *dst_data = ((T *)p_dst) + (dst_y * dst_width + dst_x) * CC;
 
-				for (uint32_t i = 0; i < CC; i++) {
-					pixel[i] /= weight;
+					T *dst_data = ((T *)p_dst) + (dst_y * dst_width + dst_x) * CC;
 
-					if constexpr (sizeof(T) == 1) { //byte
-						dst_data[i] = CLAMP(Math::fast_ftoi(pixel[i]), 0, 255);
-					} else if constexpr (sizeof(T) == 2) { //half float
-						dst_data[i] = Math::make_half_float(pixel[i]);
-					} else { // float
-						dst_data[i] = pixel[i];
+					for (uint32_t i = 0; i < CC; i++) {
+						pixel[i] /= weight;
+
+						if constexpr (sizeof(T) == 1) { //byte
+							dst_data[i] = CLAMP(Math::fast_ftoi(pixel[i]), 0, 255);
+						} else if constexpr (sizeof(T) == 2) { //half float
+							dst_data[i] = Math::make_half_float(pixel[i]);
+						} else { // float
+							dst_data[i] = pixel[i];
+						}
 					}
 				}
 			}
-		}
 
-		memdelete_arr(kernel);
+			memdelete_arr(kernel);
+		});
 	} // End of second pass
 
 	memdelete_arr(buffer);
@@ -1772,27 +1826,29 @@ static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint3
 	int right_step = (p_width == 1) ? 0 : CC;
 	int down_step = (p_height == 1) ? 0 : (p_width * CC);
 
-	for (uint32_t i = 0; i < dst_h; i++) {
-		const Component *rup_ptr = &p_src[i * 2 * down_step];
-		const Component *rdown_ptr = rup_ptr + down_step;
-		Component *dst_ptr = &p_dst[i * dst_w * CC];
-		uint32_t count = dst_w;
+	_image_process_rows(dst_h, uint64_t(dst_w) * dst_h, [&](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			const Component *rup_ptr = &p_src[i * 2 * down_step];
+			const Component *rdown_ptr = rup_ptr + down_step;
+			Component *dst_ptr = &p_dst[i * dst_w * CC];
+			uint32_t count = dst_w;
+
+			while (count) {
+				count--;
+				for (int j = 0; j < CC; j++) {
+					average_func(dst_ptr[j], rup_ptr[j], rup_ptr[j + right_step], rdown_ptr[j], rdown_ptr[j + right_step]);
+				}
 
-		while (count) {
-			count--;
-			for (int j = 0; j < CC; j++) {
-				average_func(dst_ptr[j], rup_ptr[j], rup_ptr[j + right_step], rdown_ptr[j], rdown_ptr[j + right_step]);
-			}
+				if (renormalize) {
+					renormalize_func(dst_ptr);
+				}
 
-			if (renormalize) {
-				renormalize_func(dst_ptr);
+				dst_ptr += CC;
+				rup_ptr += right_step * 2;
+				rdown_ptr += right_step * 2;
 			}
-
-			dst_ptr += CC;
-			rup_ptr += right_step * 2;
-			rdown_ptr += right_step * 2;
 		}
-	}
+	});
 }
 
 void Image::shrink_x2() {
@@ -2994,6 +3050,81 @@ void Image::blit_rect_mask(const Ref<Image> &p_src, const Ref<Image> &p_mask, co
 	}
 }
 
+// Blends rows [p_from, p_to) of the already clipped rectangles, with the same results as
+// blending each pixel with get_pixel() and set_pixel(), but without the per-pixel lookups.
+void Image::_blend_rect_rows(uint8_t *p_dst, const Image *p_src, const uint8_t *p_src_ptr, const Image *p_mask, const uint8_t *p_mask_ptr, const Rect2i &p_src_rect, const Rect2i &p_dest_rect, int p_from, int p_to) {
+	static float byte_to_float[256];
+	static bool byte_to_float_init = [] {
+		for (int i = 0; i < 256; i++) {
+			byte_to_float[i] = i / 255.0;
+		}
+		return true;
+	}();
+	(void)byte_to_float_init;
+
+	const bool mask_rgba8 = p_mask && p_mask->format == FORMAT_RGBA8;
+	auto masked_out = [&](uint32_t p_ofs) -> bool {
+		if (!p_mask) {
+			return false;
+		}
+		if (mask_rgba8) {
+			return p_mask_ptr[p_ofs * 4 + 3] == 0;
+		}
+		return p_mask->_get_color_at_ofs(p_mask_ptr, p_ofs).a == 0;
+	};
+
+	for (int i = p_from; i < p_to; i++) {
+		// The mask has the same size as the source.
+		const uint32_t src_ofs = (p_src_rect.position.y + i) * p_src->width + p_src_rect.position.x;
+		const uint32_t dst_ofs = (p_dest_rect.position.y + i) * width + p_dest_rect.position.x;
+
+		switch (format) {
+			case FORMAT_RGBA8: {
+				const uint8_t *src = p_src_ptr + src_ofs * 4;
+				uint8_t *dst = p_dst + dst_ofs * 4;
+				for (int j = 0; j < p_dest_rect.size.x; j++, src += 4, dst += 4) {
+					if (src[3] == 0 || masked_out(src_ofs + j)) {
+						continue;
+					}
+					Color sc(byte_to_float[src[0]], byte_to_float[src[1]], byte_to_float[src[2]], byte_to_float[src[3]]);
+					Color dc(byte_to_float[dst[0]], byte_to_float[dst[1]], byte_to_float[dst[2]], byte_to_float[dst[3]]);
+					dc = dc.blend(sc);
+					dst[0] = uint8_t(CLAMP(dc.r * 255.0, 0, 255));
+					dst[1] = uint8_t(CLAMP(dc.g * 255.0, 0, 255));
+					dst[2] = uint8_t(CLAMP(dc.b * 255.0, 0, 255));
+					dst[3] = uint8_t(CLAMP(dc.a * 255.0, 0, 255));
+				}
+			} break;
+			case FORMAT_RGBAF: {
+				const float *src = reinterpret_cast<const float *>(p_src_ptr) + src_ofs * 4;
+				float *dst = reinterpret_cast<float *>(p_dst) + dst_ofs * 4;
+				for (int j = 0; j < p_dest_rect.size.x; j++, src += 4, dst += 4) {
+					if (src[3] == 0 || masked_out(src_ofs + j)) {
+						continue;
+					}
+					Color dc = Color(dst[0], dst[1], dst[2], dst[3]).blend(Color(src[0], src[1], src[2], src[3]));
+					dst[0] = dc.r;
+					dst[1] = dc.g;
+					dst[2] = dc.b;
+					dst[3] = dc.a;
+				}
+			} break;
+			default: {
+				for (int j = 0; j < p_dest_rect.size.x; j++) {
+					if (masked_out(src_ofs + j)) {
+						continue;
+					}
+					Color sc = p_src->_get_color_at_ofs(p_src_ptr, src_ofs + j);
+					if (sc.a != 0) {
+						Color dc = _get_color_at_ofs(p_dst, dst_ofs + j);
+						_set_color_at_ofs(p_dst, dst_ofs + j, dc.blend(sc));
+					}
+				}
+			} break;
+		}
+	}
+}
+
 void Image::blend_rect(const Ref<Image> &p_src, const Rect2i &p_src_rect, const Point2i &p_dest) {
 	ERR_FAIL_COND_MSG(p_src.is_null(), "Cannot blend_rect an image: invalid source Image object.");
 	int dsize = data.size();
@@ -3009,23 +3140,16 @@ void Image::blend_rect(const Ref<Image> &p_src, const Rect2i &p_src_rect, const
 		return;
 	}
 
-	Ref<Image> img = p_src;
+	uint8_t *dst_ptr = data.ptrw();
+	const uint8_t *src_ptr = p_src->data.ptr();
 
-	for (int i = 0; i < dest_rect.size.y; i++) {
-		for (int j = 0; j < dest_rect.size.x; j++) {
-			int src_x = src_rect.position.x + j;
-			int src_y = src_rect.position.y + i;
-
-			int dst_x = dest_rect.position.x + j;
-			int dst_y = dest_rect.position.y + i;
-
-			Color sc = img->get_pixel(src_x, src_y);
-			if (sc.a != 0) {
-				Color dc = get_pixel(dst_x, dst_y);
-				dc = dc.blend(sc);
-				set_pixel(dst_x, dst_y, dc);
-			}
-		}
+	auto blend_rows = [&](int p_from, int p_to) {
+		_blend_rect_rows(dst_ptr, p_src.ptr(), src_ptr, nullptr, nullptr, src_rect, dest_rect, p_from, p_to);
+	};
+	if (p_src.ptr() == this) {
+		blend_rows(0, dest_rect.size.y); // Rows may overlap.
+	} else {
+		_image_process_rows(dest_rect.size.y, uint64_t(dest_rect.size.x) * dest_rect.size.y, blend_rows);
 	}
 }
 
@@ -3049,29 +3173,70 @@ void Image::blend_rect_mask(const Ref<Image> &p_src, const Ref<Image> &p_mask, c
 		return;
 	}
 
-	Ref<Image> img = p_src;
-	Ref<Image> msk = p_mask;
+	uint8_t *dst_ptr = data.ptrw();
+	const uint8_t *src_ptr = p_src->data.ptr();
+	const uint8_t *mask_ptr = p_mask->data.ptr();
 
-	for (int i = 0; i < dest_rect.size.y; i++) {
-		for (int j = 0; j < dest_rect.size.x; j++) {
-			int src_x = src_rect.position.x + j;
-			int src_y = src_rect.position.y + i;
+	auto blend_rows = [&](int p_from, int p_to) {
+		_blend_rect_rows(dst_ptr, p_src.ptr(), src_ptr, p_mask.ptr(), mask_ptr, src_rect, dest_rect, p_from, p_to);
+	};
+	if (p_src.ptr() == this || p_mask.ptr() == this) {
+		blend_rows(0, dest_rect.size.y); // Rows may overlap.
+	} else {
+		_image_process_rows(dest_rect.size.y, uint64_t(dest_rect.size.x) * dest_rect.size.y, blend_rows);
+	}
+}
 
-			// If the mask's pixel is transparent then we skip it
-			//Color c = msk->get_pixel(src_x, src_y);
-			//if (c.a == 0) continue;
-			if (msk->get_pixel(src_x, src_y).a != 0) {
-				int dst_x = dest_rect.position.x + j;
-				int dst_y = dest_rect.position.y + i;
+void Image::blend_rects(const TypedArray<Image> &p_sources, const TypedArray<Rect2i> &p_src_rects, const TypedArray<Vector2i> &p_dests) {
+	ERR_FAIL_COND_MSG(p_sources.size() != p_src_rects.size() || p_sources.size() != p_dests.size(), "The source images, source rectangles and destinations must have the same size.");
+	ERR_FAIL_COND(data.size() == 0);
 
-				Color sc = img->get_pixel(src_x, src_y);
-				if (sc.a != 0) {
-					Color dc = get_pixel(dst_x, dst_y);
-					dc = dc.blend(sc);
-					set_pixel(dst_x, dst_y, dc);
-				}
+	struct BlendRect {
+		Ref<Image> src;
+		Rect2i src_rect;
+		Rect2i dest_rect;
+	};
+
+	LocalVector<BlendRect> rects;
+	uint64_t pixels = 0;
+	bool overlaps_self = false;
+	for (int i = 0; i < p_sources.size(); i++) {
+		Ref<Image> src = p_sources[i];
+		ERR_CONTINUE_MSG(src.is_null() || src->data.size() == 0, vformat("Cannot blend source image %d: invalid or empty Image.", i));
+		ERR_CONTINUE_MSG(src->format != format, vformat("Cannot blend source image %d: its format is different from the destination format.", i));
+
+		BlendRect br;
+		_get_clipped_src_and_dest_rects(src, p_src_rects[i], p_dests[i], br.src_rect, br.dest_rect);
+		if (!br.src_rect.has_area() || !br.dest_rect.has_area()) {
+			continue;
+		}
+		overlaps_self = overlaps_self || src.ptr() == this;
+		pixels += uint64_t(br.dest_rect.size.x) * br.dest_rect.size.y;
+		br.src = src;
+		rects.push_back(br);
+	}
+
+	if (rects.is_empty()) {
+		return;
+	}
+
+	uint8_t *dst_ptr = data.ptrw();
+
+	// Stripes cover destination rows and blend every rectangle in order, so overlapping
+	// rectangles still composite in the order they were given.
+	auto blend_rows = [&](int p_from, int p_to) {
+		for (const BlendRect &br : rects) {
+			int from = MAX(p_from - br.dest_rect.position.y, 0);
+			int to = MIN(p_to - br.dest_rect.position.y, br.dest_rect.size.y);
+			if (from < to) {
+				_blend_rect_rows(dst_ptr, br.src.ptr(), br.src->data.ptr(), nullptr, nullptr, br.src_rect, br.dest_rect, from, to);
 			}
 		}
+	};
+	if (overlaps_self) {
+		blend_rows(0, height);
+	} else {
+		_image_process_rows(height, pixels, blend_rows);
 	}
 }
 
@@ -3610,6 +3775,7 @@ void Image::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("blit_rect_mask", "src", "mask", "src_rect", "dst"), &Image::blit_rect_mask);
 	ClassDB::bind_method(D_METHOD("blend_rect", "src", "src_rect", "dst"), &Image::blend_rect);
 	ClassDB::bind_method(D_METHOD("blend_rect_mask", "src", "mask", "src_rect", "dst"), &Image::blend_rect_mask);
+	ClassDB::bind_method(D_METHOD("blend_rects", "sources", "src_rects", "dsts"), &Image::blend_rects);
 	ClassDB::bind_method(D_METHOD("fill", "color"), &Image::fill);
 	ClassDB::bind_method(D_METHOD("fill_rect", "rect", "color"), &Image::fill_rect);
 
@@ -3637,6 +3803,7 @@ void Image::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("load_svg_from_buffer", "buffer", "scale"), &Image::load_svg_from_buffer, DEFVAL(1.0));
 	ClassDB::bind_method(D_METHOD("load_svg_from_string", "svg_str", "scale"), &Image::load_svg_from_string, DEFVAL(1.0));
+	ClassDB::bind_static_method("Image", D_METHOD("load_images_from_buffers", "buffers"), &Image::load_images_from_buffers);
 
 	ADD_PROPERTY(PropertyInfo(Variant::DICTIONARY, "data", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE), "_set_data", "_get_data");
 
@@ -3876,21 +4043,27 @@ void Image::srgb_to_linear() {
 		int len = data.size() / 4;
 		uint8_t *data_ptr = data.ptrw();
 
-		for (int i = 0; i < len; i++) {
-			data_ptr[(i << 2) + 0] = srgb2lin[data_ptr[(i << 2) + 0]];
-			data_ptr[(i << 2) + 1] = srgb2lin[data_ptr[(i << 2) + 1]];
-			data_ptr[(i << 2) + 2] = srgb2lin[data_ptr[(i << 2) + 2]];
-		}
+		// Pixels (including mipmaps) are independent, so stripe over them directly.
+		_image_process_rows(len, len, [&](int p_from, int p_to) {
+			for (int i = p_from; i < p_to; i++) {
+				data_ptr[(i << 2) + 0] = srgb2lin[data_ptr[(i << 2) + 0]];
+				data_ptr[(i << 2) + 1] = srgb2lin[data_ptr[(i << 2) + 1]];
+				data_ptr[(i << 2) + 2] = srgb2lin[data_ptr[(i << 2) + 2]];
+			}
+		});
 
 	} else if (format == FORMAT_RGB8) {
 		int len = data.size() / 3;
 		uint8_t *data_ptr = data.ptrw();
 
-		for (int i = 0; i < len; i++) {
-			data_ptr[(i * 3) + 0] = srgb2lin[data_ptr[(i * 3) + 0]];
-			data_ptr[(i * 3) + 1] = srgb2lin[data_ptr[(i * 3) + 1]];
-			data_ptr[(i * 3) + 2] = srgb2lin[data_ptr[(i * 3) + 2]];
-		}
+		// Pixels (including mipmaps) are independent, so stripe over them directly.
+		_image_process_rows(len, len, [&](int p_from, int p_to) {
+			for (int i = p_from; i < p_to; i++) {
+				data_ptr[(i * 3) + 0] = srgb2lin[data_ptr[(i * 3) + 0]];
+				data_ptr[(i * 3) + 1] = srgb2lin[data_ptr[(i * 3) + 1]];
+				data_ptr[(i * 3) + 2] = srgb2lin[data_ptr[(i * 3) + 2]];
+			}
+		});
 	}
 }
 
@@ -3907,21 +4080,27 @@ void Image::linear_to_srgb() {
 		int len = data.size() / 4;
 		uint8_t *data_ptr = data.ptrw();
 
-		for (int i = 0; i < len; i++) {
-			data_ptr[(i << 2) + 0] = lin2srgb[data_ptr[(i << 2) + 0]];
-			data_ptr[(i << 2) + 1] = lin2srgb[data_ptr[(i << 2) + 1]];
-			data_ptr[(i << 2) + 2] = lin2srgb[data_ptr[(i << 2) + 2]];
-		}
+		// Pixels (including mipmaps) are independent, so stripe over them directly.
+		_image_process_rows(len, len, [&](int p_from, int p_to) {
+			for (int i = p_from; i < p_to; i++) {
+				data_ptr[(i << 2) + 0] = lin2srgb[data_ptr[(i << 2) + 0]];
+				data_ptr[(i << 2) + 1] = lin2srgb[data_ptr[(i << 2) + 1]];
+				data_ptr[(i << 2) + 2] = lin2srgb[data_ptr[(i << 2) + 2]];
+			}
+		});
 
 	} else if (format == FORMAT_RGB8) {
 		int len = data.size() / 3;
 		uint8_t *data_ptr = data.ptrw();
 
-		for (int i = 0; i < len; i++) {
-			data_ptr[(i * 3) + 0] = lin2srgb[data_ptr[(i * 3) + 0]];
-			data_ptr[(i * 3) + 1] = lin2srgb[data_ptr[(i * 3) + 1]];
-			data_ptr[(i * 3) + 2] = lin2srgb[data_ptr[(i * 3) + 2]];
-		}
+		// Pixels (including mipmaps) are independent, so stripe over them directly.
+		_image_process_rows(len, len, [&](int p_from, int p_to) {
+			for (int i = p_from; i < p_to; i++) {
+				data_ptr[(i * 3) + 0] = lin2srgb[data_ptr[(i * 3) + 0]];
+				data_ptr[(i * 3) + 1] = lin2srgb[data_ptr[(i * 3) + 1]];
+				data_ptr[(i * 3) + 2] = lin2srgb[data_ptr[(i * 3) + 2]];
+			}
+		});
 	}
 }
 
@@ -4115,6 +4294,87 @@ void Image::convert_rgba8_to_bgra8() {
 	}
 }
 
+TypedArray<Image> Image::load_images_from_buffers(const TypedArray<PackedByteArray> &p_buffers) {
+	struct BatchDecode {
+		LocalVector<PackedByteArray> buffers;
+		LocalVector<uint32_t> order;
+		LocalVector<Ref<Image>> images;
+
+		static ImageMemLoadFunc get_loader(const uint8_t *p_data, int p_size) {
+			// Detect the format from the file signature, as the buffers come without a file name.
+			if (p_size >= 8 && memcmp(p_data, "\x89PNG\r\n\x1a\n", 8) == 0) {
+				return _png_mem_loader_func;
+			} else if (p_size >= 3 && p_data[0] == 0xff && p_data[1] == 0xd8 && p_data[2] == 0xff) {
+				return _jpg_mem_loader_func;
+			} else if (p_size >= 12 && memcmp(p_data, "RIFF", 4) == 0 && memcmp(p_data + 8, "WEBP", 4) == 0) {
+				return _webp_mem_loader_func;
+			} else if (p_size >= 2 && p_data[0] == 'B' && p_data[1] == 'M') {
+				return _bmp_mem_loader_func;
+			} else if (p_size >= 12 && memcmp(p_data, "\xabKTX ", 5) == 0) {
+				return _ktx_mem_loader_func;
+			}
+			return nullptr;
+		}
+
+		static void decode(void *p_userdata, uint32_t p_index) {
+			BatchDecode *bd = (BatchDecode *)p_userdata;
+			uint32_t index = bd->order[p_index];
+			const PackedByteArray &buffer = bd->buffers[index];
+
+			ImageMemLoadFunc loader = get_loader(buffer.ptr(), buffer.size());
+			if (!loader) {
+				ERR_PRINT(vformat("Buffer %d is empty or not in a supported image format.", index));
+				return;
+			}
+
+			Ref<Image> image = loader(buffer.ptr(), buffer.size());
+			if (image.is_null() || image->is_empty()) {
+				ERR_PRINT(vformat("Failed to decode the image in buffer %d.", index));
+				return;
+			}
+			bd->images[index] = image;
+		}
+	};
+
+	struct BufferSizeCompare {
+		const LocalVector<PackedByteArray> *buffers = nullptr;
+		_FORCE_INLINE_ bool operator()(uint32_t p_a, uint32_t p_b) const {
+			return (*buffers)[p_a].size() > (*buffers)[p_b].size();
+		}
+	};
+
+	BatchDecode bd;
+	bd.buffers.resize(p_buffers.size());
+	bd.order.resize(p_buffers.size());
+	bd.images.resize(p_buffers.size());
+	for (uint32_t i = 0; i < bd.buffers.size(); i++) {
+		bd.buffers[i] = p_buffers[i];
+		bd.order[i] = i;
+	}
+
+	// Start with the largest buffers, so a big image isn't left decoding alone at the end.
+	SortArray<uint32_t, BufferSizeCompare> sorter;
+	sorter.compare.buffers = &bd.buffers;
+	sorter.sort(bd.order.ptr(), bd.order.size());
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (bd.buffers.size() < 2 || !pool || pool->get_thread_count() < 2 || WorkerThreadPool::get_thread_index() != -1) {
+		for (uint32_t i = 0; i < bd.buffers.size(); i++) {
+			BatchDecode::decode(&bd, i);
+		}
+	} else {
+		WorkerThreadPool::GroupID group_task = pool->add_native_group_task(&BatchDecode::decode, &bd, bd.buffers.size(), -1, true, SNAME("ImageLoadFromBuffers"));
+		pool->wait_for_group_task_completion(group_task);
+	}
+
+	TypedArray<Image> images;
+	images.resize(bd.images.size());
+	for (uint32_t i = 0; i < bd.images.size(); i++) {
+		images[i] = bd.images[i];
+	}
+	return images;
+}
+
 Error Image::_load_from_buffer(const Vector<uint8_t> &p_array, ImageMemLoadFunc p_loader) {
 	int buffer_size = p_array.size();
 
@@ -203,6 +203,7 @@ private:
 	static int64_t _get_dst_image_size(int p_width, int p_height, Format p_format, int &r_mipmaps, int p_mipmaps = -1, int *r_mm_width = nullptr, int *r_mm_height = nullptr);
 	bool _can_modify(Format p_format) const;
 
+	void _blend_rect_rows(uint8_t *p_dst, const Image *p_src, const uint8_t *p_src_ptr, const Image *p_mask, const uint8_t *p_mask_ptr, const Rect2i &p_src_rect, const Rect2i &p_dest_rect, int p_from, int p_to);
 	_FORCE_INLINE_ void _get_clipped_src_and_dest_rects(const Ref<Image> &p_src, const Rect2i &p_src_rect, const Point2i &p_dest, Rect2i &r_clipped_src_rect, Rect2i &r_clipped_dest_rect) const;
 
 	_FORCE_INLINE_ void _put_pixelb(int p_x, int p_y, uint32_t p_pixel_size, uint8_t *p_data, const uint8_t *p_pixel);
@@ -398,6 +399,7 @@ public:
 	void blit_rect_mask(const Ref<Image> &p_src, const Ref<Image> &p_mask, const Rect2i &p_src_rect, const Point2i &p_dest);
 	void blend_rect(const Ref<Image> &p_src, const Rect2i &p_src_rect, const Point2i &p_dest);
 	void blend_rect_mask(const Ref<Image> &p_src, const Ref<Image> &p_mask, const Rect2i &p_src_rect, const Point2i &p_dest);
+	void blend_rects(const TypedArray<Image> &p_sources, const TypedArray<Rect2i> &p_src_rects, const TypedArray<Vector2i> &p_dests);
 	void fill(const Color &p_color);
 	void fill_rect(const Rect2i &p_rect, const Color &p_color);
 
@@ -418,6 +420,8 @@ public:
 	Error load_svg_from_buffer(const Vector<uint8_t> &p_array, float scale = 1.0);
 	Error load_svg_from_string(const String &p_svg_str, float scale = 1.0);
 
+	static TypedArray<Image> load_images_from_buffers(const TypedArray<PackedByteArray> &p_buffers);
+
 	void convert_rg_to_ra_rgba8();
 	void convert_ra_rgba8_to_rg();
 	void convert_rgba8_to_bgra8();
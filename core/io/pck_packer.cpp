@@ -50,6 +50,10 @@ void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_path", "alignment", "key", "encrypt_directory"), &PCKPacker::pck_start, DEFVAL(32), DEFVAL("0000000000000000000000000000000000000000000000000000000000000000"), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file", "pck_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
+
+	ClassDB::bind_method(D_METHOD("set_deduplicate_files", "enable"), &PCKPacker::set_deduplicate_files);
+	ClassDB::bind_method(D_METHOD("is_deduplicating_files"), &PCKPacker::is_deduplicating_files);
+	ClassDB::bind_method(D_METHOD("get_deduplicated_bytes"), &PCKPacker::get_deduplicated_bytes);
 }
 
 Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const String &p_key, bool p_encrypt_directory) {
@@ -101,6 +105,8 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 	file->store_32(pack_flags); // flags
 
 	files.clear();
+	content_offsets.clear();
+	deduplicated_bytes = 0;
 	ofs = 0;
 
 	return OK;
@@ -133,6 +139,27 @@ Error PCKPacker::add_file(const String &p_pck_path, const String &p_src, bool p_
 	}
 	pf.encrypted = p_encrypt;
 
+	if (deduplicate) {
+		// Byte-identical files share a single data range, the directory entries
+		// of the duplicates simply point at the offset of the first copy.
+		unsigned char hash[32];
+		CryptoCore::sha256(data.ptr(), data.size(), hash);
+		String content_key = String::hex_encode_buffer(hash, 32);
+		if (p_encrypt) {
+			content_key += "_enc";
+		}
+
+		const uint64_t *existing_ofs = content_offsets.getptr(content_key);
+		if (existing_ofs) {
+			pf.ofs = *existing_ofs;
+			pf.duplicate = true;
+			deduplicated_bytes += pf.size;
+			files.push_back(pf);
+			return OK;
+		}
+		content_offsets.insert(content_key, pf.ofs);
+	}
+
 	uint64_t _size = pf.size;
 	if (p_encrypt) { // Add encryption overhead.
 		if (_size % 16) { // Pad to encryption block size.
@@ -218,6 +245,14 @@ Error PCKPacker::flush(bool p_verbose) {
 
 	int count = 0;
 	for (int i = 0; i < files.size(); i++) {
+		if (files[i].duplicate) {
+			count += 1;
+			if (p_verbose) {
+				print_line(vformat("[%d/%d - %d%%] PCKPacker flush: %s -> %s (deduplicated)", count, files.size(), float(count) / files.size() * 100, files[i].src_path, files[i].path));
+			}
+			continue;
+		}
+
 		Ref<FileAccess> src = FileAccess::open(files[i].src_path, FileAccess::READ);
 		uint64_t to_write = files[i].size;
 
@@ -254,8 +289,24 @@ Error PCKPacker::flush(bool p_verbose) {
 		}
 	}
 
+	if (p_verbose && deduplicate) {
+		print_line(vformat("PCKPacker flush: %s saved by deduplicating identical files.", String::humanize_size(deduplicated_bytes)));
+	}
+
 	file.unref();
 	memdelete_arr(buf);
 
 	return OK;
 }
+
+void PCKPacker::set_deduplicate_files(bool p_enable) {
+	deduplicate = p_enable;
+}
+
+bool PCKPacker::is_deduplicating_files() const {
+	return deduplicate;
+}
+
+uint64_t PCKPacker::get_deduplicated_bytes() const {
+	return deduplicated_bytes;
+}
@@ -32,6 +32,7 @@
 #define PCK_PACKER_H
 
 #include "core/object/ref_counted.h"
+#include "core/templates/hash_map.h"
 
 class FileAccess;
 
@@ -45,6 +46,9 @@ class PCKPacker : public RefCounted {
 	Vector<uint8_t> key;
 	bool enc_dir = false;
 
+	bool deduplicate = false;
+	uint64_t deduplicated_bytes = 0;
+
 	static void _bind_methods();
 
 	struct File {
@@ -53,15 +57,21 @@ class PCKPacker : public RefCounted {
 		uint64_t ofs = 0;
 		uint64_t size = 0;
 		bool encrypted = false;
+		bool duplicate = false; // Shares the data range of a previously added file.
 		Vector<uint8_t> md5;
 	};
 	Vector<File> files;
+	HashMap<String, uint64_t> content_offsets;
 
 public:
 	Error pck_start(const String &p_pck_path, int p_alignment = 32, const String &p_key = "0000000000000000000000000000000000000000000000000000000000000000", bool p_encrypt_directory = false);
 	Error add_file(const String &p_pck_path, const String &p_src, bool p_encrypt = false);
 	Error flush(bool p_verbose = false);
 
+	void set_deduplicate_files(bool p_enable);
+	bool is_deduplicating_files() const;
+	uint64_t get_deduplicated_bytes() const;
+
 	PCKPacker() {}
 };
 
@@ -685,6 +685,7 @@ Error ResourceLoaderBinary::load() {
 		return error;
 	}
 
+	// Resolve the whole external resource table before starting any load.
 	for (int i = 0; i < external_resources.size(); i++) {
 		String path = external_resources[i].path;
 
@@ -698,6 +699,18 @@ Error ResourceLoaderBinary::load() {
 		}
 
 		external_resources.write[i].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
+
+		if (!use_sub_threads) {
+			// Dependencies will be loaded one after another on this thread, so let the
+			// loader's I/O thread read the later ones while the earlier ones are decoded.
+			ResourceLoader::_read_ahead(path);
+		}
+	}
+
+	// With sub-threads, all dependencies are requested to the worker pool at once and only awaited
+	// when a property actually needs them (see OBJECT_EXTERNAL_RESOURCE_INDEX in parse_variant()).
+	for (int i = 0; i < external_resources.size(); i++) {
+		String path = external_resources[i].path;
 		external_resources.write[i].load_token = ResourceLoader::_load_start(path, external_resources[i].type, use_sub_threads ? ResourceLoader::LOAD_THREAD_DISTRIBUTE : ResourceLoader::LOAD_THREAD_FROM_CURRENT, cache_mode_for_external);
 		if (!external_resources[i].load_token.is_valid()) {
 			if (!ResourceLoader::get_abort_on_missing_resources()) {
@@ -155,6 +155,9 @@ public:
 	virtual Error import_group_file(const String &p_group_file, const HashMap<String, HashMap<StringName, Variant>> &p_source_file_options, const HashMap<String, String> &p_base_paths) { return ERR_UNAVAILABLE; }
 	virtual bool are_import_settings_valid(const String &p_path, const Dictionary &p_meta) const { return true; }
 	virtual String get_import_settings_string() const { return String(); }
+	// Return true if the import result only depends on the source file contents, the options and get_import_settings_string(),
+	// and is only written to the destination paths, so it can be shared through the editor's import cache.
+	virtual bool can_use_import_cache(const HashMap<StringName, Variant> &p_options) const { return false; }
 };
 
 VARIANT_ENUM_CAST(ResourceImporter::ImportOrder);
@@ -319,6 +319,12 @@ Ref<Resource> ResourceLoader::_load(const String &p_path, const String &p_origin
 void ResourceLoader::_run_load_task(void *p_userdata) {
 	ThreadLoadTask &load_task = *(ThreadLoadTask *)p_userdata;
 
+	FileAccess::PrefetchedFile prefetched;
+#ifdef THREADS_ENABLED
+	// Must happen before bailing out, so the I/O thread never outlives its reference to the task.
+	_io_prefetch_take(load_task, prefetched);
+#endif
+
 	{
 		MutexLock thread_load_lock(thread_load_mutex);
 		if (cleaning_tasks) {
@@ -350,8 +356,17 @@ void ResourceLoader::_run_load_task(void *p_userdata) {
 
 	print_verbose("Loading resource: " + remapped_path);
 
+	const FileAccess::PrefetchedFile *prefetched_file_backup = FileAccess::get_thread_prefetched_file();
+	if (!prefetched.path.is_empty()) {
+		FileAccess::set_thread_prefetched_file(&prefetched);
+	}
+
 	Error load_err = OK;
 	Ref<Resource> res = _load(remapped_path, remapped_path != load_task.local_path ? load_task.local_path : String(), load_task.type_hint, load_task.cache_mode, &load_err, load_task.use_sub_threads, &load_task.progress);
+
+	FileAccess::set_thread_prefetched_file(prefetched_file_backup);
+	prefetched = FileAccess::PrefetchedFile(); // Not needed anymore, release the memory.
+
 	if (MessageQueue::get_singleton() != MessageQueue::get_main_singleton()) {
 		MessageQueue::get_singleton()->flush();
 	}
@@ -464,6 +479,139 @@ void ResourceLoader::_run_load_task(void *p_userdata) {
 	curr_load_task = curr_load_task_backup;
 }
 
+#ifdef THREADS_ENABLED
+String ResourceLoader::_io_resolve_data_path(const String &p_local_path) {
+	String path = _path_remap(p_local_path);
+	// Imported resources store their payload in a separate file, which is the one worth reading ahead.
+	if (ResourceFormatImporter::get_singleton()->recognize_path(path)) {
+		String internal_path = ResourceFormatImporter::get_singleton()->get_internal_resource_path(path);
+		if (!internal_path.is_empty()) {
+			path = internal_path;
+		}
+	}
+	return path;
+}
+
+void ResourceLoader::_io_thread_func(void *p_userdata) {
+	while (true) {
+		io_semaphore.wait();
+
+		MutexLock io_lock(io_mutex);
+		if (io_thread_exit) {
+			break;
+		}
+		if (io_queue.is_empty()) {
+			if (io_read_ahead_queue.is_empty()) {
+				continue; // The request was taken back by the task itself.
+			}
+
+			const String local_path = io_read_ahead_queue.front()->get();
+			io_read_ahead_queue.pop_front();
+			io_lock.temp_unlock();
+
+			// Upcoming loads on another thread will read this file; bring it into the OS file cache meanwhile.
+			if (!ResourceCache::has(local_path)) {
+				Ref<FileAccess> f = FileAccess::open(_io_resolve_data_path(local_path), FileAccess::READ);
+				if (f.is_valid()) {
+					uint8_t buf[16384];
+					while (f->get_buffer(buf, sizeof(buf)) == sizeof(buf)) {
+					}
+				}
+			}
+			continue;
+		}
+
+		ThreadLoadTask *load_task = io_queue.front()->get();
+		io_queue.pop_front();
+		load_task->prefetch_queue_elem = nullptr;
+		load_task->prefetch_status = ThreadLoadTask::PREFETCH_READING;
+		io_current_task = load_task;
+		const String local_path = load_task->local_path;
+		const uint64_t budget = io_prefetched_bytes < PREFETCH_MAX_PENDING_BYTES ? PREFETCH_MAX_PENDING_BYTES - io_prefetched_bytes : 0;
+
+		io_lock.temp_unlock();
+
+		FileAccess::PrefetchedFile prefetched;
+		String path = _io_resolve_data_path(local_path);
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+		if (f.is_valid()) {
+			uint64_t len = f->get_length();
+			// Files over budget are left for the pool thread to read, so memory use stays bounded.
+			if (len > 0 && len <= PREFETCH_MAX_FILE_SIZE && len <= budget) {
+				prefetched.data.resize(len);
+				if (f->get_buffer(prefetched.data.ptrw(), len) == len) {
+					prefetched.path = path;
+				} else {
+					prefetched.data.clear();
+				}
+			}
+			f.unref();
+		}
+
+		io_lock.temp_relock();
+
+		io_prefetched_bytes += prefetched.data.size();
+		load_task->prefetched = prefetched;
+		load_task->prefetch_status = ThreadLoadTask::PREFETCH_DONE;
+		io_current_task = nullptr;
+		io_cond.notify_all();
+	}
+}
+
+void ResourceLoader::_io_start_thread() {
+	if (!io_thread.is_started()) {
+		io_thread.start(&ResourceLoader::_io_thread_func, nullptr);
+	}
+}
+
+void ResourceLoader::_io_prefetch_request(ThreadLoadTask *p_load_task) {
+	MutexLock io_lock(io_mutex);
+	if (io_thread_exit) {
+		return;
+	}
+	_io_start_thread();
+	p_load_task->prefetch_queue_elem = io_queue.push_back(p_load_task);
+	p_load_task->prefetch_status = ThreadLoadTask::PREFETCH_QUEUED;
+	io_semaphore.post();
+}
+
+void ResourceLoader::_io_prefetch_take(ThreadLoadTask &p_load_task, FileAccess::PrefetchedFile &r_prefetched) {
+	MutexLock io_lock(io_mutex);
+	switch (p_load_task.prefetch_status) {
+		case ThreadLoadTask::PREFETCH_QUEUED: {
+			// The I/O thread didn't get to it yet; reading here is as fast as waiting for it.
+			io_queue.erase(p_load_task.prefetch_queue_elem);
+			p_load_task.prefetch_queue_elem = nullptr;
+		} break;
+		case ThreadLoadTask::PREFETCH_READING: {
+			while (p_load_task.prefetch_status == ThreadLoadTask::PREFETCH_READING) {
+				io_cond.wait(io_lock);
+			}
+		} break;
+		default: {
+		}
+	}
+	io_prefetched_bytes -= MIN(io_prefetched_bytes, (uint64_t)p_load_task.prefetched.data.size());
+	r_prefetched = p_load_task.prefetched;
+	p_load_task.prefetched = FileAccess::PrefetchedFile();
+	p_load_task.prefetch_status = ThreadLoadTask::PREFETCH_NONE;
+}
+
+void ResourceLoader::_io_prefetch_stop() {
+	MutexLock io_lock(io_mutex);
+	for (ThreadLoadTask *E : io_queue) {
+		E->prefetch_queue_elem = nullptr;
+		E->prefetch_status = ThreadLoadTask::PREFETCH_NONE;
+	}
+	io_queue.clear();
+	io_read_ahead_queue.clear();
+	while (io_current_task) {
+		io_cond.wait(io_lock);
+	}
+	io_prefetched_bytes = 0; // All tasks are about to be released.
+}
+#endif // THREADS_ENABLED
+
 static String _validate_local_path(const String &p_path) {
 	ResourceUID::ID uid = ResourceUID::get_singleton()->text_to_id(p_path);
 	if (uid != ResourceUID::INVALID_ID) {
@@ -613,6 +761,9 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 				load_task_ptr->thread_id = Thread::get_caller_id();
 			}
 		} else {
+#ifdef THREADS_ENABLED
+			_io_prefetch_request(load_task_ptr);
+#endif
 			load_task_ptr->task_id = WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoader::_run_load_task, load_task_ptr);
 		}
 	} // MutexLock(thread_load_mutex).
@@ -624,6 +775,24 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 	return load_token;
 }
 
+// Hints that p_path is about to be loaded from the current thread, so the I/O thread can read it meanwhile.
+void ResourceLoader::_read_ahead(const String &p_path) {
+#ifdef THREADS_ENABLED
+	String local_path = _validate_local_path(p_path);
+	if (ResourceCache::has(local_path)) {
+		return;
+	}
+
+	MutexLock io_lock(io_mutex);
+	if (io_thread_exit) {
+		return;
+	}
+	_io_start_thread();
+	io_read_ahead_queue.push_back(local_path);
+	io_semaphore.post();
+#endif
+}
+
 float ResourceLoader::_dependency_get_progress(const String &p_path) {
 	if (thread_load_tasks.has(p_path)) {
 		ThreadLoadTask &load_task = thread_load_tasks[p_path];
@@ -1336,6 +1505,10 @@ void ResourceLoader::clear_thread_load_tasks() {
 		user_token->unreference();
 	}
 
+#ifdef THREADS_ENABLED
+	_io_prefetch_stop();
+#endif
+
 	thread_load_tasks.clear();
 
 	cleaning_tasks = false;
@@ -1441,7 +1614,18 @@ bool ResourceLoader::is_cleaning_tasks() {
 
 void ResourceLoader::initialize() {}
 
-void ResourceLoader::finalize() {}
+void ResourceLoader::finalize() {
+#ifdef THREADS_ENABLED
+	{
+		MutexLock io_lock(io_mutex);
+		io_thread_exit = true;
+	}
+	if (io_thread.is_started()) {
+		io_semaphore.post();
+		io_thread.wait_to_finish();
+	}
+#endif
+}
 
 ResourceLoadErrorNotify ResourceLoader::err_notify = nullptr;
 DependencyErrorNotify ResourceLoader::dep_err_notify = nullptr;
@@ -1467,6 +1651,18 @@ bool ResourceLoader::cleaning_tasks = false;
 
 HashMap<String, ResourceLoader::LoadToken *> ResourceLoader::user_load_tokens;
 
+#ifdef THREADS_ENABLED
+Thread ResourceLoader::io_thread;
+BinaryMutex ResourceLoader::io_mutex;
+ConditionVariable ResourceLoader::io_cond;
+Semaphore ResourceLoader::io_semaphore;
+List<ResourceLoader::ThreadLoadTask *> ResourceLoader::io_queue;
+List<String> ResourceLoader::io_read_ahead_queue;
+ResourceLoader::ThreadLoadTask *ResourceLoader::io_current_task = nullptr;
+uint64_t ResourceLoader::io_prefetched_bytes = 0;
+bool ResourceLoader::io_thread_exit = false;
+#endif
+
 SelfList<Resource>::List ResourceLoader::remapped_list;
 HashMap<String, Vector<String>> ResourceLoader::translation_remaps;
 HashMap<String, String> ResourceLoader::path_remaps;
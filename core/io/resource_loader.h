@@ -31,6 +31,7 @@
 #ifndef RESOURCE_LOADER_H
 #define RESOURCE_LOADER_H
 
+#include "core/io/file_access.h"
 #include "core/io/resource.h"
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/worker_thread_pool.h"
@@ -137,6 +138,7 @@ public:
 
 	static Ref<LoadToken> _load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode, bool p_for_user = false);
 	static Ref<Resource> _load_complete(LoadToken &p_load_token, Error *r_error);
+	static void _read_ahead(const String &p_path);
 
 private:
 	static LoadToken *_load_threaded_request_reuse_user_token(const String &p_path);
@@ -190,6 +192,17 @@ private:
 		bool use_sub_threads = false;
 		HashSet<String> sub_tasks;
 
+		// Read-ahead of the file data by the I/O thread. Guarded by io_mutex.
+		enum PrefetchStatus {
+			PREFETCH_NONE,
+			PREFETCH_QUEUED,
+			PREFETCH_READING,
+			PREFETCH_DONE,
+		};
+		PrefetchStatus prefetch_status = PREFETCH_NONE;
+		List<ThreadLoadTask *>::Element *prefetch_queue_elem = nullptr;
+		FileAccess::PrefetchedFile prefetched;
+
 		struct ResourceChangedConnection {
 			Resource *source = nullptr;
 			Callable callable;
@@ -200,6 +213,30 @@ private:
 
 	static void _run_load_task(void *p_userdata);
 
+#ifdef THREADS_ENABLED
+	// Dedicated I/O stage: reads the data of tasks queued in the worker pool ahead of time,
+	// so pool threads spend their time decoding rather than blocked on reads.
+	static const uint64_t PREFETCH_MAX_FILE_SIZE = 64 * 1024 * 1024;
+	static const uint64_t PREFETCH_MAX_PENDING_BYTES = 256 * 1024 * 1024;
+
+	static Thread io_thread;
+	static BinaryMutex io_mutex;
+	static ConditionVariable io_cond;
+	static Semaphore io_semaphore;
+	static List<ThreadLoadTask *> io_queue;
+	static List<String> io_read_ahead_queue; // Only warmed up in the OS file cache, not kept in memory.
+	static ThreadLoadTask *io_current_task;
+	static uint64_t io_prefetched_bytes; // Read but not yet taken by their tasks.
+	static bool io_thread_exit;
+
+	static void _io_thread_func(void *p_userdata);
+	static String _io_resolve_data_path(const String &p_local_path);
+	static void _io_start_thread();
+	static void _io_prefetch_request(ThreadLoadTask *p_load_task);
+	static void _io_prefetch_take(ThreadLoadTask &p_load_task, FileAccess::PrefetchedFile &r_prefetched);
+	static void _io_prefetch_stop();
+#endif
+
 	static thread_local int load_nesting;
 	static thread_local HashMap<int, HashMap<String, Ref<Resource>>> res_ref_overrides; // Outermost key is nesting level.
 	static thread_local Vector<String> load_paths_stack;
@@ -287,6 +287,7 @@ void DynamicBVH::clear() {
 	if (bvh_root) {
 		_recurse_delete_node(bvh_root);
 	}
+	refit_leaves.clear();
 	lkhd = -1;
 	opath = 0;
 }
@@ -386,8 +387,51 @@ bool DynamicBVH::update(const ID &p_id, const AABB &p_box) {
 	return true;
 }
 
+bool DynamicBVH::update_deferred(const ID &p_id, const AABB &p_box) {
+	ERR_FAIL_COND_V(!p_id.is_valid(), false);
+	Node *leaf = p_id.node;
+
+	Volume volume;
+	volume.min = p_box.position;
+	volume.max = p_box.position + p_box.size;
+
+	if (leaf->volume.min.is_equal_approx(volume.min) && leaf->volume.max.is_equal_approx(volume.max)) {
+		// noop
+		return false;
+	}
+
+	// Leaves that left their neighborhood are reinserted, so the tree doesn't degrade as objects drift apart.
+	Node *grandparent = leaf->parent ? leaf->parent->parent : nullptr;
+	if (!grandparent || !grandparent->volume.contains(volume)) {
+		return update(p_id, p_box);
+	}
+
+	leaf->volume = volume;
+	refit_leaves.push_back(leaf);
+	return true;
+}
+
+void DynamicBVH::refit() {
+	// Each walk stops at the first ancestor whose volume didn't change, so ancestors shared by many moved leaves are rarely revisited.
+	for (Node *leaf : refit_leaves) {
+		Node *node = leaf->parent;
+		while (node) {
+			const Volume pb = node->volume;
+			node->volume = node->children[0]->volume.merge(node->children[1]->volume);
+			if (!pb.is_not_equal_to(node->volume)) {
+				break;
+			}
+			node = node->parent;
+		}
+	}
+	refit_leaves.clear();
+}
+
 void DynamicBVH::remove(const ID &p_id) {
 	ERR_FAIL_COND(!p_id.is_valid());
+	if (!refit_leaves.is_empty()) {
+		refit(); // The leaf may be pending, don't keep a dangling pointer to it.
+	}
 	Node *leaf = p_id.node;
 	_remove_leaf(leaf);
 	_delete_node(leaf);
@@ -228,6 +228,7 @@ private:
 	int total_leaves = 0;
 	uint32_t opath = 0;
 	uint32_t index = 0;
+	LocalVector<Node *> refit_leaves;
 
 	enum {
 		ALLOCA_STACK_SIZE = 128
@@ -293,6 +294,10 @@ public:
 	void optimize_incremental(int passes);
 	ID insert(const AABB &p_box, void *p_userdata);
 	bool update(const ID &p_id, const AABB &p_box);
+	// Like update(), but leaves that stay inside their grandparent only get their own volume changed, and are refit
+	// later together with the other moved leaves. refit() must be called before querying the tree again.
+	bool update_deferred(const ID &p_id, const AABB &p_box);
+	void refit();
 	void remove(const ID &p_id);
 	void get_elements(List<ID> *r_elements);
 
@@ -309,6 +314,19 @@ public:
 	_FORCE_INLINE_ void aabb_query(const AABB &p_aabb, QueryResult &r_result);
 	template <typename QueryResult>
 	_FORCE_INLINE_ void convex_query(const Plane *p_planes, int p_plane_count, const Vector3 *p_points, int p_point_count, QueryResult &r_result);
+
+	struct ConvexQuery {
+		const Plane *planes = nullptr;
+		int plane_count = 0;
+		const Vector3 *points = nullptr;
+		int point_count = 0;
+	};
+	static constexpr uint32_t MAX_CONVEX_MULTI_QUERIES = 64;
+
+	// Queries up to MAX_CONVEX_MULTI_QUERIES convex volumes in a single traversal. Subtrees are only tested against the volumes their parent intersects.
+	// r_result(p_data, p_mask) is called once per leaf intersecting any volume, with bit i of p_mask set if it intersects volume i.
+	template <typename QueryResult>
+	_FORCE_INLINE_ void convex_query_multi(const ConvexQuery *p_queries, uint32_t p_query_count, QueryResult &r_result);
 	template <typename QueryResult>
 	_FORCE_INLINE_ void ray_query(const Vector3 &p_from, const Vector3 &p_to, QueryResult &r_result);
 
@@ -415,6 +433,80 @@ void DynamicBVH::convex_query(const Plane *p_planes, int p_plane_count, const Ve
 		}
 	} while (depth > 0);
 }
+template <typename QueryResult>
+void DynamicBVH::convex_query_multi(const ConvexQuery *p_queries, uint32_t p_query_count, QueryResult &r_result) {
+	if (!bvh_root || p_query_count == 0) {
+		return;
+	}
+	ERR_FAIL_COND(p_query_count > MAX_CONVEX_MULTI_QUERIES);
+
+	//generate volumes anyway to improve pre-testing
+	Volume volumes[MAX_CONVEX_MULTI_QUERIES];
+	for (uint32_t q = 0; q < p_query_count; q++) {
+		const ConvexQuery &query = p_queries[q];
+		for (int i = 0; i < query.point_count; i++) {
+			if (i == 0) {
+				volumes[q].min = query.points[0];
+				volumes[q].max = query.points[0];
+			} else {
+				volumes[q].min = volumes[q].min.min(query.points[i]);
+				volumes[q].max = volumes[q].max.max(query.points[i]);
+			}
+		}
+	}
+
+	struct StackEntry {
+		const Node *node;
+		uint64_t mask;
+	};
+
+	StackEntry *alloca_stack = (StackEntry *)alloca(ALLOCA_STACK_SIZE * sizeof(StackEntry));
+	StackEntry *stack = alloca_stack;
+	stack[0] = { bvh_root, p_query_count == MAX_CONVEX_MULTI_QUERIES ? ~uint64_t(0) : ((uint64_t(1) << p_query_count) - 1) };
+	int32_t depth = 1;
+	int32_t threshold = ALLOCA_STACK_SIZE - 2;
+
+	LocalVector<StackEntry> aux_stack; //only used in rare occasions when you run out of alloca memory because tree is too unbalanced. Should correct itself over time.
+
+	do {
+		depth--;
+		const Node *n = stack[depth].node;
+		uint64_t parent_mask = stack[depth].mask;
+		uint64_t mask = 0;
+		for (uint32_t q = 0; q < p_query_count; q++) {
+			if (!(parent_mask & (uint64_t(1) << q))) {
+				continue;
+			}
+			const ConvexQuery &query = p_queries[q];
+			if (n->volume.intersects(volumes[q]) && n->volume.intersects_convex(query.planes, query.plane_count, query.points, query.point_count)) {
+				mask |= uint64_t(1) << q;
+			}
+		}
+
+		if (mask) {
+			if (n->is_internal()) {
+				if (depth > threshold) {
+					if (aux_stack.is_empty()) {
+						aux_stack.resize(ALLOCA_STACK_SIZE * 2);
+						memcpy(aux_stack.ptr(), alloca_stack, ALLOCA_STACK_SIZE * sizeof(StackEntry));
+						alloca_stack = nullptr;
+					} else {
+						aux_stack.resize(aux_stack.size() * 2);
+					}
+					stack = aux_stack.ptr();
+					threshold = aux_stack.size() - 2;
+				}
+				stack[depth++] = { n->children[0], mask };
+				stack[depth++] = { n->children[1], mask };
+			} else {
+				if (r_result(n->data, mask)) {
+					return;
+				}
+			}
+		}
+	} while (depth > 0);
+}
+
 template <typename QueryResult>
 void DynamicBVH::ray_query(const Vector3 &p_from, const Vector3 &p_to, QueryResult &r_result) {
 	if (!bvh_root) {
@@ -258,6 +258,40 @@ public:
 	bool is_group_task_completed(GroupID p_group) const;
 	void wait_for_group_task_completion(GroupID p_group);
 
+	// Splits p_count independent items into contiguous ranges processed as a group task, and waits for it.
+	// p_func(from, to) is called for each range and must only write to items in [from, to).
+	// Runs on the calling thread if there is nothing to gain, or if called from a pool thread:
+	// waiting on a group blocks the waiting thread, so nesting would starve the pool.
+	template <typename F>
+	static void process_ranges(uint32_t p_count, uint32_t p_ranges_per_thread, const F &p_func, const String &p_description = String()) {
+		uint32_t thread_count = singleton ? singleton->get_thread_count() : 0;
+		if (p_count < 2 || thread_count < 2 || get_thread_index() != -1) {
+			p_func(0, p_count);
+			return;
+		}
+
+		struct Ranges {
+			const F *func = nullptr;
+			uint32_t count = 0;
+			uint32_t ranges = 0;
+
+			static void process(void *p_userdata, uint32_t p_index) {
+				const Ranges *r = (const Ranges *)p_userdata;
+				uint32_t from = uint64_t(r->count) * p_index / r->ranges;
+				uint32_t to = uint64_t(r->count) * (p_index + 1) / r->ranges;
+				(*r->func)(from, to);
+			}
+		};
+
+		Ranges r;
+		r.func = &p_func;
+		r.count = p_count;
+		r.ranges = MIN(p_count, thread_count * MAX(p_ranges_per_thread, 1u));
+
+		GroupID group_task = singleton->add_native_group_task(&Ranges::process, &r, r.ranges, -1, true, p_description);
+		singleton->wait_for_group_task_completion(group_task);
+	}
+
 	_FORCE_INLINE_ int get_thread_count() const { return threads.size(); }
 
 	static WorkerThreadPool *get_singleton() { return singleton; }
@@ -75,13 +75,16 @@ uint32_t VariantParser::StreamFile::_read_buffer(char32_t *p_buffer, uint32_t p_
 	// The buffer is assumed to include at least one character (for null terminator)
 	ERR_FAIL_COND_V(!p_num_chars, 0);
 
-	uint8_t *temp = (uint8_t *)alloca(p_num_chars);
+	// Read the raw bytes straight into the start of the output buffer, then widen
+	// them in place. Going backwards guarantees every byte is read before the
+	// wider character written over it, so no temporary buffer is needed.
+	uint8_t *temp = (uint8_t *)p_buffer;
 	uint64_t num_read = f->get_buffer(temp, p_num_chars);
 	ERR_FAIL_COND_V(num_read == UINT64_MAX, 0);
 
 	// translate to wchar
-	for (uint32_t n = 0; n < num_read; n++) {
-		p_buffer[n] = temp[n];
+	for (uint32_t n = num_read; n > 0; n--) {
+		p_buffer[n - 1] = temp[n - 1];
 	}
 
 	// could be less than p_num_chars, or zero
@@ -556,6 +559,12 @@ Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct,
 		return ERR_PARSE_ERROR;
 	}
 
+	// Large packed arrays can hold hundreds of thousands of elements, so write
+	// into a geometrically grown buffer instead of calling push_back() (and its
+	// copy-on-write check) per element. The final size is trimmed on exit.
+	int count = r_construct.size();
+	T *w = r_construct.ptrw();
+
 	bool first = true;
 	while (true) {
 		if (!first) {
@@ -565,6 +574,7 @@ Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct,
 			} else if (token.type == TK_PARENTHESIS_CLOSE) {
 				break;
 			} else {
+				r_construct.resize(count);
 				r_err_str = "Expected ',' or ')' in constructor";
 				return ERR_PARSE_ERROR;
 			}
@@ -584,15 +594,21 @@ Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct,
 				}
 			}
 			if (!valid) {
+				r_construct.resize(count);
 				r_err_str = "Expected float in constructor";
 				return ERR_PARSE_ERROR;
 			}
 		}
 
-		r_construct.push_back(token.value);
+		if (count == r_construct.size()) {
+			r_construct.resize(MAX(count * 2, 8));
+			w = r_construct.ptrw();
+		}
+		w[count++] = token.value;
 		first = false;
 	}
 
+	r_construct.resize(count);
 	return OK;
 }
 
@@ -1388,17 +1404,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				return err;
 			}
 
-			Vector<int32_t> arr;
-			{
-				int32_t len = args.size();
-				arr.resize(len);
-				int32_t *w = arr.ptrw();
-				for (int32_t i = 0; i < len; i++) {
-					w[i] = int32_t(args[i]);
-				}
-			}
-
-			value = arr;
+			value = args;
 		} else if (id == "PackedInt64Array") {
 			Vector<int64_t> args;
 			Error err = _parse_construct<int64_t>(p_stream, args, line, r_err_str);
@@ -1406,17 +1412,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				return err;
 			}
 
-			Vector<int64_t> arr;
-			{
-				int64_t len = args.size();
-				arr.resize(len);
-				int64_t *w = arr.ptrw();
-				for (int64_t i = 0; i < len; i++) {
-					w[i] = int64_t(args[i]);
-				}
-			}
-
-			value = arr;
+			value = args;
 		} else if (id == "PackedFloat32Array" || id == "PackedRealArray" || id == "PoolRealArray" || id == "FloatArray") {
 			Vector<float> args;
 			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
@@ -1424,17 +1420,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				return err;
 			}
 
-			Vector<float> arr;
-			{
-				int len = args.size();
-				arr.resize(len);
-				float *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = args[i];
-				}
-			}
-
-			value = arr;
+			value = args;
 		} else if (id == "PackedFloat64Array") {
 			Vector<double> args;
 			Error err = _parse_construct<double>(p_stream, args, line, r_err_str);
@@ -1442,17 +1428,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				return err;
 			}
 
-			Vector<double> arr;
-			{
-				int len = args.size();
-				arr.resize(len);
-				double *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = args[i];
-				}
-			}
-
-			value = arr;
+			value = args;
 		} else if (id == "PackedStringArray" || id == "PoolStringArray" || id == "StringArray") {
 			get_token(p_stream, token, line, r_err_str);
 			if (token.type != TK_PARENTHESIS_OPEN) {
@@ -1488,17 +1464,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				cs.push_back(token.value);
 			}
 
-			Vector<String> arr;
-			{
-				int len = cs.size();
-				arr.resize(len);
-				String *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = cs[i];
-				}
-			}
-
-			value = arr;
+			value = cs;
 		} else if (id == "PackedVector2Array" || id == "PoolVector2Array" || id == "Vector2Array") {
 			Vector<real_t> args;
 			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
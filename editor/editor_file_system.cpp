@@ -38,6 +38,7 @@
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/variant/variant_parser.h"
+#include "core/version.h"
 #include "editor/editor_help.h"
 #include "editor/editor_node.h"
 #include "editor/editor_paths.h"
@@ -246,7 +247,7 @@ void EditorFileSystem::_first_scan_filesystem() {
 	HashSet<String> extensions;
 
 	ep.step(TTR("Scanning file structure..."), 0, true);
-	nb_files_total = _scan_new_dir(first_scan_root_dir, d);
+	nb_files_total = _scan_new_dir_threaded(first_scan_root_dir, d);
 
 	// Preloading GDExtensions file extensions to prevent looping on all the resource loaders
 	// for each files in _first_scan_process_scripts.
@@ -453,7 +454,7 @@ void EditorFileSystem::_scan_filesystem() {
 		Ref<DirAccess> d = DirAccess::create(DirAccess::ACCESS_RESOURCES);
 		sd = memnew(ScannedDirectory);
 		sd->full_path = "res://";
-		nb_files_total = _scan_new_dir(sd, d);
+		nb_files_total = _scan_new_dir_threaded(sd, d);
 	}
 
 	_process_file_system(sd, new_filesystem, sp, processed_files);
@@ -513,12 +514,12 @@ bool EditorFileSystem::_is_test_for_reimport_needed(const String &p_path, uint64
 	return false;
 }
 
-bool EditorFileSystem::_test_for_reimport(const String &p_path, const String &p_expected_import_md5) {
+bool EditorFileSystem::_test_for_reimport(const String &p_path, const String &p_expected_import_md5, const String &p_import_md5, const String &p_source_md5) {
 	if (p_expected_import_md5.is_empty()) {
 		// Marked as reimportation needed.
 		return true;
 	}
-	String new_md5 = FileAccess::get_md5(p_path + ".import");
+	String new_md5 = p_import_md5.is_empty() ? FileAccess::get_md5(p_path + ".import") : p_import_md5;
 	if (p_expected_import_md5 != new_md5) {
 		return true;
 	}
@@ -667,7 +668,7 @@ bool EditorFileSystem::_test_for_reimport(const String &p_path, const String &p_
 		return true; // Lacks md5, so just reimport.
 	}
 
-	String md5 = FileAccess::get_md5(p_path);
+	String md5 = p_source_md5.is_empty() ? FileAccess::get_md5(p_path) : p_source_md5;
 	if (md5 != source_md5) {
 		return true;
 	}
@@ -783,6 +784,13 @@ bool EditorFileSystem::_scan_import_support(const Vector<String> &reimports) {
 	return false;
 }
 
+void EditorFileSystem::_compute_reimport_test_hashes(void *p_userdata, uint32_t p_index) {
+	ReimportTestHashes *hashes = static_cast<ReimportTestHashes *>(p_userdata);
+	const String &path = hashes->paths[p_index];
+	hashes->import_md5s[p_index] = FileAccess::get_md5(path + ".import");
+	hashes->source_md5s[p_index] = FileAccess::get_md5(path);
+}
+
 bool EditorFileSystem::_update_scan_actions() {
 	sources_changed.clear();
 
@@ -800,6 +808,28 @@ bool EditorFileSystem::_update_scan_actions() {
 		ep = memnew(EditorProgress("_update_scan_actions", TTR("Scanning actions..."), scan_actions.size()));
 	}
 
+	// Hashing the sources and their .import files dominates the reimport tests,
+	// so compute the hashes for all the tested files on the worker threads first.
+	ReimportTestHashes hashes;
+	for (const ItemAction &ia : scan_actions) {
+		if (ia.action == ItemAction::ACTION_FILE_TEST_REIMPORT) {
+			int idx = ia.dir->find_file_index(ia.file);
+			if (idx != -1 && !ia.dir->files[idx]->import_md5.is_empty()) {
+				hashes.paths.push_back(ia.dir->get_file_path(idx));
+			}
+		}
+	}
+	if (hashes.paths.size() > 1) {
+		hashes.import_md5s.resize(hashes.paths.size());
+		hashes.source_md5s.resize(hashes.paths.size());
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_compute_reimport_test_hashes, &hashes, hashes.paths.size(), -1, false, SNAME("ReimportTestHashes"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+	HashMap<String, uint32_t> hash_indices;
+	for (uint32_t i = 0; i < hashes.import_md5s.size(); i++) {
+		hash_indices[hashes.paths[i]] = i;
+	}
+
 	int step_count = 0;
 	for (const ItemAction &ia : scan_actions) {
 		switch (ia.action) {
@@ -884,7 +914,15 @@ bool EditorFileSystem::_update_scan_actions() {
 				ERR_CONTINUE(idx == -1);
 				String full_path = ia.dir->get_file_path(idx);
 
-				bool need_reimport = _test_for_reimport(full_path, ia.dir->files[idx]->import_md5);
+				String import_md5;
+				String source_md5;
+				HashMap<String, uint32_t>::ConstIterator H = hash_indices.find(full_path);
+				if (H) {
+					import_md5 = hashes.import_md5s[H->value];
+					source_md5 = hashes.source_md5s[H->value];
+				}
+
+				bool need_reimport = _test_for_reimport(full_path, ia.dir->files[idx]->import_md5, import_md5, source_md5);
 				if (need_reimport) {
 					// Must reimport.
 					reimports.push_back(full_path);
@@ -1031,7 +1069,7 @@ void EditorFileSystem::ScanProgress::increment() {
 	EditorFileSystem::singleton->scan_total = ratio;
 }
 
-int EditorFileSystem::_scan_new_dir(ScannedDirectory *p_dir, Ref<DirAccess> &da) {
+int EditorFileSystem::_scan_new_dir(ScannedDirectory *p_dir, Ref<DirAccess> &da, LocalVector<ScannedDirectory *> *r_deferred) {
 	List<String> dirs;
 	List<String> files;
 
@@ -1082,7 +1120,12 @@ int EditorFileSystem::_scan_new_dir(ScannedDirectory *p_dir, Ref<DirAccess> &da)
 				sd->name = E->get();
 				sd->full_path = p_dir->full_path.path_join(sd->name);
 
-				nb_files_total_scan += _scan_new_dir(sd, da);
+				if (r_deferred) {
+					// Leave the contents to be scanned later, possibly on another thread.
+					r_deferred->push_back(sd);
+				} else {
+					nb_files_total_scan += _scan_new_dir(sd, da);
+				}
 
 				p_dir->subdirs.push_back(sd);
 
@@ -1099,6 +1142,54 @@ int EditorFileSystem::_scan_new_dir(ScannedDirectory *p_dir, Ref<DirAccess> &da)
 	return nb_files_total_scan;
 }
 
+void EditorFileSystem::_scan_new_dir_task(uint32_t p_index, ScannedDirectoryTaskData *p_data) {
+	ScannedDirectory *sd = p_data->dirs[p_index];
+	Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_RESOURCES);
+	if (da->change_dir(sd->full_path) != OK) {
+		ERR_PRINT("Cannot go into subdir '" + sd->full_path + "'.");
+		return;
+	}
+	p_data->nb_files.add(_scan_new_dir(sd, da));
+}
+
+int EditorFileSystem::_scan_new_dir_threaded(ScannedDirectory *p_dir, Ref<DirAccess> &da) {
+	// Walking the tree is dominated by filesystem latency, so split it in independent subtrees
+	// scanned from the worker threads. Nested waits are avoided when already on a worker.
+	const int thread_count = WorkerThreadPool::get_singleton()->get_thread_count();
+	if (thread_count < 2 || WorkerThreadPool::get_thread_index() != -1) {
+		return _scan_new_dir(p_dir, da);
+	}
+
+	// Expand the top levels breadth-first until there are enough subtrees to keep all threads busy.
+	// Directory order is preserved, since subdirectories are added to their parent while listing it.
+	const uint32_t min_subtrees = thread_count * 4;
+	const int max_depth = 4;
+
+	ScannedDirectoryTaskData data;
+	int nb_files_total_scan = _scan_new_dir(p_dir, da, &data.dirs);
+
+	for (int depth = 0; depth < max_depth && !data.dirs.is_empty() && data.dirs.size() < min_subtrees; depth++) {
+		LocalVector<ScannedDirectory *> next;
+		for (ScannedDirectory *sd : data.dirs) {
+			if (da->change_dir(sd->full_path) != OK) {
+				ERR_PRINT("Cannot go into subdir '" + sd->full_path + "'.");
+				continue;
+			}
+			nb_files_total_scan += _scan_new_dir(sd, da, &next);
+		}
+		data.dirs = next;
+	}
+
+	if (data.dirs.size() == 1) {
+		_scan_new_dir_task(0, &data);
+	} else if (!data.dirs.is_empty()) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &EditorFileSystem::_scan_new_dir_task, &data, data.dirs.size(), -1, false, SNAME("ScanNewDir"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	return nb_files_total_scan + data.nb_files.get();
+}
+
 void EditorFileSystem::_process_file_system(const ScannedDirectory *p_scan_dir, EditorFileSystemDirectory *p_dir, ScanProgress &p_progress, HashSet<String> *r_processed_files) {
 	p_dir->modified_time = FileAccess::get_modified_time(p_scan_dir->full_path);
 
@@ -1357,7 +1448,7 @@ void EditorFileSystem::_scan_fs_changes(EditorFileSystemDirectory *p_dir, ScanPr
 
 					Ref<DirAccess> d = DirAccess::create(DirAccess::ACCESS_RESOURCES);
 					d->change_dir(dir_path);
-					int nb_files_dir = _scan_new_dir(&sd, d);
+					int nb_files_dir = _scan_new_dir_threaded(&sd, d);
 					p_progress.hi += nb_files_dir;
 					diff_nb_files += nb_files_dir;
 					_process_file_system(&sd, efd, p_progress, nullptr);
@@ -1693,6 +1784,12 @@ void EditorFileSystem::_notification(int p_what) {
 				prevent_recursive_process_hack = false;
 			}
 		} break;
+
+		case EditorSettings::NOTIFICATION_EDITOR_SETTINGS_CHANGED: {
+			if (EditorSettings::get_singleton()->check_changed_settings_in_group("filesystem/import/shared_cache")) {
+				import_cache_dir = _get_import_cache_dir_setting();
+			}
+		} break;
 	}
 }
 
@@ -2611,6 +2708,113 @@ Error EditorFileSystem::_reimport_group(const String &p_group_file, const Vector
 	return err;
 }
 
+String EditorFileSystem::_get_import_cache_key(const String &p_file, const Ref<ResourceImporter> &p_importer, const List<ResourceImporter::ImportOption> &p_options, const HashMap<StringName, Variant> &p_params) const {
+	String source_md5 = FileAccess::get_md5(p_file);
+	if (source_md5.is_empty()) {
+		return String();
+	}
+
+	// Everything the import result depends on: engine build, importer and its
+	// global settings, source contents and the import options.
+	String key = String(VERSION_FULL_BUILD) + ":" + VERSION_HASH;
+	key += ":" + p_importer->get_importer_name() + ":" + itos(p_importer->get_format_version()) + ":" + p_importer->get_import_settings_string();
+	key += ":" + source_md5 + ":" + p_file.get_extension().to_lower();
+
+	for (const ResourceImporter::ImportOption &E : p_options) {
+		String value;
+		VariantWriter::write_to_string(p_params[E.option.name], value);
+		key += ":" + String(E.option.name) + "=" + value;
+	}
+
+	return key.sha256_text();
+}
+
+Vector<String> EditorFileSystem::_get_import_cache_suffixes(const Ref<ResourceImporter> &p_importer, const List<String> &p_variants) const {
+	// Mirrors the destination paths written to the .import file, relative to the import base path.
+	Vector<String> suffixes;
+	if (p_variants.size()) {
+		for (const String &E : p_variants) {
+			suffixes.push_back(E + "." + p_importer->get_save_extension());
+		}
+	} else {
+		suffixes.push_back(p_importer->get_save_extension());
+	}
+	return suffixes;
+}
+
+bool EditorFileSystem::_load_from_import_cache(const String &p_key, const String &p_base_path, const Ref<ResourceImporter> &p_importer, List<String> &r_variants, Variant &r_metadata) const {
+	String entry_dir = import_cache_dir.path_join(p_key.substr(0, 2)).path_join(p_key);
+
+	Ref<ConfigFile> cf;
+	cf.instantiate();
+	if (cf->load(entry_dir.path_join("entry.cfg")) != OK) {
+		return false;
+	}
+
+	List<String> variants;
+	Vector<String> cached_variants = cf->get_value("entry", "variants", Vector<String>());
+	for (const String &E : cached_variants) {
+		variants.push_back(E);
+	}
+
+	for (const String &E : _get_import_cache_suffixes(p_importer, variants)) {
+		Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+		if (!FileAccess::exists(entry_dir.path_join(E)) || da->copy(entry_dir.path_join(E), p_base_path + "." + E) != OK) {
+			return false;
+		}
+	}
+
+	r_variants = variants;
+	r_metadata = cf->get_value("entry", "metadata", Variant());
+	return true;
+}
+
+void EditorFileSystem::_save_to_import_cache(const String &p_key, const String &p_base_path, const Ref<ResourceImporter> &p_importer, const List<String> &p_variants, const Variant &p_metadata) const {
+	String entry_dir = import_cache_dir.path_join(p_key.substr(0, 2)).path_join(p_key);
+	if (DirAccess::dir_exists_absolute(entry_dir)) {
+		return; // Already stored, e.g. by another project.
+	}
+
+	// Write to a temporary directory and rename it when complete, so other
+	// editors sharing the cache never see a partially written entry.
+	String temp_dir = entry_dir + ".tmp-" + itos(OS::get_singleton()->get_process_id()) + "-" + itos(Thread::get_caller_id());
+	Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	if (da->make_dir_recursive(temp_dir) != OK) {
+		return;
+	}
+
+	bool ok = true;
+	for (const String &E : _get_import_cache_suffixes(p_importer, p_variants)) {
+		if (!FileAccess::exists(p_base_path + "." + E) || da->copy(p_base_path + "." + E, temp_dir.path_join(E)) != OK) {
+			ok = false;
+			break;
+		}
+	}
+
+	if (ok) {
+		Ref<ConfigFile> cf;
+		cf.instantiate();
+		Vector<String> variants;
+		for (const String &E : p_variants) {
+			variants.push_back(E);
+		}
+		cf->set_value("entry", "variants", variants);
+		if (p_metadata != Variant()) {
+			cf->set_value("entry", "metadata", p_metadata);
+		}
+		ok = cf->save(temp_dir.path_join("entry.cfg")) == OK;
+	}
+
+	if (!ok || da->rename(temp_dir, entry_dir) != OK) {
+		// Failed, or another editor stored the same entry first.
+		Ref<DirAccess> temp_da = DirAccess::open(temp_dir);
+		if (temp_da.is_valid()) {
+			temp_da->erase_contents_recursive();
+		}
+		da->remove(temp_dir);
+	}
+}
+
 Error EditorFileSystem::_reimport_file(const String &p_file, const HashMap<StringName, Variant> &p_custom_options, const String &p_custom_importer, Variant *p_generator_parameters, bool p_update_file_system) {
 	print_verbose(vformat("EditorFileSystem: Importing file: %s", p_file));
 	uint64_t start_time = OS::get_singleton()->get_ticks_msec();
@@ -2734,7 +2938,24 @@ Error EditorFileSystem::_reimport_file(const String &p_file, const HashMap<Strin
 	List<String> import_variants;
 	List<String> gen_files;
 	Variant meta;
-	Error err = importer->import(p_file, base_path, params, &import_variants, &gen_files, &meta);
+	Error err = OK;
+
+	String cache_key;
+	if (!import_cache_dir.is_empty() && !importer->get_save_extension().is_empty() && importer->can_use_import_cache(params)) {
+		cache_key = _get_import_cache_key(p_file, importer, opts, params);
+	}
+
+	if (!cache_key.is_empty() && _load_from_import_cache(cache_key, base_path, importer, import_variants, meta)) {
+		print_verbose(vformat("EditorFileSystem: \"%s\" restored from the import cache.", p_file));
+	} else {
+		import_variants.clear();
+		err = importer->import(p_file, base_path, params, &import_variants, &gen_files, &meta);
+
+		// Files generated outside of the import base path can't be restored, so don't cache those imports.
+		if (err == OK && !cache_key.is_empty() && gen_files.is_empty()) {
+			_save_to_import_cache(cache_key, base_path, importer, import_variants, meta);
+		}
+	}
 
 	// As import is complete, save the .import file.
 
@@ -3332,6 +3553,17 @@ void EditorFileSystem::_bind_methods() {
 	ADD_SIGNAL(MethodInfo("resources_reload", PropertyInfo(Variant::PACKED_STRING_ARRAY, "resources")));
 }
 
+String EditorFileSystem::_get_import_cache_dir_setting() {
+	if (!EDITOR_GET("filesystem/import/shared_cache/enabled")) {
+		return String();
+	}
+	String path = EDITOR_GET("filesystem/import/shared_cache/path");
+	if (path.is_empty()) {
+		path = EditorPaths::get_singleton()->get_cache_dir().path_join("import_cache");
+	}
+	return path;
+}
+
 void EditorFileSystem::_update_extensions() {
 	valid_extensions.clear();
 	import_extensions.clear();
@@ -3383,6 +3615,7 @@ EditorFileSystem::EditorFileSystem() {
 
 	ResourceLoader::import = _resource_import;
 	reimport_on_missing_imported_files = GLOBAL_GET("editor/import/reimport_missing_imported_files");
+	import_cache_dir = _get_import_cache_dir_setting();
 	singleton = this;
 	filesystem = memnew(EditorFileSystemDirectory); //like, empty
 	filesystem->parent = nullptr;
@@ -37,6 +37,7 @@
 #include "core/os/thread.h"
 #include "core/os/thread_safe.h"
 #include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/safe_refcount.h"
 #include "scene/main/node.h"
 
@@ -143,6 +144,7 @@ public:
 
 class EditorFileSystem : public Node {
 	GDCLASS(EditorFileSystem, Node);
+	friend class TestEditorFileSystemInternalsAccessor;
 
 	_THREAD_SAFE_CLASS_
 
@@ -173,6 +175,11 @@ class EditorFileSystem : public Node {
 		~ScannedDirectory();
 	};
 
+	struct ScannedDirectoryTaskData {
+		LocalVector<ScannedDirectory *> dirs;
+		SafeNumeric<int> nb_files;
+	};
+
 	bool use_threads = false;
 	Thread thread;
 	static void _thread_func(void *_userdata);
@@ -249,7 +256,9 @@ class EditorFileSystem : public Node {
 	HashSet<String> valid_extensions;
 	HashSet<String> import_extensions;
 
-	int _scan_new_dir(ScannedDirectory *p_dir, Ref<DirAccess> &da);
+	int _scan_new_dir(ScannedDirectory *p_dir, Ref<DirAccess> &da, LocalVector<ScannedDirectory *> *r_deferred = nullptr);
+	int _scan_new_dir_threaded(ScannedDirectory *p_dir, Ref<DirAccess> &da);
+	void _scan_new_dir_task(uint32_t p_index, ScannedDirectoryTaskData *p_data);
 	void _process_file_system(const ScannedDirectory *p_scan_dir, EditorFileSystemDirectory *p_dir, ScanProgress &p_progress, HashSet<String> *p_processed_files);
 
 	Thread thread_sources;
@@ -261,14 +270,29 @@ class EditorFileSystem : public Node {
 	List<String> sources_changed;
 	List<ItemAction> scan_actions;
 
+	struct ReimportTestHashes {
+		LocalVector<String> paths;
+		LocalVector<String> import_md5s;
+		LocalVector<String> source_md5s;
+	};
+	static void _compute_reimport_test_hashes(void *p_userdata, uint32_t p_index);
+
 	bool _update_scan_actions();
 
 	void _update_extensions();
 
 	Error _reimport_file(const String &p_file, const HashMap<StringName, Variant> &p_custom_options = HashMap<StringName, Variant>(), const String &p_custom_importer = String(), Variant *generator_parameters = nullptr, bool p_update_file_system = true);
+
+	// Shared, content-addressed cache of import results (empty when disabled).
+	String import_cache_dir;
+	static String _get_import_cache_dir_setting();
+	String _get_import_cache_key(const String &p_file, const Ref<ResourceImporter> &p_importer, const List<ResourceImporter::ImportOption> &p_options, const HashMap<StringName, Variant> &p_params) const;
+	Vector<String> _get_import_cache_suffixes(const Ref<ResourceImporter> &p_importer, const List<String> &p_variants) const;
+	bool _load_from_import_cache(const String &p_key, const String &p_base_path, const Ref<ResourceImporter> &p_importer, List<String> &r_variants, Variant &r_metadata) const;
+	void _save_to_import_cache(const String &p_key, const String &p_base_path, const Ref<ResourceImporter> &p_importer, const List<String> &p_variants, const Variant &p_metadata) const;
 	Error _reimport_group(const String &p_group_file, const Vector<String> &p_files);
 
-	bool _test_for_reimport(const String &p_path, const String &p_expected_import_md5);
+	bool _test_for_reimport(const String &p_path, const String &p_expected_import_md5, const String &p_import_md5 = String(), const String &p_source_md5 = String());
 	bool _is_test_for_reimport_needed(const String &p_path, uint64_t p_last_modification_time, uint64_t p_modification_time, uint64_t p_last_import_modification_time, uint64_t p_import_modification_time, const Vector<String> &p_import_dest_paths);
 	Vector<String> _get_import_dest_paths(const String &p_path);
 
@@ -1739,6 +1739,9 @@ void EditorNode::_save_scene_with_preview(String p_file, int p_idx) {
 			// Does not have it, try to load a cached thumbnail.
 			post_process_preview(img);
 			img->save_png(cache_base + ".png");
+
+			// The preview cache would otherwise keep serving the old thumbnail for unchanged scene contents.
+			EditorResourcePreview::get_singleton()->invalidate_disk_cache(p_file);
 		}
 	}
 
@@ -31,10 +31,12 @@
 #include "editor_resource_preview.h"
 
 #include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
-#include "core/io/resource_saver.h"
+#include "core/io/resource_uid.h"
 #include "core/variant/variant_utility.h"
+#include "editor/editor_file_system.h"
 #include "editor/editor_node.h"
 #include "editor/editor_paths.h"
 #include "editor/editor_settings.h"
@@ -162,7 +164,7 @@ void EditorResourcePreview::_preview_ready(const String &p_path, int p_hash, con
 	Callable(id, p_func).call_deferred(p_path, p_texture, p_small_texture, p_ud);
 }
 
-void EditorResourcePreview::_generate_preview(Ref<ImageTexture> &r_texture, Ref<ImageTexture> &r_small_texture, const QueueItem &p_item, const String &cache_base, Dictionary &p_metadata) {
+void EditorResourcePreview::_generate_preview(Ref<ImageTexture> &r_texture, Ref<ImageTexture> &r_small_texture, const QueueItem &p_item, const String &p_cache_index, const String &p_hash, Dictionary &p_metadata) {
 	String type;
 
 	uint64_t started_at = OS::get_singleton()->get_ticks_usec();
@@ -194,6 +196,16 @@ void EditorResourcePreview::_generate_preview(Ref<ImageTexture> &r_texture, Ref<
 			continue;
 		}
 
+		// Generators rendering through a shared viewport can't run on several workers at once.
+		const bool serialize = !preview_generators[i]->is_thread_safe();
+		if (serialize) {
+			generator_mutex.lock();
+			if (exiting.is_set()) {
+				generator_mutex.unlock();
+				break;
+			}
+		}
+
 		Ref<Texture2D> generated;
 		if (p_item.resource.is_valid()) {
 			generated = preview_generators.write[i]->generate(p_item.resource, Vector2(thumbnail_size, thumbnail_size), p_metadata);
@@ -213,6 +225,10 @@ void EditorResourcePreview::_generate_preview(Ref<ImageTexture> &r_texture, Ref<
 			r_small_texture = generated_small;
 		}
 
+		if (serialize) {
+			generator_mutex.unlock();
+		}
+
 		if (!r_small_texture.is_valid() && r_texture.is_valid() && preview_generators[i]->generate_small_preview_automatically()) {
 			Ref<Image> small_image = r_texture->get_image();
 			small_image = small_image->duplicate();
@@ -226,18 +242,24 @@ void EditorResourcePreview::_generate_preview(Ref<ImageTexture> &r_texture, Ref<
 		}
 	}
 
-	if (!p_item.resource.is_valid()) {
+	if (!p_item.resource.is_valid() && !p_hash.is_empty()) {
 		// Cache the preview in case it's a resource on disk.
 		if (r_texture.is_valid()) {
 			// Wow it generated a preview... save cache.
 			bool has_small_texture = r_small_texture.is_valid();
-			ResourceSaver::save(r_texture, cache_base + ".png");
+			uint64_t modified_time = FileAccess::get_modified_time(p_item.path);
+			String cache_base = _get_disk_cache_base(p_hash);
+			// Another worker may be saving the same content from a different path, so every file
+			// is written under a temporary name first and then renamed, the entry's .txt last.
+			_save_disk_cache_file(cache_base + ".png", r_texture->get_image());
 			if (has_small_texture) {
-				ResourceSaver::save(r_small_texture, cache_base + "_small.png");
+				_save_disk_cache_file(cache_base + "_small.png", r_small_texture->get_image());
 			}
-			Ref<FileAccess> f = FileAccess::open(cache_base + ".txt", FileAccess::WRITE);
-			ERR_FAIL_COND_MSG(f.is_null(), "Cannot create file '" + cache_base + ".txt'. Check user write permissions.");
-			_write_preview_cache(f, thumbnail_size, has_small_texture, FileAccess::get_modified_time(p_item.path), FileAccess::get_md5(p_item.path), p_metadata);
+			// The content entry lets moved or duplicated files reuse the thumbnail,
+			// the path index avoids hashing files that didn't change.
+			_write_preview_cache_file(cache_base + ".txt", thumbnail_size, has_small_texture, modified_time, p_hash, p_metadata);
+			_write_preview_cache_file(p_cache_index, thumbnail_size, has_small_texture, modified_time, p_hash, p_metadata);
+			_touch_disk_cache(p_hash);
 		}
 	}
 
@@ -254,13 +276,23 @@ const Dictionary EditorResourcePreview::get_preview_metadata(const String &p_pat
 void EditorResourcePreview::_iterate() {
 	preview_mutex.lock();
 
-	if (queue.size() == 0) {
+	// Skip paths another worker is already generating, they will hit the memory cache once it's done.
+	List<QueueItem>::Element *E = queue.front();
+	while (E && queue_in_progress.has(E->get().path)) {
+		E = E->next();
+	}
+
+	if (!E) {
+		if (!queue.is_empty()) {
+			// Wake up again when the path in progress is done.
+			queue_wakeups_pending++;
+		}
 		preview_mutex.unlock();
 		return;
 	}
 
-	QueueItem item = queue.front()->get();
-	queue.pop_front();
+	QueueItem item = E->get();
+	queue.erase(E);
 
 	if (cache.has(item.path)) {
 		Item cached_item = cache[item.path];
@@ -269,101 +301,432 @@ void EditorResourcePreview::_iterate() {
 		preview_mutex.unlock();
 		return;
 	}
+
+	queue_in_progress.insert(item.path);
 	preview_mutex.unlock();
 
+	_process_item(item);
+
+	MutexLock lock(preview_mutex);
+	queue_in_progress.erase(item.path);
+	if (queue_wakeups_pending > 0) {
+		queue_wakeups_pending--;
+		preview_sem.post();
+	}
+}
+
+void EditorResourcePreview::_process_item(const QueueItem &p_item) {
 	Ref<ImageTexture> texture;
 	Ref<ImageTexture> small_texture;
 
 	int thumbnail_size = EDITOR_GET("filesystem/file_dialog/thumbnail_size");
 	thumbnail_size *= EDSCALE;
 
-	if (item.resource.is_valid()) {
+	if (p_item.resource.is_valid()) {
 		Dictionary preview_metadata;
-		_generate_preview(texture, small_texture, item, String(), preview_metadata);
-		_preview_ready(item.path, item.resource->hash_edited_version_for_preview(), texture, small_texture, item.id, item.function, item.userdata, preview_metadata);
+		_generate_preview(texture, small_texture, p_item, String(), String(), preview_metadata);
+		_preview_ready(p_item.path, p_item.resource->hash_edited_version_for_preview(), texture, small_texture, p_item.id, p_item.function, p_item.userdata, preview_metadata);
 		return;
 	}
 
 	Dictionary preview_metadata;
-	String temp_path = EditorPaths::get_singleton()->get_cache_dir();
-	String cache_base = ProjectSettings::get_singleton()->globalize_path(item.path).md5_text();
-	cache_base = temp_path.path_join("resthumb-" + cache_base);
+	String cache_index = _get_disk_cache_index(p_item.path);
+
+	uint64_t modtime = FileAccess::get_modified_time(p_item.path);
+	int tsize;
+	bool has_small_texture;
+	uint64_t last_modtime;
+	String hash;
+	String key;
+	bool key_computed = false;
+	bool outdated;
+	bool cache_valid = false;
 
 	// Does not have it, try to load a cached thumbnail.
+	Ref<FileAccess> f = FileAccess::open(cache_index, FileAccess::READ);
+	if (f.is_valid()) {
+		_read_preview_cache(f, &tsize, &has_small_texture, &last_modtime, &hash, &preview_metadata, &outdated);
+		f.unref();
+
+		cache_valid = tsize == thumbnail_size && !outdated;
+		if (cache_valid && last_modtime != modtime) {
+			key = _get_disk_cache_key(p_item.path);
+			key_computed = true;
+			if (key != hash) {
+				cache_valid = false;
+			} else {
+				// Update modified time.
+				_write_preview_cache_file(cache_index, thumbnail_size, has_small_texture, modtime, key, preview_metadata);
+			}
+		}
+
+		if (cache_valid) {
+			cache_valid = _load_disk_cache(hash, has_small_texture, texture, small_texture);
+		}
+	}
+
+	if (!cache_valid) {
+		// The file may be new to this path (moved or duplicated) while its content is already cached.
+		if (!key_computed) {
+			key = _get_disk_cache_key(p_item.path);
+		}
+		Ref<FileAccess> hf;
+		if (!key.is_empty()) {
+			hf = FileAccess::open(_get_disk_cache_base(key) + ".txt", FileAccess::READ);
+		}
+		if (hf.is_valid()) {
+			_read_preview_cache(hf, &tsize, &has_small_texture, &last_modtime, &hash, &preview_metadata, &outdated);
+			hf.unref();
+
+			if (tsize == thumbnail_size && !outdated && _load_disk_cache(key, has_small_texture, texture, small_texture)) {
+				cache_valid = true;
+				_write_preview_cache_file(cache_index, thumbnail_size, has_small_texture, modtime, key, preview_metadata);
+			}
+		}
+	}
+
+	if (!cache_valid) {
+		texture.unref();
+		small_texture.unref();
+		preview_metadata = Dictionary();
+		_generate_preview(texture, small_texture, p_item, cache_index, key, preview_metadata);
+	}
+
+	_preview_ready(p_item.path, 0, texture, small_texture, p_item.id, p_item.function, p_item.userdata, preview_metadata);
+}
+
+String EditorResourcePreview::_get_disk_cache_dir() const {
+	return disk_cache_dir.is_empty() ? EditorPaths::get_singleton()->get_cache_dir() : disk_cache_dir;
+}
 
-	String file = cache_base + ".txt";
-	Ref<FileAccess> f = FileAccess::open(file, FileAccess::READ);
+String EditorResourcePreview::_get_disk_cache_base(const String &p_key) const {
+	return _get_disk_cache_dir().path_join("resprev-" + p_key);
+}
+
+String EditorResourcePreview::_get_disk_cache_index(const String &p_path) const {
+	return _get_disk_cache_dir().path_join("resprev-path-" + ProjectSettings::get_singleton()->globalize_path(p_path).md5_text() + ".txt");
+}
+
+String EditorResourcePreview::_get_disk_cache_key(const String &p_path) const {
+	String md5 = FileAccess::get_md5(p_path);
+	if (md5.is_empty()) {
+		return String();
+	}
+
+	// The cache directory is shared by all projects, and a preview can depend on other resources
+	// (e.g. a material's textures), so the key also covers the project and the dependencies' contents.
+	String key = ProjectSettings::get_singleton()->get_resource_path() + "\n" + md5;
+	List<String> deps;
+	ResourceLoader::get_dependencies(p_path, &deps);
+	for (const String &dep : deps) {
+		String dep_path = dep.get_slice("::", 0);
+		ResourceUID::ID uid = ResourceUID::get_singleton()->text_to_id(dep_path);
+		if (uid != ResourceUID::INVALID_ID) {
+			if (ResourceUID::get_singleton()->has_id(uid)) {
+				dep_path = ResourceUID::get_singleton()->get_id_path(uid);
+			} else if (dep.get_slice_count("::") >= 3) {
+				dep_path = dep.get_slice("::", 2);
+			}
+		}
+		key += "\n" + dep_path + "\n" + FileAccess::get_md5(dep_path);
+	}
+	return key.md5_text();
+}
+
+void EditorResourcePreview::_save_disk_cache_file(const String &p_path, const Ref<Image> &p_image) {
+	ERR_FAIL_COND(p_image.is_null());
+	String temp_path = p_path + "." + itos(Thread::get_caller_id()) + ".tmp";
+	Error err = p_image->save_png(temp_path);
+	ERR_FAIL_COND_MSG(err != OK, "Cannot create file '" + temp_path + "'. Check user write permissions.");
+	err = DirAccess::rename_absolute(temp_path, p_path);
+	if (err != OK) {
+		DirAccess::remove_absolute(temp_path);
+		ERR_FAIL_MSG("Cannot create file '" + p_path + "'. Check user write permissions.");
+	}
+}
+
+void EditorResourcePreview::_write_preview_cache_file(const String &p_path, int p_thumbnail_size, bool p_has_small_texture, uint64_t p_modified_time, const String &p_hash, const Dictionary &p_metadata) {
+	String temp_path = p_path + "." + itos(Thread::get_caller_id()) + ".tmp";
+	{
+		Ref<FileAccess> f = FileAccess::open(temp_path, FileAccess::WRITE);
+		ERR_FAIL_COND_MSG(f.is_null(), "Cannot create file '" + temp_path + "'. Check user write permissions.");
+		_write_preview_cache(f, p_thumbnail_size, p_has_small_texture, p_modified_time, p_hash, p_metadata);
+	}
+	Error err = DirAccess::rename_absolute(temp_path, p_path);
+	if (err != OK) {
+		DirAccess::remove_absolute(temp_path);
+		ERR_FAIL_MSG("Cannot create file '" + p_path + "'. Check user write permissions.");
+	}
+}
+
+void EditorResourcePreview::invalidate_disk_cache(const String &p_path) {
+	String cache_index = _get_disk_cache_index(p_path);
+	Ref<FileAccess> f = FileAccess::open(cache_index, FileAccess::READ);
 	if (f.is_null()) {
-		// No cache found, generate.
-		_generate_preview(texture, small_texture, item, cache_base, preview_metadata);
-	} else {
-		uint64_t modtime = FileAccess::get_modified_time(item.path);
-		int tsize;
-		bool has_small_texture;
-		uint64_t last_modtime;
+		return;
+	}
+
+	int tsize;
+	bool has_small_texture;
+	uint64_t modified_time;
+	String key;
+	Dictionary metadata;
+	bool outdated;
+	_read_preview_cache(f, &tsize, &has_small_texture, &modified_time, &key, &metadata, &outdated);
+	f.unref();
+
+	DirAccess::remove_absolute(cache_index);
+	if (!key.is_empty()) {
+		// Removing the .txt first makes the entry invalid for readers before its images go.
+		String cache_base = _get_disk_cache_base(key);
+		DirAccess::remove_absolute(cache_base + ".txt");
+		DirAccess::remove_absolute(cache_base + ".png");
+		DirAccess::remove_absolute(cache_base + "_small.png");
+
+		MutexLock lock(disk_cache_mutex);
+		disk_cache_last_used.erase(key);
+		disk_cache_dirty = true;
+	}
+}
+
+bool EditorResourcePreview::_load_disk_cache(const String &p_hash, bool p_has_small_texture, Ref<ImageTexture> &r_texture, Ref<ImageTexture> &r_small_texture) {
+	String cache_base = _get_disk_cache_base(p_hash);
+
+	Ref<Image> img;
+	img.instantiate();
+	if (img->load(cache_base + ".png") != OK) {
+		return false;
+	}
+
+	Ref<Image> small_img;
+	if (p_has_small_texture) {
+		small_img.instantiate();
+		if (small_img->load(cache_base + "_small.png") != OK) {
+			return false;
+		}
+	}
+
+	r_texture.instantiate();
+	r_texture->set_image(img);
+	if (small_img.is_valid()) {
+		r_small_texture.instantiate();
+		r_small_texture->set_image(small_img);
+	}
+
+	_touch_disk_cache(p_hash);
+	return true;
+}
+
+void EditorResourcePreview::_touch_disk_cache(const String &p_hash) {
+	MutexLock lock(disk_cache_mutex);
+	disk_cache_last_used[p_hash] = OS::get_singleton()->get_unix_time();
+	disk_cache_dirty = true;
+}
+
+void EditorResourcePreview::_load_disk_cache_index() {
+	Ref<FileAccess> f = FileAccess::open(_get_disk_cache_dir().path_join("resource_previews_lru.txt"), FileAccess::READ);
+	if (f.is_null()) {
+		return;
+	}
+
+	MutexLock lock(disk_cache_mutex);
+	while (!f->eof_reached()) {
+		Vector<String> parts = f->get_line().split(" ", false);
+		if (parts.size() == 2) {
+			disk_cache_last_used[parts[0]] = parts[1].to_int();
+		}
+	}
+}
+
+void EditorResourcePreview::_save_disk_cache_index() {
+	MutexLock lock(disk_cache_mutex);
+	if (!disk_cache_dirty) {
+		return;
+	}
+
+	String path = _get_disk_cache_dir().path_join("resource_previews_lru.txt");
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(f.is_null(), "Cannot create file '" + path + "'. Check user write permissions.");
+	for (const KeyValue<String, uint64_t> &E : disk_cache_last_used) {
+		f->store_line(E.key + " " + itos(E.value));
+	}
+	disk_cache_dirty = false;
+}
+
+void EditorResourcePreview::_collect_project_thumbnails(EditorFileSystemDirectory *p_dir, HashMap<String, bool> &r_is_scene) {
+	for (int i = 0; i < p_dir->get_file_count(); i++) {
+		String md5 = ProjectSettings::get_singleton()->globalize_path(p_dir->get_file_path(i)).md5_text();
+		r_is_scene[md5] = ClassDB::is_parent_class(p_dir->get_file_type(i), "PackedScene");
+	}
+	for (int i = 0; i < p_dir->get_subdir_count(); i++) {
+		_collect_project_thumbnails(p_dir->get_subdir(i), r_is_scene);
+	}
+}
+
+void EditorResourcePreview::_enforce_disk_cache_budget() {
+	String cache_dir = _get_disk_cache_dir();
+	Ref<DirAccess> da = DirAccess::open(cache_dir);
+	ERR_FAIL_COND(da.is_null());
+
+	struct DiskEntry {
 		String hash;
-		bool outdated;
-		_read_preview_cache(f, &tsize, &has_small_texture, &last_modtime, &hash, &preview_metadata, &outdated);
+		LocalVector<String> files;
+		uint64_t size = 0;
+		uint64_t last_used = 0;
+		bool has_image = false;
+		bool keep = false;
+	};
+
+	struct DiskEntryComparator {
+		bool operator()(const DiskEntry *p_a, const DiskEntry *p_b) const {
+			return p_a->last_used < p_b->last_used;
+		}
+	};
+
+	// Path-keyed "resthumb-" thumbnails are saved by EditorNode for scenes, but were also used for every
+	// resource by the previous cache layout. Files of the open project tell those apart, thumbnails of
+	// other projects are evicted by age like the content entries.
+	HashMap<String, bool> project_is_scene;
+	if (EditorFileSystem::get_singleton() && EditorFileSystem::get_singleton()->get_filesystem()) {
+		_collect_project_thumbnails(EditorFileSystem::get_singleton()->get_filesystem(), project_is_scene);
+	}
 
-		bool cache_valid = true;
+	MutexLock lock(disk_cache_mutex);
 
-		if (tsize != thumbnail_size) {
-			cache_valid = false;
-			f.unref();
-		} else if (outdated) {
-			cache_valid = false;
-			f.unref();
-		} else if (last_modtime != modtime) {
-			String last_md5 = f->get_line();
-			String md5 = FileAccess::get_md5(item.path);
-			f.unref();
+	HashMap<String, DiskEntry> entries;
+	LocalVector<String> index_files;
+	LocalVector<String> stale_files;
+	da->list_dir_begin();
+	for (String file = da->get_next(); !file.is_empty(); file = da->get_next()) {
+		if (da->current_is_dir()) {
+			continue;
+		}
 
-			if (last_md5 != md5) {
-				cache_valid = false;
-			} else {
-				// Update modified time.
+		String extension = file.get_extension();
+		String file_path = cache_dir.path_join(file);
+		if (file.begins_with("resprev-path-")) {
+			if (extension == "txt") {
+				index_files.push_back(file_path);
+			}
+			continue;
+		}
 
-				Ref<FileAccess> f2 = FileAccess::open(file, FileAccess::WRITE);
-				if (f2.is_null()) {
-					// Not returning as this would leave the thread hanging and would require
-					// some proper cleanup/disabling of resource preview generation.
-					ERR_PRINT("Cannot create file '" + file + "'. Check user write permissions.");
-				} else {
-					_write_preview_cache(f2, thumbnail_size, has_small_texture, modtime, md5, preview_metadata);
+		String hash;
+		bool is_image = extension == "png" && !file.get_basename().ends_with("_small");
+		if (file.begins_with("resprev-")) {
+			if (extension != "png" && extension != "txt") {
+				continue; // Temporary files of writes in progress.
+			}
+			hash = file.get_basename().trim_prefix("resprev-").trim_suffix("_small");
+		} else if (file.begins_with("resthumb-")) {
+			if (!is_image) {
+				// Only written by the previous cache layout, nothing reads them anymore.
+				if (extension == "png" || extension == "txt") {
+					stale_files.push_back(file_path);
 				}
+				continue;
 			}
+			HashMap<String, bool>::ConstIterator I = project_is_scene.find(file.get_basename().trim_prefix("resthumb-"));
+			if (I && !I->value) {
+				stale_files.push_back(file_path);
+				continue;
+			}
+			// Never collides with content hashes, which have no prefix.
+			hash = file.get_basename();
 		} else {
-			f.unref();
+			continue;
 		}
 
-		if (cache_valid) {
-			Ref<Image> img;
-			img.instantiate();
-			Ref<Image> small_img;
-			small_img.instantiate();
+		DiskEntry &entry = entries[hash];
+		entry.hash = hash;
+		entry.files.push_back(file_path);
+		entry.has_image = entry.has_image || is_image;
+		entry.keep = hash.begins_with("resthumb-") && project_is_scene.has(hash.trim_prefix("resthumb-"));
 
-			if (img->load(cache_base + ".png") != OK) {
-				cache_valid = false;
-			} else {
-				texture.instantiate();
-				texture->set_image(img);
-
-				if (has_small_texture) {
-					if (small_img->load(cache_base + "_small.png") != OK) {
-						cache_valid = false;
-					} else {
-						small_texture.instantiate();
-						small_texture->set_image(small_img);
-					}
-				}
+		Ref<FileAccess> f = FileAccess::open(file_path, FileAccess::READ);
+		if (f.is_valid()) {
+			entry.size += f->get_length();
+		}
+
+		HashMap<String, uint64_t>::ConstIterator I = disk_cache_last_used.find(hash);
+		entry.last_used = MAX(entry.last_used, I ? I->value : FileAccess::get_modified_time(file_path));
+	}
+	da->list_dir_end();
+
+	// Path indexes belong to the entry they point to. Those pointing to a missing entry are dropped.
+	for (const String &index_path : index_files) {
+		String hash;
+		uint64_t size = 0;
+		{
+			Ref<FileAccess> f = FileAccess::open(index_path, FileAccess::READ);
+			if (f.is_valid()) {
+				int tsize;
+				bool has_small_texture;
+				uint64_t modified_time;
+				Dictionary metadata;
+				bool outdated;
+				_read_preview_cache(f, &tsize, &has_small_texture, &modified_time, &hash, &metadata, &outdated);
+				size = f->get_length();
 			}
 		}
 
-		if (!cache_valid) {
-			_generate_preview(texture, small_texture, item, cache_base, preview_metadata);
+		HashMap<String, DiskEntry>::Iterator E = entries.find(hash);
+		if (!E || !E->value.has_image) {
+			stale_files.push_back(index_path);
+			continue;
 		}
+		E->value.files.push_back(index_path);
+		E->value.size += size;
+	}
+
+	Vector<DiskEntry *> sorted;
+	uint64_t total_size = 0;
+	for (KeyValue<String, DiskEntry> &E : entries) {
+		if (!E.value.has_image) {
+			// Leftovers of an entry whose image was removed.
+			for (const String &file_path : E.value.files) {
+				stale_files.push_back(file_path);
+			}
+			continue;
+		}
+		sorted.push_back(&E.value);
+		total_size += E.value.size;
+	}
+	sorted.sort_custom<DiskEntryComparator>();
+
+	for (const String &file_path : stale_files) {
+		da->remove(file_path);
+	}
+
+	disk_cache_dirty = disk_cache_dirty || !stale_files.is_empty();
+	disk_cache_last_used.clear();
+
+	const uint64_t budget = uint64_t(int(EDITOR_GET("filesystem/resource_preview/disk_cache_size_mb"))) * 1024 * 1024;
+	int evicted = 0;
+	for (const DiskEntry *entry : sorted) {
+		if (budget > 0 && total_size > budget && !entry->keep) {
+			// Removing the .txt files first makes the entry invalid for readers before its images go.
+			for (const String &file_path : entry->files) {
+				if (file_path.get_extension() == "txt") {
+					da->remove(file_path);
+				}
+			}
+			for (const String &file_path : entry->files) {
+				if (file_path.get_extension() != "txt") {
+					da->remove(file_path);
+				}
+			}
+			total_size -= entry->size;
+			evicted++;
+			disk_cache_dirty = true;
+		} else if (!entry->hash.begins_with("resthumb-")) {
+			disk_cache_last_used[entry->hash] = entry->last_used;
+		}
+	}
+
+	if ((evicted > 0 || !stale_files.is_empty()) && is_print_verbose_enabled()) {
+		print_line(vformat("Evicted %d resource previews and removed %d stale files from the disk cache.", evicted, stale_files.size()));
 	}
-	_preview_ready(item.path, 0, texture, small_texture, item.id, item.function, item.userdata, preview_metadata);
 }
 
 void EditorResourcePreview::_write_preview_cache(Ref<FileAccess> p_file, int p_thumbnail_size, bool p_has_small_texture, uint64_t p_modified_time, const String &p_hash, const Dictionary &p_metadata) {
@@ -385,12 +748,11 @@ void EditorResourcePreview::_read_preview_cache(Ref<FileAccess> p_file, int *r_t
 }
 
 void EditorResourcePreview::_thread() {
-	exited.clear();
 	while (!exiting.is_set()) {
 		preview_sem.wait();
 		_iterate();
 	}
-	exited.set();
+	running_threads.decrement();
 }
 
 void EditorResourcePreview::_idle_callback() {
@@ -484,6 +846,22 @@ void EditorResourcePreview::queue_resource_preview(const String &p_path, Object
 	preview_sem.post();
 }
 
+void EditorResourcePreview::prioritize_resource_previews(const Vector<String> &p_paths) {
+	MutexLock lock(preview_mutex);
+
+	// Move in reverse order, so the first path ends up at the front of the queue.
+	for (int i = p_paths.size() - 1; i >= 0; i--) {
+		List<QueueItem>::Element *E = queue.front();
+		while (E) {
+			List<QueueItem>::Element *N = E->next();
+			if (E->get().path == p_paths[i]) {
+				queue.move_to_front(E);
+			}
+			E = N;
+		}
+	}
+}
+
 void EditorResourcePreview::add_preview_generator(const Ref<EditorResourcePreviewGenerator> &p_generator) {
 	preview_generators.push_back(p_generator);
 }
@@ -530,9 +908,24 @@ void EditorResourcePreview::start() {
 		return;
 	}
 
+	_load_disk_cache_index();
+	disk_cache_loaded = true;
+
 	if (is_threaded()) {
-		ERR_FAIL_COND_MSG(thread.is_started(), "Thread already started.");
-		thread.start(_thread_func, this);
+		ERR_FAIL_COND_MSG(!threads.is_empty(), "Threads already started.");
+
+		int thread_count = EDITOR_GET("filesystem/resource_preview/worker_threads");
+		if (thread_count <= 0) {
+			thread_count = CLAMP(OS::get_singleton()->get_processor_count() / 2, 1, 4);
+		}
+
+		exiting.clear();
+		running_threads.set(thread_count);
+		for (int i = 0; i < thread_count; i++) {
+			Thread *thread = memnew(Thread);
+			thread->start(_thread_func, this);
+			threads.push_back(thread);
+		}
 	} else {
 		SceneTree *st = Object::cast_to<SceneTree>(OS::get_singleton()->get_main_loop());
 		ERR_FAIL_NULL_MSG(st, "Editor's MainLoop is not a SceneTree. This is a bug.");
@@ -542,24 +935,36 @@ void EditorResourcePreview::start() {
 
 void EditorResourcePreview::stop() {
 	if (is_threaded()) {
-		if (thread.is_started()) {
+		if (!threads.is_empty()) {
 			exiting.set();
-			preview_sem.post();
+			for (uint32_t i = 0; i < threads.size(); i++) {
+				preview_sem.post();
+			}
 
 			for (int i = 0; i < preview_generators.size(); i++) {
 				preview_generators.write[i]->abort();
 			}
 
-			while (!exited.is_set()) {
+			while (running_threads.get() > 0) {
 				// Sync pending work.
 				OS::get_singleton()->delay_usec(10000);
 				RenderingServer::get_singleton()->sync();
 				MessageQueue::get_singleton()->flush();
 			}
 
-			thread.wait_to_finish();
+			for (Thread *thread : threads) {
+				thread->wait_to_finish();
+				memdelete(thread);
+			}
+			threads.clear();
 		}
 	}
+
+	if (disk_cache_loaded) {
+		_enforce_disk_cache_budget();
+		_save_disk_cache_index();
+		disk_cache_loaded = false;
+	}
 }
 
 EditorResourcePreview::EditorResourcePreview() {
@@ -33,9 +33,12 @@
 
 #include "core/os/semaphore.h"
 #include "core/os/thread.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/safe_refcount.h"
 #include "scene/main/node.h"
 
+class EditorFileSystemDirectory;
 class ImageTexture;
 class Texture2D;
 
@@ -66,6 +69,8 @@ public:
 	virtual Ref<Texture2D> generate(const Ref<Resource> &p_from, const Size2 &p_size, Dictionary &p_metadata) const;
 	virtual Ref<Texture2D> generate_from_path(const String &p_path, const Size2 &p_size, Dictionary &p_metadata) const;
 	virtual void abort() {}
+	// Thread-safe generators may run on several preview workers at once, others are serialized.
+	virtual bool is_thread_safe() const { return false; }
 
 	virtual bool generate_small_preview_automatically() const;
 	virtual bool can_generate_small_preview() const;
@@ -75,8 +80,9 @@ public:
 
 class EditorResourcePreview : public Node {
 	GDCLASS(EditorResourcePreview, Node);
+	friend class TestEditorResourcePreviewInternalsAccessor;
 
-	inline static constexpr int CURRENT_METADATA_VERSION = 1; // Increment this number to invalidate all previews.
+	inline static constexpr int CURRENT_METADATA_VERSION = 2; // Increment this number to invalidate all previews.
 	inline static EditorResourcePreview *singleton = nullptr;
 
 	struct QueueItem {
@@ -88,12 +94,22 @@ class EditorResourcePreview : public Node {
 	};
 
 	List<QueueItem> queue;
+	HashSet<String> queue_in_progress; // Paths being generated by a worker, duplicates wait for the cached result.
+	int queue_wakeups_pending = 0;
 
 	Mutex preview_mutex;
+	Mutex generator_mutex; // Serializes generators that aren't thread-safe.
 	Semaphore preview_sem;
-	Thread thread;
+	LocalVector<Thread *> threads;
 	SafeFlag exiting;
-	SafeFlag exited;
+	SafeNumeric<uint32_t> running_threads;
+
+	// Thumbnails on disk are keyed by the file's content hash (see _get_disk_cache_key()), and evicted least recently used first.
+	String disk_cache_dir; // The editor cache folder when empty.
+	Mutex disk_cache_mutex;
+	HashMap<String, uint64_t> disk_cache_last_used;
+	bool disk_cache_loaded = false;
+	bool disk_cache_dirty = false;
 
 	struct Item {
 		Ref<Texture2D> preview;
@@ -106,7 +122,8 @@ class EditorResourcePreview : public Node {
 	HashMap<String, Item> cache;
 
 	void _preview_ready(const String &p_path, int p_hash, const Ref<Texture2D> &p_texture, const Ref<Texture2D> &p_small_texture, ObjectID id, const StringName &p_func, const Variant &p_ud, const Dictionary &p_metadata);
-	void _generate_preview(Ref<ImageTexture> &r_texture, Ref<ImageTexture> &r_small_texture, const QueueItem &p_item, const String &cache_base, Dictionary &p_metadata);
+	void _generate_preview(Ref<ImageTexture> &r_texture, Ref<ImageTexture> &r_small_texture, const QueueItem &p_item, const String &p_cache_index, const String &p_hash, Dictionary &p_metadata);
+	void _process_item(const QueueItem &p_item);
 
 	int small_thumbnail_size = -1;
 
@@ -115,6 +132,19 @@ class EditorResourcePreview : public Node {
 	static void _idle_callback(); // For other rendering drivers (i.e., OpenGL).
 	void _iterate();
 
+	String _get_disk_cache_dir() const;
+	String _get_disk_cache_base(const String &p_key) const;
+	String _get_disk_cache_index(const String &p_path) const;
+	String _get_disk_cache_key(const String &p_path) const;
+	void _save_disk_cache_file(const String &p_path, const Ref<Image> &p_image);
+	void _write_preview_cache_file(const String &p_path, int p_thumbnail_size, bool p_has_small_texture, uint64_t p_modified_time, const String &p_hash, const Dictionary &p_metadata);
+	bool _load_disk_cache(const String &p_hash, bool p_has_small_texture, Ref<ImageTexture> &r_texture, Ref<ImageTexture> &r_small_texture);
+	void _touch_disk_cache(const String &p_hash);
+	void _load_disk_cache_index();
+	void _save_disk_cache_index();
+	static void _collect_project_thumbnails(EditorFileSystemDirectory *p_dir, HashMap<String, bool> &r_is_scene);
+	void _enforce_disk_cache_budget();
+
 	void _write_preview_cache(Ref<FileAccess> p_file, int p_thumbnail_size, bool p_has_small_texture, uint64_t p_modified_time, const String &p_hash, const Dictionary &p_metadata);
 	void _read_preview_cache(Ref<FileAccess> p_file, int *r_thumbnail_size, bool *r_has_small_texture, uint64_t *r_modified_time, String *r_hash, Dictionary *r_metadata, bool *r_outdated);
 
@@ -144,6 +174,8 @@ public:
 	void add_preview_generator(const Ref<EditorResourcePreviewGenerator> &p_generator);
 	void remove_preview_generator(const Ref<EditorResourcePreviewGenerator> &p_generator);
 	void check_for_invalidation(const String &p_path);
+	void invalidate_disk_cache(const String &p_path);
+	void prioritize_resource_previews(const Vector<String> &p_paths);
 
 	void start();
 	void stop();
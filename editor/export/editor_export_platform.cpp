@@ -61,6 +61,8 @@ static int _get_pad(int p_alignment, int p_n) {
 
 #define PCK_PADDING 16
 
+bool EditorExportPlatform::print_pack_stats = false;
+
 bool EditorExportPlatform::fill_log_messages(RichTextLabel *p_log, Error p_err) {
 	bool has_messages = false;
 
@@ -230,29 +232,54 @@ Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_pa
 		}
 	}
 
-	Ref<FileAccessEncrypted> fae;
-	Ref<FileAccess> ftmp = pd->f;
+	pd->total_bytes += sd.size;
 
-	if (sd.encrypted) {
-		fae.instantiate();
-		ERR_FAIL_COND_V(fae.is_null(), ERR_SKIP);
+	bool is_duplicate = false;
+	if (pd->deduplicate) {
+		// Byte-identical files are stored once, later copies point to the same data range.
+		unsigned char hash[32];
+		CryptoCore::sha256(p_data.ptr(), p_data.size(), hash);
+		String content_key = String::hex_encode_buffer(hash, 32);
+		if (sd.encrypted) {
+			content_key += "_enc";
+		}
 
-		Error err = fae->open_and_parse(ftmp, p_key, FileAccessEncrypted::MODE_WRITE_AES256, false);
-		ERR_FAIL_COND_V(err != OK, ERR_SKIP);
-		ftmp = fae;
+		const uint64_t *existing_ofs = pd->content_ofs.getptr(content_key);
+		if (existing_ofs) {
+			sd.ofs = *existing_ofs;
+			pd->deduplicated_bytes += sd.size;
+			pd->deduplicated_files++;
+			is_duplicate = true;
+		} else {
+			pd->content_ofs.insert(content_key, sd.ofs);
+		}
 	}
 
-	// Store file content.
-	ftmp->store_buffer(p_data.ptr(), p_data.size());
+	if (!is_duplicate) {
+		Ref<FileAccessEncrypted> fae;
+		Ref<FileAccess> ftmp = pd->f;
 
-	if (fae.is_valid()) {
-		ftmp.unref();
-		fae.unref();
-	}
+		if (sd.encrypted) {
+			fae.instantiate();
+			ERR_FAIL_COND_V(fae.is_null(), ERR_SKIP);
+
+			Error err = fae->open_and_parse(ftmp, p_key, FileAccessEncrypted::MODE_WRITE_AES256, false);
+			ERR_FAIL_COND_V(err != OK, ERR_SKIP);
+			ftmp = fae;
+		}
+
+		// Store file content.
+		ftmp->store_buffer(p_data.ptr(), p_data.size());
 
-	int pad = _get_pad(PCK_PADDING, pd->f->get_position());
-	for (int i = 0; i < pad; i++) {
-		pd->f->store_8(0);
+		if (fae.is_valid()) {
+			ftmp.unref();
+			fae.unref();
+		}
+
+		int pad = _get_pad(PCK_PADDING, pd->f->get_position());
+		for (int i = 0; i < pad; i++) {
+			pd->f->store_8(0);
+		}
 	}
 
 	// Store MD5 of original file.
@@ -1721,6 +1748,7 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 	pd.ep = &ep;
 	pd.f = ftmp;
 	pd.so_files = p_so_files;
+	pd.deduplicate = GLOBAL_GET("editor/export/deduplicate_pck_files");
 
 	Error err = export_project_files(p_preset, p_debug, p_save_func, &pd, _pack_add_shared_object);
 
@@ -1740,6 +1768,15 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 		return FAILED;
 	}
 
+	if (print_pack_stats) {
+		print_line(vformat("PCK stats: %d files, %s of file data.", pd.file_ofs.size(), String::humanize_size(pd.total_bytes)));
+		if (pd.deduplicate) {
+			print_line(vformat("PCK stats: %d duplicated files deduplicated, %s saved (%.1f%%).", pd.deduplicated_files, String::humanize_size(pd.deduplicated_bytes), pd.total_bytes > 0 ? double(pd.deduplicated_bytes) / pd.total_bytes * 100.0 : 0.0));
+		} else {
+			print_line("PCK stats: Deduplication is disabled (see the \"editor/export/deduplicate_pck_files\" project setting).");
+		}
+	}
+
 	pd.file_ofs.sort(); //do sort, so we can do binary search later
 
 	Ref<FileAccess> f;
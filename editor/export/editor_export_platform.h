@@ -95,6 +95,12 @@ private:
 		Vector<SavedData> file_ofs;
 		EditorProgress *ep = nullptr;
 		Vector<SharedObject> *so_files = nullptr;
+
+		bool deduplicate = false;
+		HashMap<String, uint64_t> content_ofs; // Content hash -> offset of the stored data.
+		uint64_t total_bytes = 0;
+		uint64_t deduplicated_bytes = 0;
+		int deduplicated_files = 0;
 	};
 
 	struct ZipData {
@@ -106,6 +112,8 @@ private:
 
 	Vector<ExportMessage> messages;
 
+	static bool print_pack_stats;
+
 	void _export_find_resources(EditorFileSystemDirectory *p_dir, HashSet<String> &p_paths);
 	void _export_find_customized_resources(const Ref<EditorExportPreset> &p_preset, EditorFileSystemDirectory *p_dir, EditorExportPreset::FileExportMode p_mode, HashSet<String> &p_paths);
 	void _export_find_dependencies(const String &p_path, HashSet<String> &p_paths);
@@ -215,6 +223,8 @@ public:
 	};
 
 	virtual Ref<EditorExportPreset> create_preset();
+
+	static void set_print_pack_stats(bool p_enabled) { print_pack_stats = p_enabled; }
 	virtual bool is_executable(const String &p_path) const { return false; }
 
 	virtual void clear_messages() { messages.clear(); }
@@ -781,6 +781,23 @@ void FileSystemDock::navigate_to_path(const String &p_path) {
 	_update_import_dock();
 }
 
+void FileSystemDock::_file_list_prioritize_visible_previews() {
+	// Generate the thumbnails the user is looking at first when scrolling through large folders.
+	float top = files->get_v_scroll_bar()->get_value();
+	float bottom = top + files->get_size().height;
+	Vector<String> visible_paths;
+	for (int i = 0; i < files->get_item_count(); i++) {
+		Rect2 rect = files->get_item_rect(i, false);
+		if (rect.position.y > bottom) {
+			break;
+		}
+		if (rect.position.y + rect.size.height >= top) {
+			visible_paths.push_back(files->get_item_metadata(i));
+		}
+	}
+	EditorResourcePreview::get_singleton()->prioritize_resource_previews(visible_paths);
+}
+
 void FileSystemDock::_file_list_thumbnail_done(const String &p_path, const Ref<Texture2D> &p_preview, const Ref<Texture2D> &p_small_preview, const Variant &p_udata) {
 	if (p_preview.is_valid()) {
 		Array uarr = p_udata;
@@ -4218,6 +4235,7 @@ FileSystemDock::FileSystemDock() {
 	files->connect("item_edited", callable_mp(this, &FileSystemDock::_rename_operation_confirm));
 	files->set_custom_minimum_size(Size2(0, 15 * EDSCALE));
 	files->set_allow_rmb_select(true);
+	files->get_v_scroll_bar()->connect(SceneStringName(value_changed), callable_mp(this, &FileSystemDock::_file_list_prioritize_visible_previews).unbind(1));
 	file_list_vb->add_child(files);
 
 	scanning_vb = memnew(VBoxContainer);
@@ -289,6 +289,14 @@ void ResourceImporterLayeredTexture::_save_tex(Vector<Ref<Image>> p_images, cons
 	}
 }
 
+bool ResourceImporterLayeredTexture::can_use_import_cache(const HashMap<StringName, Variant> &p_options) const {
+	// The lossless container format depends on a project setting.
+	if (p_options.has("compress/mode") && int(p_options["compress/mode"]) == COMPRESS_LOSSLESS && bool(GLOBAL_GET("rendering/textures/lossless_compression/force_png"))) {
+		return false;
+	}
+	return true;
+}
+
 Error ResourceImporterLayeredTexture::import(const String &p_source_file, const String &p_save_path, const HashMap<StringName, Variant> &p_options, List<String> *r_platform_variants, List<String> *r_gen_files, Variant *r_metadata) {
 	int compress_mode = p_options["compress/mode"];
 	float lossy = p_options["compress/lossy_quality"];
@@ -428,6 +428,24 @@ Dictionary ResourceImporterTexture::_load_editor_meta(const String &p_path) cons
 	return f->get_var();
 }
 
+bool ResourceImporterTexture::can_use_import_cache(const HashMap<StringName, Variant> &p_options) const {
+	// These depend on another texture and on the editor scale and theme, which aren't part of the cache key.
+	if (p_options.has("roughness/src_normal") && !String(p_options["roughness/src_normal"]).is_empty()) {
+		return false;
+	}
+	if (p_options.has("editor/scale_with_editor_scale") && bool(p_options["editor/scale_with_editor_scale"])) {
+		return false;
+	}
+	if (p_options.has("editor/convert_colors_with_editor_theme") && bool(p_options["editor/convert_colors_with_editor_theme"])) {
+		return false;
+	}
+	// The lossless container format depends on a project setting.
+	if (p_options.has("compress/mode") && int(p_options["compress/mode"]) == COMPRESS_LOSSLESS && bool(GLOBAL_GET("rendering/textures/lossless_compression/force_png"))) {
+		return false;
+	}
+	return true;
+}
+
 Error ResourceImporterTexture::import(const String &p_source_file, const String &p_save_path, const HashMap<StringName, Variant> &p_options, List<String> *r_platform_variants, List<String> *r_gen_files, Variant *r_metadata) {
 	// Parse import options.
 	int32_t loader_flags = ImageFormatLoader::FLAG_NONE;
@@ -177,6 +177,10 @@ Ref<Texture2D> EditorTexturePreviewPlugin::generate(const Ref<Resource> &p_from,
 	return ImageTexture::create_from_image(img);
 }
 
+bool EditorTexturePreviewPlugin::is_thread_safe() const {
+	return true;
+}
+
 EditorTexturePreviewPlugin::EditorTexturePreviewPlugin() {
 }
 
@@ -217,6 +221,10 @@ Ref<Texture2D> EditorImagePreviewPlugin::generate(const Ref<Resource> &p_from, c
 	return ImageTexture::create_from_image(img);
 }
 
+bool EditorImagePreviewPlugin::is_thread_safe() const {
+	return true;
+}
+
 EditorImagePreviewPlugin::EditorImagePreviewPlugin() {
 }
 
@@ -282,6 +290,10 @@ bool EditorBitmapPreviewPlugin::generate_small_preview_automatically() const {
 	return true;
 }
 
+bool EditorBitmapPreviewPlugin::is_thread_safe() const {
+	return true;
+}
+
 EditorBitmapPreviewPlugin::EditorBitmapPreviewPlugin() {
 }
 
@@ -726,6 +738,10 @@ Ref<Texture2D> EditorAudioStreamPreviewPlugin::generate(const Ref<Resource> &p_f
 	return ImageTexture::create_from_image(image);
 }
 
+bool EditorAudioStreamPreviewPlugin::is_thread_safe() const {
+	return true;
+}
+
 EditorAudioStreamPreviewPlugin::EditorAudioStreamPreviewPlugin() {
 }
 
@@ -948,5 +964,9 @@ Ref<Texture2D> EditorGradientPreviewPlugin::generate(const Ref<Resource> &p_from
 	return Ref<Texture2D>();
 }
 
+bool EditorGradientPreviewPlugin::is_thread_safe() const {
+	return true;
+}
+
 EditorGradientPreviewPlugin::EditorGradientPreviewPlugin() {
 }
@@ -45,6 +45,7 @@ public:
 	virtual bool handles(const String &p_type) const override;
 	virtual bool generate_small_preview_automatically() const override;
 	virtual Ref<Texture2D> generate(const Ref<Resource> &p_from, const Size2 &p_size, Dictionary &p_metadata) const override;
+	virtual bool is_thread_safe() const override;
 
 	EditorTexturePreviewPlugin();
 };
@@ -56,6 +57,7 @@ public:
 	virtual bool handles(const String &p_type) const override;
 	virtual bool generate_small_preview_automatically() const override;
 	virtual Ref<Texture2D> generate(const Ref<Resource> &p_from, const Size2 &p_size, Dictionary &p_metadata) const override;
+	virtual bool is_thread_safe() const override;
 
 	EditorImagePreviewPlugin();
 };
@@ -67,6 +69,7 @@ public:
 	virtual bool handles(const String &p_type) const override;
 	virtual bool generate_small_preview_automatically() const override;
 	virtual Ref<Texture2D> generate(const Ref<Resource> &p_from, const Size2 &p_size, Dictionary &p_metadata) const override;
+	virtual bool is_thread_safe() const override;
 
 	EditorBitmapPreviewPlugin();
 };
@@ -127,6 +130,7 @@ class EditorAudioStreamPreviewPlugin : public EditorResourcePreviewGenerator {
 public:
 	virtual bool handles(const String &p_type) const override;
 	virtual Ref<Texture2D> generate(const Ref<Resource> &p_from, const Size2 &p_size, Dictionary &p_metadata) const override;
+	virtual bool is_thread_safe() const override;
 
 	EditorAudioStreamPreviewPlugin();
 };
@@ -181,6 +185,7 @@ public:
 	virtual bool handles(const String &p_type) const override;
 	virtual bool generate_small_preview_automatically() const override;
 	virtual Ref<Texture2D> generate(const Ref<Resource> &p_from, const Size2 &p_size, Dictionary &p_metadata) const override;
+	virtual bool is_thread_safe() const override;
 
 	EditorGradientPreviewPlugin();
 };
@@ -73,6 +73,7 @@
 #include "servers/navigation_server_3d.h"
 #include "servers/navigation_server_3d_dummy.h"
 #include "servers/register_server_types.h"
+#include "servers/rendering/rendering_server_benchmark.h"
 #include "servers/rendering/rendering_server_default.h"
 #include "servers/text/text_server_dummy.h"
 #include "servers/text_server.h"
@@ -104,6 +105,7 @@
 #include "editor/editor_paths.h"
 #include "editor/editor_settings.h"
 #include "editor/editor_translation.h"
+#include "editor/export/editor_export_platform.h"
 #include "editor/progress_dialog.h"
 #include "editor/project_manager.h"
 #include "editor/register_editor_types.h"
@@ -252,6 +254,7 @@ static bool dump_extension_api = false;
 static bool include_docs_in_extension_api_dump = false;
 static bool validate_extension_api = false;
 static String validate_extension_api_file;
+static String rendering_benchmark_file;
 #endif
 bool profile_gpu = false;
 
@@ -668,6 +671,7 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("--export-pack <preset> <path>", "Export the project data only using the given preset and output path. The <path> extension determines whether it will be in PCK or ZIP format.\n", CLI_OPTION_AVAILABILITY_EDITOR);
 	print_help_option("--export-patch <preset> <path>", "Export pack with changed files only. See --export-pack description for other considerations.\n", CLI_OPTION_AVAILABILITY_EDITOR);
 	print_help_option("--patches <paths>", "List of patches to use with --export-patch. The list is comma-separated.\n", CLI_OPTION_AVAILABILITY_EDITOR);
+	print_help_option("--pck-stats", "Print the number of files and bytes stored when exporting a PCK, including the bytes saved by deduplicating identical files.\n", CLI_OPTION_AVAILABILITY_EDITOR);
 	print_help_option("--install-android-build-template", "Install the Android build template. Used in conjunction with --export-release or --export-debug.\n", CLI_OPTION_AVAILABILITY_EDITOR);
 #ifndef DISABLE_DEPRECATED
 	// Commands are long; split the description to a second line.
@@ -690,6 +694,7 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("", "If incompatibilities or errors are detected, the exit code will be non-zero.\n");
 	print_help_option("--benchmark", "Benchmark the run time and print it to console.\n", CLI_OPTION_AVAILABILITY_EDITOR);
 	print_help_option("--benchmark-file <path>", "Benchmark the run time and save it to a given file in JSON format. The path should be absolute.\n", CLI_OPTION_AVAILABILITY_EDITOR);
+	print_help_option("--benchmark-rendering <path>", "Benchmark the CPU side of the rendering server on synthetic scenes and shaders, and save the timings of each frame phase to a given file in JSON format (implies --headless).\n", CLI_OPTION_AVAILABILITY_EDITOR);
 #ifdef TESTS_ENABLED
 	print_help_option("--test [--help]", "Run unit tests. Use --test --help for more information.\n", CLI_OPTION_AVAILABILITY_EDITOR);
 #endif
@@ -1763,6 +1768,23 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 				OS::get_singleton()->print("Missing <path> argument for --benchmark-file <path>.\n");
 				goto error;
 			}
+#ifdef TOOLS_ENABLED
+		} else if (arg == "--benchmark-rendering") {
+			if (N) {
+				// Actually handling is done in start().
+				cmdline_tool = true;
+				rendering_benchmark_file = N->get();
+
+				// The benchmark runs on the dummy rasterizer, so imply `--headless`.
+				audio_driver = NULL_AUDIO_DRIVER;
+				display_driver = NULL_DISPLAY_DRIVER;
+				main_args.push_back(arg);
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing <path> argument for --benchmark-rendering <path>.\n");
+				goto error;
+			}
+#endif // TOOLS_ENABLED
 #if defined(TOOLS_ENABLED) && defined(MODULE_GDSCRIPT_ENABLED) && !defined(GDSCRIPT_NO_LSP)
 		} else if (arg == "--lsp-port") {
 			if (N) {
@@ -3562,6 +3584,8 @@ int Main::start() {
 			project_manager = true;
 		} else if (E->get() == "--install-android-build-template") {
 			install_android_build_template = true;
+		} else if (E->get() == "--pck-stats") {
+			EditorExportPlatform::set_print_pack_stats(true);
 #endif // TOOLS_ENABLED
 		} else if (E->get().length() && E->get()[0] != '-' && positional_arg.is_empty()) {
 			positional_arg = E->get();
@@ -3770,6 +3794,11 @@ int Main::start() {
 		}
 	}
 
+	if (!rendering_benchmark_file.is_empty()) {
+		Error err = RenderingServerBenchmark::run_and_save(rendering_benchmark_file);
+		return err == OK ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
 #ifndef DISABLE_DEPRECATED
 	if (converting_project) {
 		int ret = ProjectConverter3To4(converter_max_kb_file, converter_max_line_length).convert();
@@ -132,11 +132,14 @@ static void _digest_row_task(const CVTTCompressionJobParams &p_job_params, const
 static void _digest_job_queue(void *p_job_queue, uint32_t p_index) {
 	CVTTCompressionJobQueue *job_queue = static_cast<CVTTCompressionJobQueue *>(p_job_queue);
 	uint32_t num_tasks = job_queue->num_tasks;
-	uint32_t total_threads = WorkerThreadPool::get_singleton()->get_thread_count();
-	uint32_t start = p_index * num_tasks / total_threads;
-	uint32_t end = (p_index + 1 == total_threads) ? num_tasks : ((p_index + 1) * num_tasks / total_threads);
 
-	for (uint32_t i = start; i < end; i++) {
+	// Rows are pulled one at a time rather than split into fixed ranges per thread,
+	// as rows of the top mipmap are far more expensive than those of the smaller ones.
+	while (true) {
+		uint32_t i = job_queue->current_task.increment() - 1;
+		if (i >= num_tasks) {
+			break;
+		}
 		_digest_row_task(job_queue->job_params, job_queue->job_tasks[i]);
 	}
 }
@@ -239,8 +242,13 @@ void image_compress_cvtt(Image *p_image, Image::UsedChannels p_channels) {
 
 	job_queue.job_tasks = &tasks_rb[0];
 	job_queue.num_tasks = static_cast<uint32_t>(tasks.size());
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_digest_job_queue, &job_queue, WorkerThreadPool::get_singleton()->get_thread_count(), -1, true, SNAME("CVTT Compress"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	uint32_t num_workers = MIN(job_queue.num_tasks, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count());
+	if (num_workers > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_digest_job_queue, &job_queue, num_workers, -1, true, SNAME("CVTT Compress"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		_digest_job_queue(&job_queue, 0);
+	}
 
 	p_image->set_data(p_image->get_width(), p_image->get_height(), p_image->has_mipmaps(), target_format, data);
 
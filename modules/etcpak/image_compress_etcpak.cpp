@@ -30,8 +30,10 @@
 
 #include "image_compress_etcpak.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/string/print_string.h"
+#include "core/templates/local_vector.h"
 
 #include <ProcessDxtc.hpp>
 #include <ProcessRGB.hpp>
@@ -88,6 +90,38 @@ void _compress_bc(Image *r_img, Image::UsedChannels p_channels) {
 	_compress_etcpak(_determine_dxt_type(p_channels), r_img);
 }
 
+typedef void (*EtcpakCompressFunc)(const uint32_t *p_src, uint64_t *p_dst, uint32_t p_blocks, size_t p_width);
+
+// Tiles are made of whole rows of 4x4 blocks, as etcpak walks blocks row by row.
+// Grouping small rows keeps the per-tile overhead low on the smaller mipmaps.
+static const uint32_t ETCPAK_MIN_BLOCKS_PER_TILE = 1024;
+
+struct EtcpakCompressionTile {
+	const uint32_t *src = nullptr;
+	uint64_t *dst = nullptr;
+	uint32_t blocks = 0;
+	uint32_t width = 0;
+};
+
+struct EtcpakCompressionJob {
+	EtcpakCompressFunc func = nullptr;
+	const EtcpakCompressionTile *tiles = nullptr;
+};
+
+static void _compress_etc2_rgb(const uint32_t *p_src, uint64_t *p_dst, uint32_t p_blocks, size_t p_width) {
+	CompressEtc2Rgb(p_src, p_dst, p_blocks, p_width, true);
+}
+
+static void _compress_etc2_rgba(const uint32_t *p_src, uint64_t *p_dst, uint32_t p_blocks, size_t p_width) {
+	CompressEtc2Rgba(p_src, p_dst, p_blocks, p_width, true);
+}
+
+static void _digest_tile(void *p_job, uint32_t p_index) {
+	const EtcpakCompressionJob *job = static_cast<const EtcpakCompressionJob *>(p_job);
+	const EtcpakCompressionTile &tile = job->tiles[p_index];
+	job->func(tile.src, tile.dst, tile.blocks, tile.width);
+}
+
 void _compress_etcpak(EtcpakType p_compress_type, Image *r_img) {
 	uint64_t start_time = OS::get_singleton()->get_ticks_msec();
 
@@ -199,8 +233,58 @@ void _compress_etcpak(EtcpakType p_compress_type, Image *r_img) {
 
 	const uint8_t *src_read = r_img->get_data().ptr();
 
+	EtcpakCompressFunc compress_func = nullptr;
+
+	switch (p_compress_type) {
+		case EtcpakType::ETCPAK_TYPE_ETC1:
+			compress_func = CompressEtc1RgbDither;
+			break;
+
+		case EtcpakType::ETCPAK_TYPE_ETC2:
+			compress_func = _compress_etc2_rgb;
+			break;
+
+		case EtcpakType::ETCPAK_TYPE_ETC2_ALPHA:
+		case EtcpakType::ETCPAK_TYPE_ETC2_RA_AS_RG:
+			compress_func = _compress_etc2_rgba;
+			break;
+
+		case EtcpakType::ETCPAK_TYPE_ETC2_R:
+			compress_func = CompressEacR;
+			break;
+
+		case EtcpakType::ETCPAK_TYPE_ETC2_RG:
+			compress_func = CompressEacRg;
+			break;
+
+		case EtcpakType::ETCPAK_TYPE_DXT1:
+			compress_func = CompressDxt1Dither;
+			break;
+
+		case EtcpakType::ETCPAK_TYPE_DXT5:
+		case EtcpakType::ETCPAK_TYPE_DXT5_RA_AS_RG:
+			compress_func = CompressDxt5;
+			break;
+
+		case EtcpakType::ETCPAK_TYPE_RGTC_R:
+			compress_func = CompressBc4;
+			break;
+
+		case EtcpakType::ETCPAK_TYPE_RGTC_RG:
+			compress_func = CompressBc5;
+			break;
+
+		default:
+			ERR_FAIL_MSG("etcpak: Invalid or unsupported compression format.");
+			break;
+	}
+
 	const int mip_count = has_mipmaps ? Image::get_image_required_mipmaps(width, height, target_format) : 0;
-	Vector<uint32_t> padded_src;
+
+	// Padded copies of the mipmaps that aren't a multiple of the block size,
+	// kept alive until all tiles are compressed.
+	LocalVector<Vector<uint32_t>> padded_src;
+	LocalVector<EtcpakCompressionTile> tiles;
 
 	for (int i = 0; i < mip_count + 1; i++) {
 		// Get write mip metrics for target image.
@@ -214,7 +298,6 @@ void _compress_etcpak(EtcpakType p_compress_type, Image *r_img) {
 		// Block size.
 		dest_mip_w = (dest_mip_w + 3) & ~3;
 		dest_mip_h = (dest_mip_h + 3) & ~3;
-		const uint32_t blocks = dest_mip_w * dest_mip_h / 16;
 
 		// Get mip data from source image for reading.
 		int64_t src_mip_ofs, src_mip_size;
@@ -227,8 +310,10 @@ void _compress_etcpak(EtcpakType p_compress_type, Image *r_img) {
 		// Pad textures to nearest block by smearing.
 		if (dest_mip_w != src_mip_w || dest_mip_h != src_mip_h) {
 			// Reserve the buffer for padded image data.
-			padded_src.resize(dest_mip_w * dest_mip_h);
-			uint32_t *ptrw = padded_src.ptrw();
+			padded_src.push_back(Vector<uint32_t>());
+			Vector<uint32_t> &padded = padded_src[padded_src.size() - 1];
+			padded.resize(dest_mip_w * dest_mip_h);
+			uint32_t *ptrw = padded.ptrw();
 
 			int x = 0, y = 0;
 			for (y = 0; y < src_mip_h; y++) {
@@ -250,51 +335,36 @@ void _compress_etcpak(EtcpakType p_compress_type, Image *r_img) {
 			}
 
 			// Override the src_mip_read pointer to our temporary Vector.
-			src_mip_read = padded_src.ptr();
+			src_mip_read = padded.ptr();
 		}
 
-		switch (p_compress_type) {
-			case EtcpakType::ETCPAK_TYPE_ETC1:
-				CompressEtc1RgbDither(src_mip_read, dest_mip_write, blocks, dest_mip_w);
-				break;
-
-			case EtcpakType::ETCPAK_TYPE_ETC2:
-				CompressEtc2Rgb(src_mip_read, dest_mip_write, blocks, dest_mip_w, true);
-				break;
-
-			case EtcpakType::ETCPAK_TYPE_ETC2_ALPHA:
-			case EtcpakType::ETCPAK_TYPE_ETC2_RA_AS_RG:
-				CompressEtc2Rgba(src_mip_read, dest_mip_write, blocks, dest_mip_w, true);
-				break;
-
-			case EtcpakType::ETCPAK_TYPE_ETC2_R:
-				CompressEacR(src_mip_read, dest_mip_write, blocks, dest_mip_w);
-				break;
-
-			case EtcpakType::ETCPAK_TYPE_ETC2_RG:
-				CompressEacRg(src_mip_read, dest_mip_write, blocks, dest_mip_w);
-				break;
-
-			case EtcpakType::ETCPAK_TYPE_DXT1:
-				CompressDxt1Dither(src_mip_read, dest_mip_write, blocks, dest_mip_w);
-				break;
-
-			case EtcpakType::ETCPAK_TYPE_DXT5:
-			case EtcpakType::ETCPAK_TYPE_DXT5_RA_AS_RG:
-				CompressDxt5(src_mip_read, dest_mip_write, blocks, dest_mip_w);
-				break;
-
-			case EtcpakType::ETCPAK_TYPE_RGTC_R:
-				CompressBc4(src_mip_read, dest_mip_write, blocks, dest_mip_w);
-				break;
+		// Split the mipmap into tiles of whole block rows.
+		const uint32_t blocks_per_row = dest_mip_w / 4;
+		const uint32_t block_rows = dest_mip_h / 4;
+		const uint32_t rows_per_tile = MAX(1u, ETCPAK_MIN_BLOCKS_PER_TILE / blocks_per_row);
+		// 8 or 16 bytes per block depending on the format, so count in uint64_t.
+		const uint32_t dst_words_per_row = Image::get_image_data_size(dest_mip_w, 4, target_format, false) / 8;
+
+		for (uint32_t row = 0; row < block_rows; row += rows_per_tile) {
+			EtcpakCompressionTile tile;
+			tile.src = src_mip_read + row * 4 * dest_mip_w;
+			tile.dst = dest_mip_write + row * dst_words_per_row;
+			tile.blocks = MIN(rows_per_tile, block_rows - row) * blocks_per_row;
+			tile.width = dest_mip_w;
+			tiles.push_back(tile);
+		}
+	}
 
-			case EtcpakType::ETCPAK_TYPE_RGTC_RG:
-				CompressBc5(src_mip_read, dest_mip_write, blocks, dest_mip_w);
-				break;
+	EtcpakCompressionJob job;
+	job.func = compress_func;
+	job.tiles = tiles.ptr();
 
-			default:
-				ERR_FAIL_MSG("etcpak: Invalid or unsupported compression format.");
-				break;
+	if (tiles.size() > 1 && WorkerThreadPool::get_singleton()->get_thread_count() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_digest_tile, &job, tiles.size(), -1, true, SNAME("Etcpak Compress"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < tiles.size(); i++) {
+			_digest_tile(&job, i);
 		}
 	}
 
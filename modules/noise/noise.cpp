@@ -30,8 +30,25 @@
 
 #include "noise.h"
 
+#include "core/object/worker_thread_pool.h"
+
 #include <float.h>
 
+// Sampling below this amount is faster on the calling thread than dispatching to the pool.
+static constexpr uint64_t NOISE_PARALLEL_MIN_SAMPLES = 64 * 64;
+
+// Splits p_count independent items (image rows or sample points) into ranges processed by the WorkerThreadPool.
+// p_func(from, to) is called for each range and must only write to items in [from, to).
+template <typename F>
+static void _noise_process_ranges(uint32_t p_count, uint64_t p_samples, const F &p_func) {
+	if (p_samples < NOISE_PARALLEL_MIN_SAMPLES) {
+		p_func(0, p_count);
+		return;
+	}
+	// Cellular and fractal noise cost varies a lot per sample, so oversplit.
+	WorkerThreadPool::process_ranges(p_count, 4, p_func, SNAME("NoiseProcessRanges"));
+}
+
 Vector<Ref<Image>> Noise::_get_seamless_image(int p_width, int p_height, int p_depth, bool p_invert, bool p_in_3d_space, real_t p_blend_skirt, bool p_normalize) const {
 	ERR_FAIL_COND_V(p_width <= 0 || p_height <= 0 || p_depth <= 0, Vector<Ref<Image>>());
 
@@ -86,79 +103,100 @@ Vector<Ref<Image>> Noise::_get_image(int p_width, int p_height, int p_depth, boo
 	Vector<Ref<Image>> images;
 	images.resize(p_depth);
 
+	// Rows of all slices are sampled independently, indexed as `d * p_height + y`.
+	const uint32_t rows = p_height * p_depth;
+	const uint64_t samples = uint64_t(p_width) * rows;
+
+	LocalVector<Vector<uint8_t>> slices;
+	LocalVector<uint8_t *> slice_ptrs;
+	slices.resize(p_depth);
+	slice_ptrs.resize(p_depth);
+	for (int d = 0; d < p_depth; d++) {
+		slices[d].resize(p_width * p_height);
+		slice_ptrs[d] = slices[d].ptrw();
+	}
+
 	if (p_normalize) {
-		// Get all values and identify min/max values.
+		// Get all values and identify min/max values per row, then reduce.
 		LocalVector<real_t> values;
-		values.resize(p_width * p_height * p_depth);
+		values.resize(samples);
+		LocalVector<real_t> row_min;
+		LocalVector<real_t> row_max;
+		row_min.resize(rows);
+		row_max.resize(rows);
 
-		real_t min_val = FLT_MAX;
-		real_t max_val = -FLT_MAX;
-		int idx = 0;
-		for (int d = 0; d < p_depth; d++) {
-			for (int y = 0; y < p_height; y++) {
+		_noise_process_ranges(rows, samples, [&](uint32_t p_from, uint32_t p_to) {
+			for (uint32_t r = p_from; r < p_to; r++) {
+				const int d = r / p_height;
+				const int y = r % p_height;
+				real_t *row_values = &values[uint64_t(r) * p_width];
+				real_t min_val = FLT_MAX;
+				real_t max_val = -FLT_MAX;
 				for (int x = 0; x < p_width; x++) {
-					values[idx] = p_in_3d_space ? get_noise_3d(x, y, d) : get_noise_2d(x, y);
-					if (values[idx] > max_val) {
-						max_val = values[idx];
+					const real_t value = p_in_3d_space ? get_noise_3d(x, y, d) : get_noise_2d(x, y);
+					row_values[x] = value;
+					if (value > max_val) {
+						max_val = value;
 					}
-					if (values[idx] < min_val) {
-						min_val = values[idx];
+					if (value < min_val) {
+						min_val = value;
 					}
-					idx++;
 				}
+				row_min[r] = min_val;
+				row_max[r] = max_val;
 			}
+		});
+
+		real_t min_val = FLT_MAX;
+		real_t max_val = -FLT_MAX;
+		for (uint32_t r = 0; r < rows; r++) {
+			min_val = MIN(min_val, row_min[r]);
+			max_val = MAX(max_val, row_max[r]);
 		}
-		idx = 0;
-		// Normalize values and write to texture.
-		for (int d = 0; d < p_depth; d++) {
-			Vector<uint8_t> data;
-			data.resize(p_width * p_height);
 
-			uint8_t *wd8 = data.ptrw();
-			uint8_t ivalue;
+		// Normalize values and write to texture.
+		_noise_process_ranges(rows, samples, [&](uint32_t p_from, uint32_t p_to) {
+			for (uint32_t r = p_from; r < p_to; r++) {
+				const real_t *row_values = &values[uint64_t(r) * p_width];
+				uint8_t *wd8 = slice_ptrs[r / p_height] + (r % p_height) * p_width;
+				uint8_t ivalue;
 
-			for (int y = 0; y < p_height; y++) {
 				for (int x = 0; x < p_width; x++) {
 					if (max_val == min_val) {
 						ivalue = 0;
 					} else {
-						ivalue = static_cast<uint8_t>(CLAMP((values[idx] - min_val) / (max_val - min_val) * 255.f, 0, 255));
+						ivalue = static_cast<uint8_t>(CLAMP((row_values[x] - min_val) / (max_val - min_val) * 255.f, 0, 255));
 					}
 
 					if (p_invert) {
 						ivalue = 255 - ivalue;
 					}
 
-					wd8[x + y * p_width] = ivalue;
-					idx++;
+					wd8[x] = ivalue;
 				}
 			}
-			Ref<Image> img = memnew(Image(p_width, p_height, false, Image::FORMAT_L8, data));
-			images.write[d] = img;
-		}
+		});
 	} else {
 		// Without normalization, the expected range of the noise function is [-1, 1].
+		_noise_process_ranges(rows, samples, [&](uint32_t p_from, uint32_t p_to) {
+			for (uint32_t r = p_from; r < p_to; r++) {
+				const int d = r / p_height;
+				const int y = r % p_height;
+				uint8_t *wd8 = slice_ptrs[d] + y * p_width;
+				uint8_t ivalue;
 
-		for (int d = 0; d < p_depth; d++) {
-			Vector<uint8_t> data;
-			data.resize(p_width * p_height);
-
-			uint8_t *wd8 = data.ptrw();
-
-			uint8_t ivalue;
-			int idx = 0;
-			for (int y = 0; y < p_height; y++) {
 				for (int x = 0; x < p_width; x++) {
 					float value = (p_in_3d_space ? get_noise_3d(x, y, d) : get_noise_2d(x, y));
 					ivalue = static_cast<uint8_t>(CLAMP(value * 127.5f + 127.5f, 0.0f, 255.0f));
-					wd8[idx] = p_invert ? (255 - ivalue) : ivalue;
-					idx++;
+					wd8[x] = p_invert ? (255 - ivalue) : ivalue;
 				}
 			}
+		});
+	}
 
-			Ref<Image> img = memnew(Image(p_width, p_height, false, Image::FORMAT_L8, data));
-			images.write[d] = img;
-		}
+	for (int d = 0; d < p_depth; d++) {
+		Ref<Image> img = memnew(Image(p_width, p_height, false, Image::FORMAT_L8, slices[d]));
+		images.write[d] = img;
 	}
 
 	return images;
@@ -183,6 +221,40 @@ TypedArray<Image> Noise::get_image_3d(int p_width, int p_height, int p_depth, bo
 	return ret;
 }
 
+PackedFloat32Array Noise::get_noise_2d_batch(const PackedVector2Array &p_points) const {
+	PackedFloat32Array ret;
+	ret.resize(p_points.size());
+	if (p_points.is_empty()) {
+		return ret;
+	}
+
+	const Vector2 *r = p_points.ptr();
+	float *w = ret.ptrw();
+	_noise_process_ranges(p_points.size(), p_points.size(), [&](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			w[i] = get_noise_2d(r[i].x, r[i].y);
+		}
+	});
+	return ret;
+}
+
+PackedFloat32Array Noise::get_noise_3d_batch(const PackedVector3Array &p_points) const {
+	PackedFloat32Array ret;
+	ret.resize(p_points.size());
+	if (p_points.is_empty()) {
+		return ret;
+	}
+
+	const Vector3 *r = p_points.ptr();
+	float *w = ret.ptrw();
+	_noise_process_ranges(p_points.size(), p_points.size(), [&](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			w[i] = get_noise_3d(r[i].x, r[i].y, r[i].z);
+		}
+	});
+	return ret;
+}
+
 void Noise::_bind_methods() {
 	// Noise functions.
 	ClassDB::bind_method(D_METHOD("get_noise_1d", "x"), &Noise::get_noise_1d);
@@ -190,6 +262,8 @@ void Noise::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_noise_2dv", "v"), &Noise::get_noise_2dv);
 	ClassDB::bind_method(D_METHOD("get_noise_3d", "x", "y", "z"), &Noise::get_noise_3d);
 	ClassDB::bind_method(D_METHOD("get_noise_3dv", "v"), &Noise::get_noise_3dv);
+	ClassDB::bind_method(D_METHOD("get_noise_2d_batch", "points"), &Noise::get_noise_2d_batch);
+	ClassDB::bind_method(D_METHOD("get_noise_3d_batch", "points"), &Noise::get_noise_3d_batch);
 
 	// Textures.
 	ClassDB::bind_method(D_METHOD("get_image", "width", "height", "invert", "in_3d_space", "normalize"), &Noise::get_image, DEFVAL(false), DEFVAL(false), DEFVAL(true));
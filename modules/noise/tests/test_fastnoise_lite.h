@@ -632,6 +632,80 @@ TEST_CASE("[FastNoiseLite] Generating seamless 2D images (11x11px) and compare t
 	}
 }
 
+TEST_CASE("[FastNoiseLite] Threaded image generation and batch sampling") {
+	const FastNoiseLite::NoiseType noise_types[] = {
+		FastNoiseLite::NoiseType::TYPE_SIMPLEX,
+		FastNoiseLite::NoiseType::TYPE_SIMPLEX_SMOOTH,
+		FastNoiseLite::NoiseType::TYPE_CELLULAR,
+		FastNoiseLite::NoiseType::TYPE_PERLIN,
+		FastNoiseLite::NoiseType::TYPE_VALUE_CUBIC,
+		FastNoiseLite::NoiseType::TYPE_VALUE,
+	};
+	// Just large enough for sampling to be split over the WorkerThreadPool.
+	const int size = 64;
+	const int depth = 2;
+
+	for (FastNoiseLite::NoiseType noise_type : noise_types) {
+		FastNoiseLite noise;
+		noise.set_noise_type(noise_type);
+		noise.set_fractal_type(FastNoiseLite::FractalType::FRACTAL_FBM);
+
+		Ref<Image> img = noise.get_image(size, size, false, false, false);
+		REQUIRE(img.is_valid());
+
+		PackedVector2Array points;
+		points.resize(size * size);
+		for (int y = 0; y < size; y++) {
+			for (int x = 0; x < size; x++) {
+				points.set(y * size + x, Vector2(x, y));
+			}
+		}
+
+		PackedFloat32Array values = noise.get_noise_2d_batch(points);
+		REQUIRE(values.size() == points.size());
+
+		bool all_match = true;
+		for (int y = 0; y < size; y++) {
+			for (int x = 0; x < size; x++) {
+				const float value = noise.get_noise_2d(x, y);
+				const uint8_t expected = static_cast<uint8_t>(CLAMP(value * 127.5f + 127.5f, 0.0f, 255.0f));
+				all_match = all_match && values[y * size + x] == value && img->get_data()[y * size + x] == expected;
+			}
+		}
+		CHECK_MESSAGE(all_match, "Threaded image generation and batch sampling should match per-point sampling.");
+
+		// Normalized 3D images use the global min/max of all slices.
+		TypedArray<Image> slices = noise.get_image_3d(size, size, depth);
+		REQUIRE(slices.size() == depth);
+		PackedVector3Array points_3d;
+		points_3d.resize(size * size * depth);
+		for (int d = 0; d < depth; d++) {
+			for (int y = 0; y < size; y++) {
+				for (int x = 0; x < size; x++) {
+					points_3d.set((d * size + y) * size + x, Vector3(x, y, d));
+				}
+			}
+		}
+		PackedFloat32Array values_3d = noise.get_noise_3d_batch(points_3d);
+		float min_val = FLT_MAX;
+		float max_val = -FLT_MAX;
+		for (int i = 0; i < values_3d.size(); i++) {
+			min_val = MIN(min_val, values_3d[i]);
+			max_val = MAX(max_val, values_3d[i]);
+		}
+		all_match = true;
+		for (int d = 0; d < depth; d++) {
+			Ref<Image> slice = slices[d];
+			for (int i = 0; i < size * size; i++) {
+				const float value = noise.get_noise_3d(i % size, i / size, d);
+				const uint8_t expected = static_cast<uint8_t>(CLAMP((value - min_val) / (max_val - min_val) * 255.f, 0, 255));
+				all_match = all_match && values_3d[d * size * size + i] == value && slice->get_data()[i] == expected;
+			}
+		}
+		CHECK_MESSAGE(all_match, "Threaded 3D image generation should match per-point sampling.");
+	}
+}
+
 } //namespace TestFastNoiseLite
 
 #endif // TEST_FASTNOISE_LITE_H
@@ -148,6 +148,7 @@
 #include "scene/resources/text_line.h"
 #include "scene/resources/text_paragraph.h"
 #include "scene/resources/texture.h"
+#include "scene/resources/texture_atlas.h"
 #include "scene/resources/texture_rd.h"
 #include "scene/resources/theme.h"
 #include "scene/resources/video_stream.h"
@@ -342,6 +343,7 @@ void register_scene_types() {
 	ResourceSaver::add_resource_format_saver(resource_saver_text, true);
 
 	resource_loader_text.instantiate();
+	resource_loader_text->set_binary_cache_enabled(GLOBAL_DEF("filesystem/resources/cache_text_resources_as_binary", false));
 	ResourceLoader::add_resource_format_loader(resource_loader_text, true);
 
 	resource_saver_shader.instantiate();
@@ -919,6 +921,7 @@ void register_scene_types() {
 	GDREGISTER_CLASS(PortableCompressedTexture2D);
 	GDREGISTER_CLASS(ImageTexture);
 	GDREGISTER_CLASS(AtlasTexture);
+	GDREGISTER_CLASS(TextureAtlas);
 	GDREGISTER_CLASS(MeshTexture);
 	GDREGISTER_CLASS(CurveTexture);
 	GDREGISTER_CLASS(CurveXYZTexture);
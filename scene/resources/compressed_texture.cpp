@@ -30,6 +30,7 @@
 
 #include "compressed_texture.h"
 
+#include "core/config/project_settings.h"
 #include "scene/resources/bit_map.h"
 
 Error CompressedTexture2D::_load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit) {
@@ -79,6 +80,14 @@ Error CompressedTexture2D::_load_data(const String &p_path, int &r_width, int &r
 		p_size_limit = 0;
 	}
 
+	if (p_size_limit == 0 && GLOBAL_GET("rendering/textures/streaming/enabled")) {
+		Ref<Image> base_image = _load_stream_base(f);
+		if (base_image.is_valid()) {
+			image = base_image;
+			return OK;
+		}
+	}
+
 	image = load_image_from_file(f, p_size_limit);
 
 	if (image.is_null() || image->is_empty()) {
@@ -125,7 +134,247 @@ Image::Format CompressedTexture2D::get_format() const {
 	return format;
 }
 
+Ref<Image> CompressedTexture2D::_load_stream_base(Ref<FileAccess> p_file) {
+	uint64_t image_offset = p_file->get_position();
+	uint32_t data_format = p_file->get_32();
+	int iw = p_file->get_16();
+	int ih = p_file->get_16();
+	int mipmaps = p_file->get_32();
+	Image::Format image_format = Image::Format(p_file->get_32());
+
+	// Only raw image data can be read one mipmap at a time; PNG, WebP and Basis Universal are decoded as a whole.
+	if (data_format != DATA_FORMAT_IMAGE || image_format >= Image::FORMAT_MAX || mipmaps == 0 || mipmaps != Image::get_image_required_mipmaps(iw, ih, image_format)) {
+		p_file->seek(image_offset);
+		return Ref<Image>();
+	}
+
+	int initial_size = MAX(int(GLOBAL_GET("rendering/textures/streaming/initial_size")), 1);
+	int base_mip = 0;
+	while (base_mip < mipmaps) {
+		int tw, th;
+		Image::get_image_mipmap_offset_and_dimensions(iw, ih, image_format, base_mip, tw, th);
+		if (MAX(tw, th) <= initial_size) {
+			break;
+		}
+		base_mip++;
+	}
+
+	if (base_mip == 0) {
+		// Small enough to be loaded whole.
+		p_file->seek(image_offset);
+		return Ref<Image>();
+	}
+
+	streaming = true;
+	stream_data_offset = p_file->get_position();
+	stream_width = iw;
+	stream_height = ih;
+	stream_mipmaps = mipmaps;
+	stream_base_mip = base_mip;
+	stream_resident_mip = base_mip;
+	stream_requested_mip = base_mip;
+	format = image_format;
+
+	stream_base_image = _load_stream_mipmaps(p_file, base_mip);
+	if (stream_base_image.is_null()) {
+		streaming = false;
+		p_file->seek(image_offset);
+	}
+	return stream_base_image;
+}
+
+Ref<Image> CompressedTexture2D::_load_stream_mipmaps(Ref<FileAccess> p_file, int p_from_mip) const {
+	int tw, th;
+	int64_t ofs = Image::get_image_mipmap_offset_and_dimensions(stream_width, stream_height, format, p_from_mip, tw, th);
+
+	Vector<uint8_t> data;
+	data.resize(_get_stream_mipmaps_size(p_from_mip));
+	p_file->seek(stream_data_offset + ofs);
+	uint64_t read = p_file->get_buffer(data.ptrw(), data.size());
+	ERR_FAIL_COND_V_MSG(read != uint64_t(data.size()), Ref<Image>(), vformat("Compressed texture file is truncated: %s.", path_to_file));
+
+	return Image::create_from_data(tw, th, p_from_mip < stream_mipmaps, format, data);
+}
+
+uint64_t CompressedTexture2D::_get_stream_mipmaps_size(int p_from_mip) const {
+	return Image::get_image_data_size(stream_width, stream_height, format, true) - Image::get_image_mipmap_offset(stream_width, stream_height, format, p_from_mip);
+}
+
+int CompressedTexture2D::_get_stream_mip_for_size(int p_size) const {
+	// Coarsest mipmap that is still at least as large as the requested size.
+	for (int i = stream_base_mip; i > 0; i--) {
+		int tw, th;
+		Image::get_image_mipmap_offset_and_dimensions(stream_width, stream_height, format, i, tw, th);
+		if (MAX(tw, th) >= p_size) {
+			return i;
+		}
+	}
+	return 0;
+}
+
+void CompressedTexture2D::_stream_task(void *p_userdata) {
+	CompressedTexture2D *ct = (CompressedTexture2D *)p_userdata;
+
+	Ref<FileAccess> f = FileAccess::open(ct->path_to_file, FileAccess::READ);
+	if (f.is_valid()) {
+		ct->stream_loaded_image = ct->_load_stream_mipmaps(f, ct->stream_loading_mip);
+	} else {
+		ERR_PRINT(vformat("Unable to open file for texture streaming: %s.", ct->path_to_file));
+	}
+
+	// The texture must be updated from the main thread. If the texture is freed first,
+	// its destructor waits for this task and the deferred call is discarded.
+	callable_mp(ct, &CompressedTexture2D::_stream_finish).call_deferred();
+}
+
+void CompressedTexture2D::_stream_start(int p_mip) {
+	stream_loading_mip = p_mip;
+	stream_loaded_image.unref();
+	stream_task = WorkerThreadPool::get_singleton()->add_native_task(&CompressedTexture2D::_stream_task, this, false, "StreamCompressedTexture2D");
+}
+
+void CompressedTexture2D::_stream_finish() {
+	if (stream_task == WorkerThreadPool::INVALID_TASK_ID) {
+		return; // Already finished by wait_for_streaming().
+	}
+
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(stream_task);
+	stream_task = WorkerThreadPool::INVALID_TASK_ID;
+
+	Ref<Image> image = stream_loaded_image;
+	stream_loaded_image.unref();
+	if (image.is_valid() && stream_loading_mip < stream_resident_mip) {
+		_stream_set_resident(image, stream_loading_mip);
+		_stream_enforce_budget(this);
+	}
+
+	if (image.is_valid() && stream_requested_mip < stream_resident_mip) {
+		// A finer size was requested while loading.
+		_stream_start(stream_requested_mip);
+	} else {
+		stream_requested_mip = stream_resident_mip;
+	}
+}
+
+void CompressedTexture2D::_stream_set_resident(const Ref<Image> &p_image, int p_mip) {
+	RID new_texture = RS::get_singleton()->texture_2d_create(p_image);
+	RS::get_singleton()->texture_replace(texture, new_texture);
+	RS::get_singleton()->texture_set_size_override(texture, w, h);
+	alpha_cache.unref();
+
+	MutexLock lock(stream_mutex);
+	stream_memory_usage -= _get_stream_mipmaps_size(stream_resident_mip) - _get_stream_mipmaps_size(stream_base_mip);
+	stream_memory_usage += _get_stream_mipmaps_size(p_mip) - _get_stream_mipmaps_size(stream_base_mip);
+	stream_resident_mip = p_mip;
+
+	if (stream_lru_item.in_list()) {
+		stream_lru.remove(&stream_lru_item);
+	}
+	if (stream_resident_mip < stream_base_mip) {
+		stream_lru.add_last(&stream_lru_item);
+	}
+}
+
+void CompressedTexture2D::_stream_enforce_budget(CompressedTexture2D *p_keep) {
+	uint64_t budget = uint64_t(MAX(int(GLOBAL_GET("rendering/textures/streaming/memory_budget_mb")), 0)) * 1024 * 1024;
+	if (budget == 0) {
+		return; // Unlimited.
+	}
+
+	// The downgrade happens with the lock held, so the victim can't be freed meanwhile
+	// (its destructor has to take the lock to leave the eviction queue).
+	MutexLock lock(stream_mutex);
+	while (stream_memory_usage > budget) {
+		CompressedTexture2D *victim = nullptr;
+		// Least recently used first; the texture that just grew is only dropped as a last resort.
+		for (SelfList<CompressedTexture2D> *E = stream_lru.first(); E; E = E->next()) {
+			if (E->self() != p_keep && !E->self()->stream_pinned) {
+				victim = E->self();
+				break;
+			}
+		}
+
+		if (!victim) {
+			break;
+		}
+		victim->_stream_set_resident(victim->stream_base_image, victim->stream_base_mip);
+		victim->stream_requested_mip = MAX(victim->stream_requested_mip, victim->stream_base_mip);
+	}
+}
+
+void CompressedTexture2D::_stream_clear() {
+	if (stream_task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(stream_task);
+		stream_task = WorkerThreadPool::INVALID_TASK_ID;
+	}
+
+	if (streaming) {
+		MutexLock lock(stream_mutex);
+		stream_memory_usage -= _get_stream_mipmaps_size(stream_resident_mip) - _get_stream_mipmaps_size(stream_base_mip);
+		if (stream_lru_item.in_list()) {
+			stream_lru.remove(&stream_lru_item);
+		}
+	}
+
+	streaming = false;
+	stream_pinned = false;
+	stream_base_image.unref();
+	stream_loaded_image.unref();
+}
+
+bool CompressedTexture2D::is_streaming() const {
+	return streaming;
+}
+
+void CompressedTexture2D::request_streaming_size(int p_size) {
+	if (!streaming) {
+		return;
+	}
+
+	int mip = _get_stream_mip_for_size(p_size);
+	if (mip >= stream_resident_mip) {
+		if (stream_resident_mip < stream_base_mip) {
+			// Still in use, move to the back of the eviction queue.
+			MutexLock lock(stream_mutex);
+			stream_lru.remove(&stream_lru_item);
+			stream_lru.add_last(&stream_lru_item);
+		}
+		return;
+	}
+
+	stream_requested_mip = MIN(stream_requested_mip, mip);
+	if (stream_task == WorkerThreadPool::INVALID_TASK_ID) {
+		_stream_start(stream_requested_mip);
+	}
+}
+
+int CompressedTexture2D::get_streaming_resident_size() const {
+	if (!streaming) {
+		return MAX(w, h);
+	}
+	int tw, th;
+	Image::get_image_mipmap_offset_and_dimensions(stream_width, stream_height, format, stream_resident_mip, tw, th);
+	return MAX(tw, th);
+}
+
+void CompressedTexture2D::wait_for_streaming() {
+	while (stream_task != WorkerThreadPool::INVALID_TASK_ID) {
+		_stream_finish();
+	}
+}
+
+uint64_t CompressedTexture2D::get_streaming_memory_usage() {
+	MutexLock lock(stream_mutex);
+	return stream_memory_usage;
+}
+
+Mutex CompressedTexture2D::stream_mutex;
+SelfList<CompressedTexture2D>::List CompressedTexture2D::stream_lru;
+uint64_t CompressedTexture2D::stream_memory_usage = 0;
+
 Error CompressedTexture2D::load(const String &p_path) {
+	_stream_clear();
+
 	int lw, lh;
 	Ref<Image> image;
 	image.instantiate();
@@ -154,6 +403,11 @@ Error CompressedTexture2D::load(const String &p_path) {
 	h = lh;
 	path_to_file = p_path;
 	format = image->get_format();
+	if (streaming && !w && !h) {
+		w = stream_width;
+		h = stream_height;
+		RS::get_singleton()->texture_set_size_override(texture, w, h);
+	}
 
 	if (get_path().is_empty()) {
 		//temporarily set path if no path set for resource, helps find errors
@@ -208,6 +462,13 @@ RID CompressedTexture2D::get_rid() const {
 	if (!texture.is_valid()) {
 		texture = RS::get_singleton()->texture_2d_placeholder_create();
 	}
+	if (streaming && !stream_pinned) {
+		// Sampled outside of the 2D draw methods (e.g. by a material), so there is no way
+		// to tell which size is needed. Load it whole and never evict it.
+		CompressedTexture2D *self = const_cast<CompressedTexture2D *>(this);
+		self->stream_pinned = true;
+		self->request_streaming_size(MAX(w, h));
+	}
 	return texture;
 }
 
@@ -215,6 +476,9 @@ void CompressedTexture2D::draw(RID p_canvas_item, const Point2 &p_pos, const Col
 	if ((w | h) == 0) {
 		return;
 	}
+	if (streaming) {
+		const_cast<CompressedTexture2D *>(this)->request_streaming_size(MAX(w, h));
+	}
 	RenderingServer::get_singleton()->canvas_item_add_texture_rect(p_canvas_item, Rect2(p_pos, Size2(w, h)), texture, false, p_modulate, p_transpose);
 }
 
@@ -222,6 +486,10 @@ void CompressedTexture2D::draw_rect(RID p_canvas_item, const Rect2 &p_rect, bool
 	if ((w | h) == 0) {
 		return;
 	}
+	if (streaming) {
+		Size2 size = p_tile ? Size2(w, h) : p_rect.size.abs();
+		const_cast<CompressedTexture2D *>(this)->request_streaming_size(Math::ceil(MAX(size.width, size.height)));
+	}
 	RenderingServer::get_singleton()->canvas_item_add_texture_rect(p_canvas_item, p_rect, texture, p_tile, p_modulate, p_transpose);
 }
 
@@ -229,6 +497,11 @@ void CompressedTexture2D::draw_rect_region(RID p_canvas_item, const Rect2 &p_rec
 	if ((w | h) == 0) {
 		return;
 	}
+	if (streaming && p_src_rect.size.x != 0 && p_src_rect.size.y != 0) {
+		// Resolution the whole texture would need for the region to be drawn at this size.
+		Size2 size = p_rect.size.abs() * Size2(w, h) / p_src_rect.size.abs();
+		const_cast<CompressedTexture2D *>(this)->request_streaming_size(Math::ceil(MAX(size.width, size.height)));
+	}
 	RenderingServer::get_singleton()->canvas_item_add_texture_rect_region(p_canvas_item, p_rect, texture, p_src_rect, p_modulate, p_transpose, p_clip_uv);
 }
 
@@ -453,13 +726,20 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 void CompressedTexture2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("load", "path"), &CompressedTexture2D::load);
 	ClassDB::bind_method(D_METHOD("get_load_path"), &CompressedTexture2D::get_load_path);
+	ClassDB::bind_method(D_METHOD("is_streaming"), &CompressedTexture2D::is_streaming);
+	ClassDB::bind_method(D_METHOD("request_streaming_size", "size"), &CompressedTexture2D::request_streaming_size);
+	ClassDB::bind_method(D_METHOD("get_streaming_resident_size"), &CompressedTexture2D::get_streaming_resident_size);
+	ClassDB::bind_static_method("CompressedTexture2D", D_METHOD("get_streaming_memory_usage"), &CompressedTexture2D::get_streaming_memory_usage);
 
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "load_path", PROPERTY_HINT_FILE, "*.ctex"), "load", "get_load_path");
 }
 
-CompressedTexture2D::CompressedTexture2D() {}
+CompressedTexture2D::CompressedTexture2D() :
+		stream_lru_item(this) {
+}
 
 CompressedTexture2D::~CompressedTexture2D() {
+	_stream_clear();
 	if (texture.is_valid()) {
 		ERR_FAIL_NULL(RenderingServer::get_singleton());
 		RS::get_singleton()->free(texture);
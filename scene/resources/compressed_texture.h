@@ -31,6 +31,8 @@
 #ifndef COMPRESSED_TEXTURE_H
 #define COMPRESSED_TEXTURE_H
 
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/self_list.h"
 #include "scene/resources/texture.h"
 
 class BitMap;
@@ -67,6 +69,40 @@ private:
 	int h = 0;
 	mutable Ref<BitMap> alpha_cache;
 
+	// Mipmap streaming: only the mipmaps from `stream_base_mip` down are loaded up front,
+	// finer ones are read from the file on demand and dropped again when over budget.
+	// Requests only come from the 2D draw methods; once the RID is handed out for any other
+	// use (materials, meshes, styleboxes...) the texture is loaded whole and kept that way.
+	bool streaming = false;
+	bool stream_pinned = false;
+	uint64_t stream_data_offset = 0;
+	int stream_width = 0;
+	int stream_height = 0;
+	int stream_mipmaps = 0;
+	int stream_base_mip = 0;
+	int stream_resident_mip = 0;
+	int stream_requested_mip = 0;
+	int stream_loading_mip = 0;
+	Ref<Image> stream_base_image;
+	Ref<Image> stream_loaded_image;
+	WorkerThreadPool::TaskID stream_task = WorkerThreadPool::INVALID_TASK_ID;
+	SelfList<CompressedTexture2D> stream_lru_item;
+
+	static Mutex stream_mutex;
+	static SelfList<CompressedTexture2D>::List stream_lru;
+	static uint64_t stream_memory_usage;
+
+	Ref<Image> _load_stream_base(Ref<FileAccess> p_file);
+	Ref<Image> _load_stream_mipmaps(Ref<FileAccess> p_file, int p_from_mip) const;
+	uint64_t _get_stream_mipmaps_size(int p_from_mip) const;
+	int _get_stream_mip_for_size(int p_size) const;
+	void _stream_start(int p_mip);
+	void _stream_finish();
+	void _stream_set_resident(const Ref<Image> &p_image, int p_mip);
+	void _stream_clear();
+	static void _stream_task(void *p_userdata);
+	static void _stream_enforce_budget(CompressedTexture2D *p_keep);
+
 	Error _load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit = 0);
 	virtual void reload_from_file() override;
 
@@ -107,6 +143,12 @@ public:
 
 	virtual Ref<Image> get_image() const override;
 
+	bool is_streaming() const;
+	void request_streaming_size(int p_size);
+	int get_streaming_resident_size() const;
+	void wait_for_streaming();
+	static uint64_t get_streaming_memory_usage();
+
 	CompressedTexture2D();
 	~CompressedTexture2D();
 };
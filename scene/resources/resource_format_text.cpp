@@ -30,10 +30,15 @@
 
 #include "resource_format_text.h"
 
+#include "core/config/engine.h"
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
+#include "core/io/file_access_pack.h"
 #include "core/io/missing_resource.h"
+#include "core/io/resource_format_binary.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
+#include "core/version.h"
 
 ///
 
@@ -1376,6 +1381,100 @@ ResourceUID::ID ResourceLoaderText::get_uid(Ref<FileAccess> p_f) {
 
 /////////////////////
 
+bool ResourceFormatLoaderText::_can_use_binary_cache(const String &p_path) const {
+	if (!binary_cache_enabled || Engine::get_singleton()->is_editor_hint()) {
+		return false;
+	}
+	if (!p_path.begins_with("res://") || PackedData::get_singleton()->has_path(p_path)) {
+		return false; // Only for projects running from their files; exported ones are converted to binary already.
+	}
+	// Only use it in projects that were opened in the editor, never create the project data folder.
+	return DirAccess::dir_exists_absolute(ProjectSettings::get_singleton()->get_project_data_path());
+}
+
+String ResourceFormatLoaderText::_get_binary_cache_path(const String &p_path) const {
+	return ProjectSettings::get_singleton()->get_project_data_path().path_join("text_resource_cache").path_join(p_path.get_file().get_basename() + "-" + p_path.md5_text() + ".res");
+}
+
+bool ResourceFormatLoaderText::_is_binary_cache_valid(const String &p_path, const String &p_cache_path) const {
+	Ref<FileAccess> f = FileAccess::open(p_cache_path + ".info", FileAccess::READ);
+	if (f.is_null() || !FileAccess::exists(p_cache_path)) {
+		return false;
+	}
+
+	// Line format: cache version, engine version, source path, source modified time, source MD5.
+	if (f->get_line().to_int() != BINARY_CACHE_VERSION || f->get_line() != String(VERSION_FULL_BUILD) + "." + String(VERSION_HASH) || f->get_line() != p_path) {
+		return false;
+	}
+	uint64_t modified_time = f->get_line().to_int();
+	String md5 = f->get_line();
+	f.unref();
+
+	if (modified_time == FileAccess::get_modified_time(p_path)) {
+		return true;
+	}
+
+	// Touched but possibly unchanged (e.g. after a VCS checkout), compare the contents.
+	if (md5 != FileAccess::get_md5(p_path)) {
+		return false;
+	}
+
+	_store_binary_cache_info(p_path, p_cache_path, FileAccess::get_modified_time(p_path), md5);
+	return true;
+}
+
+String ResourceFormatLoaderText::_get_binary_cache_temp_path(const String &p_cache_path) const {
+	// Unique per process and thread, as several loads or running instances may write the same entry.
+	return p_cache_path + "." + itos(OS::get_singleton()->get_process_id()) + "-" + itos(Thread::get_caller_id()) + ".tmp";
+}
+
+void ResourceFormatLoaderText::_store_binary_cache_info(const String &p_path, const String &p_cache_path, uint64_t p_modified_time, const String &p_md5) const {
+	const String temp_path = _get_binary_cache_temp_path(p_cache_path + ".info");
+	{
+		Ref<FileAccess> f = FileAccess::open(temp_path, FileAccess::WRITE);
+		if (f.is_null()) {
+			return;
+		}
+		f->store_line(itos(BINARY_CACHE_VERSION));
+		f->store_line(String(VERSION_FULL_BUILD) + "." + String(VERSION_HASH));
+		f->store_line(p_path);
+		f->store_line(itos(p_modified_time));
+		f->store_line(p_md5);
+	}
+
+	Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_RESOURCES);
+	if (da->rename(temp_path, p_cache_path + ".info") != OK) {
+		da->remove(temp_path);
+	}
+}
+
+void ResourceFormatLoaderText::_save_binary_cache(const String &p_path, const String &p_cache_path, const Ref<Resource> &p_resource) const {
+	Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_RESOURCES);
+	if (da->make_dir_recursive(p_cache_path.get_base_dir()) != OK) {
+		return;
+	}
+	// Remove the info first, so an interrupted save is never taken as valid.
+	if (da->file_exists(p_cache_path + ".info")) {
+		da->remove(p_cache_path + ".info");
+	}
+
+	const uint64_t modified_time = FileAccess::get_modified_time(p_path);
+	const String md5 = FileAccess::get_md5(p_path);
+
+	// Both files are written under a temporary name and renamed in place, the info last,
+	// so readers never see a partially written entry.
+	const String temp_path = _get_binary_cache_temp_path(p_cache_path);
+	ResourceFormatSaverBinary saver;
+	if (saver.save(p_resource, temp_path) != OK || da->rename(temp_path, p_cache_path) != OK) {
+		if (da->file_exists(temp_path)) {
+			da->remove(temp_path);
+		}
+		return;
+	}
+
+	_store_binary_cache_info(p_path, p_cache_path, modified_time, md5);
+}
+
 Ref<Resource> ResourceFormatLoaderText::load(const String &p_path, const String &p_original_path, Error *r_error, bool p_use_sub_threads, float *r_progress, CacheMode p_cache_mode) {
 	if (r_error) {
 		*r_error = ERR_CANT_OPEN;
@@ -1383,6 +1482,22 @@ Ref<Resource> ResourceFormatLoaderText::load(const String &p_path, const String
 
 	Error err;
 
+	String binary_cache_path;
+	if (_can_use_binary_cache(p_path)) {
+		binary_cache_path = _get_binary_cache_path(p_path);
+		if (_is_binary_cache_valid(p_path, binary_cache_path)) {
+			ResourceFormatLoaderBinary binary_loader;
+			Ref<Resource> res = binary_loader.load(binary_cache_path, !p_original_path.is_empty() ? p_original_path : p_path, &err, p_use_sub_threads, r_progress, p_cache_mode);
+			if (res.is_valid()) {
+				if (r_error) {
+					*r_error = OK;
+				}
+				return res;
+			}
+			// Fall back to parsing the text file, which also refreshes the cache.
+		}
+	}
+
 	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
 
 	ERR_FAIL_COND_V_MSG(err != OK, Ref<Resource>(), "Cannot open file '" + p_path + "'.");
@@ -1415,6 +1530,9 @@ Ref<Resource> ResourceFormatLoaderText::load(const String &p_path, const String
 		*r_error = err;
 	}
 	if (err == OK) {
+		if (!binary_cache_path.is_empty()) {
+			_save_binary_cache(p_path, binary_cache_path, loader.get_resource());
+		}
 		return loader.get_resource();
 	} else {
 		return Ref<Resource>();
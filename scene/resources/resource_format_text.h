@@ -144,8 +144,25 @@ public:
 };
 
 class ResourceFormatLoaderText : public ResourceFormatLoader {
+	// Parsed text resources are cached in binary form in the project data folder,
+	// so loading them again when running from project files skips the text parser.
+	enum {
+		BINARY_CACHE_VERSION = 1,
+	};
+
+	bool binary_cache_enabled = false;
+
+	bool _can_use_binary_cache(const String &p_path) const;
+	String _get_binary_cache_path(const String &p_path) const;
+	bool _is_binary_cache_valid(const String &p_path, const String &p_cache_path) const;
+	void _save_binary_cache(const String &p_path, const String &p_cache_path, const Ref<Resource> &p_resource) const;
+	String _get_binary_cache_temp_path(const String &p_cache_path) const;
+	void _store_binary_cache_info(const String &p_path, const String &p_cache_path, uint64_t p_modified_time, const String &p_md5) const;
+
 public:
 	static ResourceFormatLoaderText *singleton;
+
+	void set_binary_cache_enabled(bool p_enabled) { binary_cache_enabled = p_enabled; }
 	virtual Ref<Resource> load(const String &p_path, const String &p_original_path = "", Error *r_error = nullptr, bool p_use_sub_threads = false, float *r_progress = nullptr, CacheMode p_cache_mode = CACHE_MODE_REUSE) override;
 	virtual void get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions) const override;
 	virtual void get_recognized_extensions(List<String> *p_extensions) const override;
@@ -0,0 +1,434 @@
+/**************************************************************************/
+/*  texture_atlas.cpp                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "texture_atlas.h"
+
+bool TextureAtlas::_allocate(const Size2i &p_size, Rect2i &r_allocation) {
+	if (p_size.width > size.width || p_size.height > size.height) {
+		return false;
+	}
+
+	// Pick the lowest shelf that fits, but don't waste much of a used shelf on a short image.
+	int best_shelf = -1;
+	int best_span = -1;
+	for (uint32_t i = 0; i < shelves.size(); i++) {
+		const Shelf &shelf = shelves[i];
+		if (shelf.height < p_size.height || (shelf.used > 0 && shelf.height * 2 > p_size.height * 3)) {
+			continue;
+		}
+		if (best_shelf != -1 && shelf.height >= shelves[best_shelf].height) {
+			continue;
+		}
+
+		int span = -1;
+		for (uint32_t j = 0; j < shelf.free_spans.size(); j++) {
+			if (shelf.free_spans[j].width >= p_size.width && (span == -1 || shelf.free_spans[j].width < shelf.free_spans[span].width)) {
+				span = j;
+			}
+		}
+		if (span != -1) {
+			best_shelf = i;
+			best_span = span;
+		}
+	}
+
+	if (best_shelf == -1) {
+		if (shelves_bottom + p_size.height > size.height) {
+			return false;
+		}
+		Shelf shelf;
+		shelf.y = shelves_bottom;
+		shelf.height = p_size.height;
+		shelf.free_spans.push_back({ 0, size.width });
+		shelves.push_back(shelf);
+		shelves_bottom += p_size.height;
+		best_shelf = shelves.size() - 1;
+		best_span = 0;
+	} else if (shelves[best_shelf].used == 0 && shelves[best_shelf].height > p_size.height) {
+		// Split an empty shelf, leaving the remainder available to other heights.
+		Shelf remainder;
+		remainder.y = shelves[best_shelf].y + p_size.height;
+		remainder.height = shelves[best_shelf].height - p_size.height;
+		remainder.free_spans.push_back({ 0, size.width });
+		shelves[best_shelf].height = p_size.height;
+		shelves.insert(best_shelf + 1, remainder);
+	}
+
+	Shelf &shelf = shelves[best_shelf];
+	Span &span = shelf.free_spans[best_span];
+	r_allocation = Rect2i(span.x, shelf.y, p_size.width, p_size.height);
+	span.x += p_size.width;
+	span.width -= p_size.width;
+	if (span.width == 0) {
+		shelf.free_spans.remove_at(best_span);
+	}
+	shelf.used++;
+	return true;
+}
+
+void TextureAtlas::_free(const Rect2i &p_allocation) {
+	for (uint32_t i = 0; i < shelves.size(); i++) {
+		Shelf &shelf = shelves[i];
+		if (shelf.y != p_allocation.position.y) {
+			continue;
+		}
+
+		// Keep spans sorted, merging with the neighbors they touch.
+		uint32_t idx = 0;
+		while (idx < shelf.free_spans.size() && shelf.free_spans[idx].x < p_allocation.position.x) {
+			idx++;
+		}
+		shelf.free_spans.insert(idx, { p_allocation.position.x, p_allocation.size.width });
+		if (idx + 1 < shelf.free_spans.size() && shelf.free_spans[idx].x + shelf.free_spans[idx].width == shelf.free_spans[idx + 1].x) {
+			shelf.free_spans[idx].width += shelf.free_spans[idx + 1].width;
+			shelf.free_spans.remove_at(idx + 1);
+		}
+		if (idx > 0 && shelf.free_spans[idx - 1].x + shelf.free_spans[idx - 1].width == shelf.free_spans[idx].x) {
+			shelf.free_spans[idx - 1].width += shelf.free_spans[idx].width;
+			shelf.free_spans.remove_at(idx);
+		}
+
+		shelf.used--;
+		if (shelf.used == 0) {
+			_merge_empty_shelves();
+		}
+		return;
+	}
+
+	ERR_FAIL_MSG("Allocation does not belong to any shelf.");
+}
+
+void TextureAtlas::_merge_empty_shelves() {
+	uint32_t i = 0;
+	while (i < shelves.size()) {
+		if (shelves[i].used > 0) {
+			i++;
+			continue;
+		}
+		shelves[i].free_spans.clear();
+		shelves[i].free_spans.push_back({ 0, size.width });
+		while (i + 1 < shelves.size() && shelves[i + 1].used == 0) {
+			shelves[i].height += shelves[i + 1].height;
+			shelves.remove_at(i + 1);
+		}
+		i++;
+	}
+
+	// Give the space of an empty last shelf back, so it can grow to any height.
+	if (!shelves.is_empty() && shelves[shelves.size() - 1].used == 0) {
+		shelves_bottom = shelves[shelves.size() - 1].y;
+		shelves.remove_at(shelves.size() - 1);
+	}
+}
+
+void TextureAtlas::_queue_update() {
+	if (update_queued) {
+		return;
+	}
+	update_queued = true;
+	callable_mp(this, &TextureAtlas::update_texture).call_deferred();
+}
+
+// The packed pixels are stored along with the entries and the shelves, so a loaded atlas
+// keeps its IDs and can still pack more images around the existing ones.
+void TextureAtlas::_set_data(const Dictionary &p_data) {
+	ERR_FAIL_COND(!p_data.has("image_data") || !p_data.has("entries") || !p_data.has("shelves") || !p_data.has("shelves_bottom") || !p_data.has("last_id"));
+
+	clear();
+
+	const Vector<uint8_t> image_data = p_data["image_data"];
+	if (!image_data.is_empty()) {
+		ERR_FAIL_COND_MSG(image_data.size() != Image::get_image_data_size(size.width, size.height, format, false), "TextureAtlas data doesn't match its size and format.");
+		image = Image::create_from_data(size.width, size.height, false, format, image_data);
+	} else {
+		image.unref();
+	}
+
+	// Each entry is: ID, region (x, y, width, height), allocation (x, y, width, height).
+	const Vector<int32_t> entry_data = p_data["entries"];
+	ERR_FAIL_COND(entry_data.size() % 9 != 0);
+	for (int i = 0; i < entry_data.size(); i += 9) {
+		Entry entry;
+		entry.region = Rect2i(entry_data[i + 1], entry_data[i + 2], entry_data[i + 3], entry_data[i + 4]);
+		entry.allocation = Rect2i(entry_data[i + 5], entry_data[i + 6], entry_data[i + 7], entry_data[i + 8]);
+		entries.insert(entry_data[i], entry);
+	}
+
+	// Each shelf is: y, height, used count, span count, then x and width of each free span.
+	const Vector<int32_t> shelf_data = p_data["shelves"];
+	int i = 0;
+	while (i < shelf_data.size()) {
+		ERR_FAIL_COND(i + 4 > shelf_data.size());
+		Shelf shelf;
+		shelf.y = shelf_data[i];
+		shelf.height = shelf_data[i + 1];
+		shelf.used = shelf_data[i + 2];
+		int span_count = shelf_data[i + 3];
+		i += 4;
+		ERR_FAIL_COND(span_count < 0 || i + span_count * 2 > shelf_data.size());
+		for (int j = 0; j < span_count; j++) {
+			shelf.free_spans.push_back({ shelf_data[i], shelf_data[i + 1] });
+			i += 2;
+		}
+		shelves.push_back(shelf);
+	}
+
+	shelves_bottom = p_data["shelves_bottom"];
+	last_id = p_data["last_id"];
+
+	if (texture.is_valid()) {
+		_queue_update();
+	}
+}
+
+Dictionary TextureAtlas::_get_data() const {
+	Dictionary d;
+	d["image_data"] = entries.is_empty() || image.is_null() ? Vector<uint8_t>() : image->get_data();
+
+	Vector<int32_t> entry_data;
+	for (const KeyValue<int, Entry> &E : entries) {
+		const Entry &entry = E.value;
+		entry_data.push_back(E.key);
+		entry_data.push_back(entry.region.position.x);
+		entry_data.push_back(entry.region.position.y);
+		entry_data.push_back(entry.region.size.width);
+		entry_data.push_back(entry.region.size.height);
+		entry_data.push_back(entry.allocation.position.x);
+		entry_data.push_back(entry.allocation.position.y);
+		entry_data.push_back(entry.allocation.size.width);
+		entry_data.push_back(entry.allocation.size.height);
+	}
+	d["entries"] = entry_data;
+
+	Vector<int32_t> shelf_data;
+	for (const Shelf &shelf : shelves) {
+		shelf_data.push_back(shelf.y);
+		shelf_data.push_back(shelf.height);
+		shelf_data.push_back(shelf.used);
+		shelf_data.push_back(shelf.free_spans.size());
+		for (const Span &span : shelf.free_spans) {
+			shelf_data.push_back(span.x);
+			shelf_data.push_back(span.width);
+		}
+	}
+	d["shelves"] = shelf_data;
+
+	d["shelves_bottom"] = shelves_bottom;
+	d["last_id"] = last_id;
+	return d;
+}
+
+void TextureAtlas::set_size(const Size2i &p_size) {
+	ERR_FAIL_COND_MSG(!entries.is_empty(), "Cannot change the size of a TextureAtlas that contains images.");
+	ERR_FAIL_COND(p_size.width <= 0 || p_size.height <= 0 || p_size.width > Image::MAX_WIDTH || p_size.height > Image::MAX_HEIGHT);
+	if (size == p_size) {
+		return;
+	}
+	size = p_size;
+	clear();
+	image.unref();
+	if (texture.is_valid()) {
+		texture->set_image(Image::create_empty(size.width, size.height, false, format));
+	}
+	emit_changed();
+}
+
+Size2i TextureAtlas::get_size() const {
+	return size;
+}
+
+void TextureAtlas::set_format(Image::Format p_format) {
+	ERR_FAIL_COND_MSG(!entries.is_empty(), "Cannot change the format of a TextureAtlas that contains images.");
+	ERR_FAIL_INDEX(p_format, Image::FORMAT_MAX);
+	ERR_FAIL_COND_MSG(Image::is_format_compressed(p_format), "TextureAtlas cannot use a compressed format.");
+	if (format == p_format) {
+		return;
+	}
+	format = p_format;
+	image.unref();
+	if (texture.is_valid()) {
+		texture->set_image(Image::create_empty(size.width, size.height, false, format));
+	}
+	emit_changed();
+}
+
+Image::Format TextureAtlas::get_format() const {
+	return format;
+}
+
+void TextureAtlas::set_padding(int p_padding) {
+	ERR_FAIL_COND_MSG(!entries.is_empty(), "Cannot change the padding of a TextureAtlas that contains images.");
+	ERR_FAIL_COND(p_padding < 0);
+	padding = p_padding;
+	emit_changed();
+}
+
+int TextureAtlas::get_padding() const {
+	return padding;
+}
+
+int TextureAtlas::add_image(const Ref<Image> &p_image) {
+	ERR_FAIL_COND_V(p_image.is_null() || p_image->is_empty(), -1);
+
+	const Size2i image_size = p_image->get_size();
+	Rect2i allocation;
+	if (!_allocate(image_size + Size2i(padding, padding) * 2, allocation)) {
+		return -1; // No space left.
+	}
+
+	if (image.is_null()) {
+		image = Image::create_empty(size.width, size.height, false, format);
+	}
+
+	Ref<Image> src = p_image;
+	if (src->is_compressed() || src->has_mipmaps() || src->get_format() != format) {
+		src = src->duplicate();
+		if (src->is_compressed()) {
+			src->decompress();
+		}
+		src->clear_mipmaps();
+		src->convert(format);
+	}
+
+	Entry entry;
+	entry.allocation = allocation;
+	entry.region = Rect2i(allocation.position + Point2i(padding, padding), image_size);
+	image->blit_rect(src, Rect2i(Point2i(), image_size), entry.region.position);
+
+	last_id++;
+	entries.insert(last_id, entry);
+	_queue_update();
+	return last_id;
+}
+
+void TextureAtlas::remove_image(int p_id) {
+	HashMap<int, Entry>::Iterator E = entries.find(p_id);
+	ERR_FAIL_COND_MSG(!E, vformat("No image with ID %d in the TextureAtlas.", p_id));
+
+	// Clear the pixels, so filtering doesn't bleed old content into images added later.
+	image->fill_rect(E->value.allocation, Color(0, 0, 0, 0));
+	_free(E->value.allocation);
+	entries.remove(E);
+	_queue_update();
+}
+
+bool TextureAtlas::has_image(int p_id) const {
+	return entries.has(p_id);
+}
+
+Rect2i TextureAtlas::get_image_region(int p_id) const {
+	const Entry *entry = entries.getptr(p_id);
+	ERR_FAIL_NULL_V_MSG(entry, Rect2i(), vformat("No image with ID %d in the TextureAtlas.", p_id));
+	return entry->region;
+}
+
+Ref<AtlasTexture> TextureAtlas::get_image_texture(int p_id) {
+	const Entry *entry = entries.getptr(p_id);
+	ERR_FAIL_NULL_V_MSG(entry, Ref<AtlasTexture>(), vformat("No image with ID %d in the TextureAtlas.", p_id));
+
+	Ref<AtlasTexture> atlas_texture;
+	atlas_texture.instantiate();
+	atlas_texture->set_atlas(get_texture());
+	atlas_texture->set_region(entry->region);
+	return atlas_texture;
+}
+
+int TextureAtlas::get_image_count() const {
+	return entries.size();
+}
+
+void TextureAtlas::clear() {
+	entries.clear();
+	shelves.clear();
+	shelves_bottom = 0;
+	if (image.is_valid()) {
+		image->fill(Color(0, 0, 0, 0));
+		_queue_update();
+	}
+}
+
+Ref<Image> TextureAtlas::get_image() const {
+	return image;
+}
+
+Ref<ImageTexture> TextureAtlas::get_texture() {
+	if (texture.is_null()) {
+		if (image.is_null()) {
+			image = Image::create_empty(size.width, size.height, false, format);
+		}
+		texture = ImageTexture::create_from_image(image);
+	}
+	return texture;
+}
+
+void TextureAtlas::update_texture() {
+	update_queued = false;
+	if (image.is_null()) {
+		return;
+	}
+
+	// All the images added or removed since the last update are uploaded at once.
+	if (texture.is_null()) {
+		texture = ImageTexture::create_from_image(image);
+	} else {
+		texture->update(image);
+	}
+}
+
+void TextureAtlas::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("_set_data", "data"), &TextureAtlas::_set_data);
+	ClassDB::bind_method(D_METHOD("_get_data"), &TextureAtlas::_get_data);
+
+	ClassDB::bind_method(D_METHOD("set_size", "size"), &TextureAtlas::set_size);
+	ClassDB::bind_method(D_METHOD("get_size"), &TextureAtlas::get_size);
+
+	ClassDB::bind_method(D_METHOD("set_format", "format"), &TextureAtlas::set_format);
+	ClassDB::bind_method(D_METHOD("get_format"), &TextureAtlas::get_format);
+
+	ClassDB::bind_method(D_METHOD("set_padding", "padding"), &TextureAtlas::set_padding);
+	ClassDB::bind_method(D_METHOD("get_padding"), &TextureAtlas::get_padding);
+
+	ClassDB::bind_method(D_METHOD("add_image", "image"), &TextureAtlas::add_image);
+	ClassDB::bind_method(D_METHOD("remove_image", "id"), &TextureAtlas::remove_image);
+	ClassDB::bind_method(D_METHOD("has_image", "id"), &TextureAtlas::has_image);
+	ClassDB::bind_method(D_METHOD("get_image_region", "id"), &TextureAtlas::get_image_region);
+	ClassDB::bind_method(D_METHOD("get_image_texture", "id"), &TextureAtlas::get_image_texture);
+	ClassDB::bind_method(D_METHOD("get_image_count"), &TextureAtlas::get_image_count);
+	ClassDB::bind_method(D_METHOD("clear"), &TextureAtlas::clear);
+
+	ClassDB::bind_method(D_METHOD("get_image"), &TextureAtlas::get_image);
+	ClassDB::bind_method(D_METHOD("get_texture"), &TextureAtlas::get_texture);
+	ClassDB::bind_method(D_METHOD("update_texture"), &TextureAtlas::update_texture);
+
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2I, "size", PROPERTY_HINT_NONE, "suffix:px"), "set_size", "get_size");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "format", PROPERTY_HINT_ENUM, "Lum8,LumAlpha8,Red8,RedGreen,RGB8,RGBA8,RGBA4444,RGBA5551,RFloat,RGFloat,RGBFloat,RGBAFloat,RHalf,RGHalf,RGBHalf,RGBAHalf,RGBE9995"), "set_format", "get_format");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "padding", PROPERTY_HINT_RANGE, "0,16,1,or_greater,suffix:px"), "set_padding", "get_padding");
+	ADD_PROPERTY(PropertyInfo(Variant::DICTIONARY, "data", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL), "_set_data", "_get_data");
+}
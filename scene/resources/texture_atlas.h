@@ -0,0 +1,109 @@
+/**************************************************************************/
+/*  texture_atlas.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEXTURE_ATLAS_H
+#define TEXTURE_ATLAS_H
+
+#include "core/io/image.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "scene/resources/atlas_texture.h"
+#include "scene/resources/image_texture.h"
+
+class TextureAtlas : public Resource {
+	GDCLASS(TextureAtlas, Resource);
+
+	// Images are packed in horizontal shelves stacked from the top. Each shelf keeps its
+	// free horizontal spans, so removed images leave space that later insertions reuse.
+	struct Span {
+		int x = 0;
+		int width = 0;
+	};
+
+	struct Shelf {
+		int y = 0;
+		int height = 0;
+		LocalVector<Span> free_spans;
+		int used = 0;
+	};
+
+	struct Entry {
+		Rect2i region;
+		Rect2i allocation;
+	};
+
+	Size2i size = Size2i(1024, 1024);
+	Image::Format format = Image::FORMAT_RGBA8;
+	int padding = 1;
+
+	LocalVector<Shelf> shelves;
+	int shelves_bottom = 0;
+	HashMap<int, Entry> entries;
+	int last_id = 0;
+
+	Ref<Image> image;
+	Ref<ImageTexture> texture;
+	bool update_queued = false;
+
+	bool _allocate(const Size2i &p_size, Rect2i &r_allocation);
+	void _free(const Rect2i &p_allocation);
+	void _merge_empty_shelves();
+	void _queue_update();
+
+	void _set_data(const Dictionary &p_data);
+	Dictionary _get_data() const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_size(const Size2i &p_size);
+	Size2i get_size() const;
+
+	void set_format(Image::Format p_format);
+	Image::Format get_format() const;
+
+	void set_padding(int p_padding);
+	int get_padding() const;
+
+	int add_image(const Ref<Image> &p_image);
+	void remove_image(int p_id);
+	bool has_image(int p_id) const;
+	Rect2i get_image_region(int p_id) const;
+	Ref<AtlasTexture> get_image_texture(int p_id);
+	int get_image_count() const;
+	void clear();
+
+	Ref<Image> get_image() const;
+	Ref<ImageTexture> get_texture();
+	void update_texture();
+};
+
+#endif // TEXTURE_ATLAS_H
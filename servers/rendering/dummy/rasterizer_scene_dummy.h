@@ -75,6 +75,16 @@ public:
 
 	PagedAllocator<GeometryInstanceDummy> geometry_instance_alloc;
 
+	// Scene buffers hold no textures, they only let the scene culler run its full pass.
+	class RenderSceneBuffersDummy : public RenderSceneBuffers {
+	public:
+		virtual void configure(const RenderSceneBuffersConfiguration *p_config) override {}
+
+		virtual void set_fsr_sharpness(float p_fsr_sharpness) override {}
+		virtual void set_texture_mipmap_bias(float p_texture_mipmap_bias) override {}
+		virtual void set_use_debanding(bool p_use_debanding) override {}
+	};
+
 public:
 	RenderGeometryInstance *geometry_instance_create(RID p_base) override {
 		RS::InstanceType type = RendererDummy::Utilities::get_singleton()->get_base_type(p_base);
@@ -158,7 +168,7 @@ public:
 	void set_time(double p_time, double p_step) override {}
 	void set_debug_draw_mode(RS::ViewportDebugDraw p_debug_draw) override {}
 
-	Ref<RenderSceneBuffers> render_buffers_create() override { return Ref<RenderSceneBuffers>(); }
+	Ref<RenderSceneBuffers> render_buffers_create() override { return memnew(RenderSceneBuffersDummy); }
 	void gi_set_use_half_resolution(bool p_enable) override {}
 
 	void screen_space_roughness_limiter_set_active(bool p_enable, float p_amount, float p_curve) override {}
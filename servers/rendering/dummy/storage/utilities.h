@@ -56,6 +56,8 @@ public:
 			return RS::INSTANCE_MESH;
 		} else if (RendererDummy::MeshStorage::get_singleton()->owns_multimesh(p_rid)) {
 			return RS::INSTANCE_MULTIMESH;
+		} else if (RendererDummy::LightStorage::get_singleton()->owns_light(p_rid)) {
+			return RS::INSTANCE_LIGHT;
 		} else if (RendererDummy::LightStorage::get_singleton()->owns_lightmap(p_rid)) {
 			return RS::INSTANCE_LIGHTMAP;
 		}
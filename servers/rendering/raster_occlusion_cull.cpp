@@ -0,0 +1,574 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "raster_occlusion_cull.h"
+
+#include "core/object/worker_thread_pool.h"
+
+RasterOcclusionCull *RasterOcclusionCull::raster_singleton = nullptr;
+
+void RasterOcclusionCull::RasterHZBuffer::clear() {
+	HZBuffer::clear();
+
+	tile_grid_size = Size2i();
+	tile_bins.clear();
+	triangles.clear();
+	instance_data.clear();
+}
+
+void RasterOcclusionCull::RasterHZBuffer::resize(const Size2i &p_size) {
+	if (p_size == Size2i()) {
+		clear();
+		return;
+	}
+
+	if (!sizes.is_empty() && p_size == sizes[0]) {
+		return; // Size didn't change
+	}
+
+	HZBuffer::resize(p_size);
+
+	tile_grid_size = Size2i((p_size.x + TILE_SIZE - 1) / TILE_SIZE, (p_size.y + TILE_SIZE - 1) / TILE_SIZE);
+	tile_bins.resize(tile_grid_size.x * tile_grid_size.y);
+}
+
+////////////////////////////////////////////////////////
+
+bool RasterOcclusionCull::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RasterOcclusionCull::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RasterOcclusionCull::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RasterOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+
+	for (const InstanceID &E : occluder->users) {
+		RID scenario_rid = E.scenario;
+		RID instance_rid = E.instance;
+		ERR_CONTINUE(!scenarios.has(scenario_rid));
+		Scenario &scenario = scenarios[scenario_rid];
+		ERR_CONTINUE(!scenario.instances.has(instance_rid));
+
+		if (!scenario.dirty_instances.has(instance_rid)) {
+			scenario.dirty_instances.insert(instance_rid);
+			scenario.dirty_instances_array.push_back(instance_rid);
+		}
+	}
+}
+
+void RasterOcclusionCull::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_scenario(RID p_scenario) {
+	ERR_FAIL_COND(scenarios.has(p_scenario));
+	scenarios[p_scenario] = Scenario();
+}
+
+void RasterOcclusionCull::remove_scenario(RID p_scenario) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	scenarios.erase(p_scenario);
+}
+
+void RasterOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (!scenario.instances.has(p_instance)) {
+		scenario.instances[p_instance] = OccluderInstance();
+	}
+
+	OccluderInstance &instance = scenario.instances[p_instance];
+
+	bool changed = false;
+
+	if (instance.removed) {
+		instance.removed = false;
+		scenario.removed_instances.erase(p_instance);
+		changed = true; // It was removed and re-added, we might have missed some changes
+	}
+
+	if (instance.occluder != p_occluder) {
+		Occluder *old_occluder = occluder_owner.get_or_null(instance.occluder);
+		if (old_occluder) {
+			old_occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		instance.occluder = p_occluder;
+
+		if (p_occluder.is_valid()) {
+			Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+			ERR_FAIL_NULL(occluder);
+			occluder->users.insert(InstanceID(p_scenario, p_instance));
+		}
+		changed = true;
+	}
+
+	if (instance.xform != p_xform) {
+		instance.xform = p_xform;
+		changed = true;
+	}
+
+	if (instance.enabled != p_enabled) {
+		instance.enabled = p_enabled;
+		scenario.dirty = true; // The active list needs a rebuild, but the instance doesn't need update
+	}
+
+	if (changed && !scenario.dirty_instances.has(p_instance)) {
+		scenario.dirty_instances.insert(p_instance);
+		scenario.dirty_instances_array.push_back(p_instance);
+		scenario.dirty = true;
+	}
+}
+
+void RasterOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (scenario.instances.has(p_instance)) {
+		OccluderInstance &instance = scenario.instances[p_instance];
+
+		if (!instance.removed) {
+			Occluder *occluder = occluder_owner.get_or_null(instance.occluder);
+			if (occluder) {
+				occluder->users.erase(InstanceID(p_scenario, p_instance));
+			}
+
+			scenario.removed_instances.push_back(p_instance);
+			instance.removed = true;
+		}
+	}
+}
+
+void RasterOcclusionCull::Scenario::_update_dirty_instance(uint32_t p_idx, RID *p_instances) {
+	OccluderInstance *occ_inst = instances.getptr(p_instances[p_idx]);
+
+	if (!occ_inst) {
+		return;
+	}
+
+	occ_inst->xformed_vertices.clear();
+	occ_inst->indices.clear();
+	occ_inst->aabb = AABB();
+
+	Occluder *occ = raster_singleton->occluder_owner.get_or_null(occ_inst->occluder);
+
+	if (!occ) {
+		return;
+	}
+
+	uint32_t vertex_count = occ->vertices.size();
+	occ_inst->xformed_vertices.resize(vertex_count);
+
+	const Vector3 *read_ptr = occ->vertices.ptr();
+	Vector3 *write_ptr = occ_inst->xformed_vertices.ptr();
+
+	for (uint32_t i = 0; i < vertex_count; i++) {
+		write_ptr[i] = occ_inst->xform.xform(read_ptr[i]);
+		if (i == 0) {
+			occ_inst->aabb.position = write_ptr[i];
+		} else {
+			occ_inst->aabb.expand_to(write_ptr[i]);
+		}
+	}
+
+	// Only keep complete triangles with valid indices, so the rasterizer doesn't need to check them every frame.
+	uint32_t index_count = occ->indices.size() - occ->indices.size() % 3;
+	const int32_t *indices = occ->indices.ptr();
+	occ_inst->indices.reserve(index_count);
+
+	for (uint32_t i = 0; i < index_count; i += 3) {
+		if (uint32_t(indices[i]) >= vertex_count || uint32_t(indices[i + 1]) >= vertex_count || uint32_t(indices[i + 2]) >= vertex_count) {
+			continue;
+		}
+		occ_inst->indices.push_back(indices[i]);
+		occ_inst->indices.push_back(indices[i + 1]);
+		occ_inst->indices.push_back(indices[i + 2]);
+	}
+}
+
+void RasterOcclusionCull::Scenario::update() {
+	if (!dirty && removed_instances.is_empty() && dirty_instances_array.is_empty()) {
+		return;
+	}
+
+	for (const RID &instance : removed_instances) {
+		instances.erase(instance);
+	}
+
+	if (dirty_instances_array.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &Scenario::_update_dirty_instance, dirty_instances_array.ptr(), dirty_instances_array.size(), -1, true, SNAME("RasterOcclusionCullUpdate"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (dirty_instances_array.size() == 1) {
+		_update_dirty_instance(0, dirty_instances_array.ptr());
+	}
+
+	dirty_instances.clear();
+	dirty_instances_array.clear();
+	removed_instances.clear();
+
+	active_instances.clear();
+	for (const KeyValue<RID, OccluderInstance> &E : instances) {
+		const OccluderInstance *occ_inst = &E.value;
+		if (!occ_inst->enabled || occ_inst->indices.is_empty() || !raster_singleton->occluder_owner.owns(occ_inst->occluder)) {
+			continue;
+		}
+		active_instances.push_back(occ_inst);
+	}
+
+	dirty = false;
+}
+
+////////////////////////////////////////////////////////
+
+// Projects a view space position into buffer pixel coordinates. Returns (x, y, view depth / w, 1 / w).
+static _FORCE_INLINE_ Vector4 _raster_project(const Vector3 &p_view, const Projection &p_projection, const Size2i &p_size) {
+	Vector4 clip = p_projection.xform(Vector4(p_view.x, p_view.y, p_view.z, 1.0));
+	float inv_w = 1.0f / clip.w;
+	return Vector4((clip.x * inv_w * 0.5f + 0.5f) * p_size.x, (clip.y * inv_w * 0.5f + 0.5f) * p_size.y, -p_view.z * inv_w, inv_w);
+}
+
+static _FORCE_INLINE_ void _raster_add_triangle(const Vector4 &p_v0, const Vector4 &p_v1, const Vector4 &p_v2, const Size2i &p_size, LocalVector<RasterOcclusionCull::RasterTriangle> &r_triangles) {
+	// Pixel centers are at integer + 0.5, only pixels whose center lies inside the triangle are covered.
+	int min_x = MAX(0, (int)Math::ceil(MIN(p_v0.x, MIN(p_v1.x, p_v2.x)) - 0.5f));
+	int min_y = MAX(0, (int)Math::ceil(MIN(p_v0.y, MIN(p_v1.y, p_v2.y)) - 0.5f));
+	int max_x = MIN(p_size.x - 1, (int)Math::floor(MAX(p_v0.x, MAX(p_v1.x, p_v2.x)) - 0.5f));
+	int max_y = MIN(p_size.y - 1, (int)Math::floor(MAX(p_v0.y, MAX(p_v1.y, p_v2.y)) - 0.5f));
+
+	if (min_x > max_x || min_y > max_y) {
+		return;
+	}
+
+	// Edge function of each edge, indexed by the opposite vertex.
+	float a[3] = { p_v1.y - p_v2.y, p_v2.y - p_v0.y, p_v0.y - p_v1.y };
+	float b[3] = { p_v2.x - p_v1.x, p_v0.x - p_v2.x, p_v1.x - p_v0.x };
+	float c[3] = { p_v1.x * p_v2.y - p_v1.y * p_v2.x, p_v2.x * p_v0.y - p_v2.y * p_v0.x, p_v0.x * p_v1.y - p_v0.y * p_v1.x };
+
+	float area = a[2] * p_v2.x + b[2] * p_v2.y + c[2];
+	if (Math::abs(area) < 1e-6f) {
+		return; // Degenerate.
+	}
+
+	// Occluders are double sided, flip edges so the inside is always positive.
+	if (area < 0.0f) {
+		for (int i = 0; i < 3; i++) {
+			a[i] = -a[i];
+			b[i] = -b[i];
+			c[i] = -c[i];
+		}
+		area = -area;
+	}
+
+	float inv_area = 1.0f / area;
+
+	RasterOcclusionCull::RasterTriangle t;
+	for (int i = 0; i < 3; i++) {
+		t.edge_a[i] = a[i];
+		t.edge_b[i] = b[i];
+		t.edge_c[i] = c[i];
+	}
+
+	t.depth_num[0] = (a[0] * p_v0.z + a[1] * p_v1.z + a[2] * p_v2.z) * inv_area;
+	t.depth_num[1] = (b[0] * p_v0.z + b[1] * p_v1.z + b[2] * p_v2.z) * inv_area;
+	t.depth_num[2] = (c[0] * p_v0.z + c[1] * p_v1.z + c[2] * p_v2.z) * inv_area;
+	t.depth_den[0] = (a[0] * p_v0.w + a[1] * p_v1.w + a[2] * p_v2.w) * inv_area;
+	t.depth_den[1] = (b[0] * p_v0.w + b[1] * p_v1.w + b[2] * p_v2.w) * inv_area;
+	t.depth_den[2] = (c[0] * p_v0.w + c[1] * p_v1.w + c[2] * p_v2.w) * inv_area;
+
+	t.min_x = min_x;
+	t.min_y = min_y;
+	t.max_x = max_x;
+	t.max_y = max_y;
+
+	r_triangles.push_back(t);
+}
+
+void RasterOcclusionCull::_setup_instance_triangles(uint32_t p_idx, const RasterizeThreadData *p_data) {
+	const OccluderInstance *occ_inst = p_data->scenario->active_instances[p_idx];
+	RasterHZBuffer::InstanceRasterData &raster_data = p_data->buffer->instance_data[p_idx];
+	raster_data.triangles.clear();
+
+	for (const Plane &plane : p_data->frustum_planes) {
+		if (plane.is_point_over(occ_inst->aabb.get_support(-plane.normal))) {
+			return; // Outside of the camera frustum.
+		}
+	}
+
+	const Size2i &size = p_data->buffer->sizes[0];
+	const float near_z = -p_data->z_near;
+
+	uint32_t vertex_count = occ_inst->xformed_vertices.size();
+	raster_data.view_vertices.resize(vertex_count);
+	raster_data.screen_vertices.resize(vertex_count);
+
+	const Vector3 *world = occ_inst->xformed_vertices.ptr();
+	Vector3 *view = raster_data.view_vertices.ptr();
+	Vector4 *screen = raster_data.screen_vertices.ptr();
+
+	for (uint32_t i = 0; i < vertex_count; i++) {
+		view[i] = p_data->cam_inv_transform.xform(world[i]);
+		if (view[i].z <= near_z) {
+			screen[i] = _raster_project(view[i], p_data->cam_projection, size);
+		}
+	}
+
+	const uint32_t *indices = occ_inst->indices.ptr();
+	uint32_t index_count = occ_inst->indices.size();
+
+	for (uint32_t i = 0; i < index_count; i += 3) {
+		const uint32_t idx[3] = { indices[i], indices[i + 1], indices[i + 2] };
+
+		uint32_t behind_mask = 0;
+		for (int j = 0; j < 3; j++) {
+			if (view[idx[j]].z > near_z) {
+				behind_mask |= 1 << j;
+			}
+		}
+
+		if (behind_mask == 0) {
+			_raster_add_triangle(screen[idx[0]], screen[idx[1]], screen[idx[2]], size, raster_data.triangles);
+			continue;
+		}
+
+		if (behind_mask == 7) {
+			continue;
+		}
+
+		// Clip against the near plane, this produces a triangle or a quad.
+		Vector4 clipped[4];
+		int clipped_count = 0;
+
+		for (int j = 0; j < 3; j++) {
+			int k = (j + 1) % 3;
+			const Vector3 &from = view[idx[j]];
+			const Vector3 &to = view[idx[k]];
+			bool from_in = !(behind_mask & (1 << j));
+			bool to_in = !(behind_mask & (1 << k));
+
+			if (from_in) {
+				clipped[clipped_count++] = screen[idx[j]];
+			}
+			if (from_in != to_in) {
+				float t = (near_z - from.z) / (to.z - from.z);
+				clipped[clipped_count++] = _raster_project(from.lerp(to, t), p_data->cam_projection, size);
+			}
+		}
+
+		for (int j = 2; j < clipped_count; j++) {
+			_raster_add_triangle(clipped[0], clipped[j - 1], clipped[j], size, raster_data.triangles);
+		}
+	}
+}
+
+void RasterOcclusionCull::_rasterize_tile(uint32_t p_tile, RasterHZBuffer *p_buffer) {
+	const int width = p_buffer->sizes[0].x;
+	const int tile_x = (p_tile % p_buffer->tile_grid_size.x) * TILE_SIZE;
+	const int tile_y = (p_tile / p_buffer->tile_grid_size.x) * TILE_SIZE;
+	const int tile_end_x = MIN(tile_x + TILE_SIZE, width) - 1;
+	const int tile_end_y = MIN(tile_y + TILE_SIZE, p_buffer->sizes[0].y) - 1;
+
+	float *depth = p_buffer->mips[0];
+
+	for (int y = tile_y; y <= tile_end_y; y++) {
+		float *row = &depth[y * width];
+		for (int x = tile_x; x <= tile_end_x; x++) {
+			row[x] = FLT_MAX;
+		}
+	}
+
+	const RasterTriangle *triangles = p_buffer->triangles.ptr();
+
+	for (const uint32_t tri_idx : p_buffer->tile_bins[p_tile]) {
+		const RasterTriangle &t = triangles[tri_idx];
+
+		const int from_x = MAX(tile_x, t.min_x);
+		const int to_x = MIN(tile_end_x, t.max_x);
+		const int from_y = MAX(tile_y, t.min_y);
+		const int to_y = MIN(tile_end_y, t.max_y);
+
+		for (int y = from_y; y <= to_y; y++) {
+			const float py = y + 0.5f;
+			const float e0 = t.edge_b[0] * py + t.edge_c[0];
+			const float e1 = t.edge_b[1] * py + t.edge_c[1];
+			const float e2 = t.edge_b[2] * py + t.edge_c[2];
+			const float num = t.depth_num[1] * py + t.depth_num[2];
+			const float den = t.depth_den[1] * py + t.depth_den[2];
+
+			float *row = &depth[y * width];
+
+			// Branchless inner loop, compilers turn this into SIMD code on every architecture.
+			for (int x = from_x; x <= to_x; x++) {
+				const float px = x + 0.5f;
+				const bool inside = (t.edge_a[0] * px + e0 >= 0.0f) & (t.edge_a[1] * px + e1 >= 0.0f) & (t.edge_a[2] * px + e2 >= 0.0f);
+				const float d = (t.depth_num[0] * px + num) / (t.depth_den[0] * px + den);
+				row[x] = (inside && d < row[x]) ? d : row[x];
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RasterOcclusionCull::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+void RasterOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RasterOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+void RasterOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	if (!buffers.has(p_buffer)) {
+		return;
+	}
+
+	RasterHZBuffer &buffer = buffers[p_buffer];
+
+	if (buffer.is_empty() || !scenarios.has(buffer.scenario_rid)) {
+		return;
+	}
+
+	Scenario &scenario = scenarios[buffer.scenario_rid];
+	scenario.update();
+
+	RasterizeThreadData td;
+	td.buffer = &buffer;
+	td.scenario = &scenario;
+	td.cam_inv_transform = p_cam_transform.affine_inverse();
+	td.cam_projection = _jitter_projection(p_cam_projection, buffer.get_occlusion_buffer_size());
+	td.frustum_planes = p_cam_projection.get_projection_planes(p_cam_transform);
+	td.z_near = p_cam_projection.get_z_near();
+
+	buffer.debug_tex_range = p_cam_projection.get_z_far();
+
+	// Transform, clip and set up the triangles of every visible occluder.
+	uint32_t instance_count = scenario.active_instances.size();
+	buffer.instance_data.resize(instance_count);
+
+	if (instance_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterOcclusionCull::_setup_instance_triangles, &td, instance_count, -1, true, SNAME("RasterOcclusionCullSetup"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (instance_count == 1) {
+		_setup_instance_triangles(0, &td);
+	}
+
+	// Gather the triangles and bin them into the screen tiles they overlap.
+	uint32_t triangle_count = 0;
+	for (const RasterHZBuffer::InstanceRasterData &E : buffer.instance_data) {
+		triangle_count += E.triangles.size();
+	}
+
+	buffer.triangles.resize(triangle_count);
+	for (LocalVector<uint32_t> &bin : buffer.tile_bins) {
+		bin.clear();
+	}
+
+	uint32_t offset = 0;
+	for (const RasterHZBuffer::InstanceRasterData &E : buffer.instance_data) {
+		if (E.triangles.is_empty()) {
+			continue;
+		}
+		memcpy(buffer.triangles.ptr() + offset, E.triangles.ptr(), E.triangles.size() * sizeof(RasterTriangle));
+		offset += E.triangles.size();
+	}
+
+	for (uint32_t i = 0; i < triangle_count; i++) {
+		const RasterTriangle &t = buffer.triangles[i];
+		int from_x = t.min_x / TILE_SIZE;
+		int to_x = t.max_x / TILE_SIZE;
+		int from_y = t.min_y / TILE_SIZE;
+		int to_y = t.max_y / TILE_SIZE;
+
+		for (int y = from_y; y <= to_y; y++) {
+			for (int x = from_x; x <= to_x; x++) {
+				buffer.tile_bins[y * buffer.tile_grid_size.x + x].push_back(i);
+			}
+		}
+	}
+
+	// Tiles own disjoint pixel ranges, so they can be rasterized in parallel without synchronization.
+	uint32_t tile_count = buffer.tile_bins.size();
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterOcclusionCull::_rasterize_tile, &buffer, tile_count, -1, true, SNAME("RasterOcclusionCullRasterize"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	buffer.update_mips();
+}
+
+RasterOcclusionCull::HZBuffer *RasterOcclusionCull::buffer_get_ptr(RID p_buffer) {
+	if (!buffers.has(p_buffer)) {
+		return nullptr;
+	}
+	return &buffers[p_buffer];
+}
+
+RID RasterOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
+
+////////////////////////////////////////////////////////
+
+RasterOcclusionCull::RasterOcclusionCull() {
+	raster_singleton = this;
+}
+
+RasterOcclusionCull::~RasterOcclusionCull() {
+	raster_singleton = nullptr;
+}
@@ -0,0 +1,182 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef RASTER_OCCLUSION_CULL_H
+#define RASTER_OCCLUSION_CULL_H
+
+#include "core/math/aabb.h"
+#include "core/math/vector4.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rid_owner.h"
+#include "servers/rendering/renderer_scene_occlusion_cull.h"
+
+// Portable occlusion culling backend. Occluder meshes are rasterized on the CPU
+// into a tiled depth buffer, which is then reduced into the hierarchical
+// depth buffer used for culling. Unlike the Embree based raycaster, it has no
+// third-party dependencies and works on every platform.
+class RasterOcclusionCull : public RendererSceneOcclusionCull {
+public:
+	static const int TILE_SIZE = 16;
+
+	// Screen space triangle ready for rasterization. Edge functions and
+	// depth planes are evaluated at pixel centers, depth is recovered as
+	// depth_num / depth_den so perspective and orthogonal cameras share the
+	// same code path.
+	struct RasterTriangle {
+		float edge_a[3];
+		float edge_b[3];
+		float edge_c[3];
+		float depth_num[3]; // Plane coefficients (x, y, constant) of view depth / w.
+		float depth_den[3]; // Plane coefficients (x, y, constant) of 1 / w.
+		int min_x, min_y, max_x, max_y;
+	};
+
+	class RasterHZBuffer : public HZBuffer {
+		friend class RasterOcclusionCull;
+
+		struct InstanceRasterData {
+			LocalVector<Vector3> view_vertices;
+			LocalVector<Vector4> screen_vertices;
+			LocalVector<RasterTriangle> triangles;
+		};
+
+		Size2i tile_grid_size;
+		LocalVector<InstanceRasterData> instance_data;
+		LocalVector<RasterTriangle> triangles;
+		LocalVector<LocalVector<uint32_t>> tile_bins;
+
+	public:
+		RID scenario_rid;
+
+		virtual void clear() override;
+		virtual void resize(const Size2i &p_size) override;
+
+		uint32_t get_triangle_count() const { return triangles.size(); }
+		const float *get_depth_buffer() const { return is_empty() ? nullptr : mips[0]; }
+	};
+
+private:
+	struct InstanceID {
+		RID scenario;
+		RID instance;
+
+		static uint32_t hash(const InstanceID &p_ins) {
+			uint32_t h = hash_murmur3_one_64(p_ins.scenario.get_id());
+			return hash_fmix32(hash_murmur3_one_64(p_ins.instance.get_id(), h));
+		}
+		bool operator==(const InstanceID &rhs) const {
+			return instance == rhs.instance && rhs.scenario == scenario;
+		}
+
+		InstanceID() {}
+		InstanceID(RID s, RID i) :
+				scenario(s), instance(i) {}
+	};
+
+	struct Occluder {
+		PackedVector3Array vertices;
+		PackedInt32Array indices;
+		HashSet<InstanceID, InstanceID> users;
+	};
+
+	struct OccluderInstance {
+		RID occluder;
+		LocalVector<uint32_t> indices;
+		LocalVector<Vector3> xformed_vertices;
+		AABB aabb;
+		Transform3D xform;
+		bool enabled = true;
+		bool removed = false;
+	};
+
+	struct Scenario {
+		bool dirty = false;
+
+		HashMap<RID, OccluderInstance> instances;
+		HashSet<RID> dirty_instances; // To avoid duplicates
+		LocalVector<RID> dirty_instances_array; // To iterate and split into threads
+		LocalVector<RID> removed_instances;
+
+		// Enabled instances with geometry, rebuilt when the scenario is dirty.
+		LocalVector<const OccluderInstance *> active_instances;
+
+		void _update_dirty_instance(uint32_t p_idx, RID *p_instances);
+		void update();
+	};
+
+	struct RasterizeThreadData {
+		RasterHZBuffer *buffer = nullptr;
+		const Scenario *scenario = nullptr;
+		Transform3D cam_inv_transform;
+		Projection cam_projection;
+		Vector<Plane> frustum_planes;
+		float z_near = 0.0f;
+	};
+
+	static RasterOcclusionCull *raster_singleton;
+
+	RID_PtrOwner<Occluder> occluder_owner;
+	HashMap<RID, Scenario> scenarios;
+	HashMap<RID, RasterHZBuffer> buffers;
+
+	void _setup_instance_triangles(uint32_t p_idx, const RasterizeThreadData *p_data);
+	void _rasterize_tile(uint32_t p_tile, RasterHZBuffer *p_buffer);
+
+public:
+	// Always created by RendererSceneCull, even when another backend is the active singleton.
+	static RasterOcclusionCull *get_raster_singleton() { return raster_singleton; }
+
+	virtual bool is_occluder(RID p_rid) override;
+	virtual RID occluder_allocate() override;
+	virtual void occluder_initialize(RID p_occluder) override;
+	virtual void occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) override;
+	virtual void free_occluder(RID p_occluder) override;
+
+	virtual void add_scenario(RID p_scenario) override;
+	virtual void remove_scenario(RID p_scenario) override;
+	virtual void scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) override;
+	virtual void scenario_remove_instance(RID p_scenario, RID p_instance) override;
+
+	virtual void add_buffer(RID p_buffer) override;
+	virtual void remove_buffer(RID p_buffer) override;
+	virtual HZBuffer *buffer_get_ptr(RID p_buffer) override;
+	virtual void buffer_set_scenario(RID p_buffer, RID p_scenario) override;
+	virtual void buffer_set_size(RID p_buffer, const Vector2i &p_size) override;
+	virtual void buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) override;
+
+	virtual RID buffer_get_debug_texture(RID p_buffer) override;
+
+	RasterOcclusionCull();
+	~RasterOcclusionCull();
+};
+
+#endif // RASTER_OCCLUSION_CULL_H
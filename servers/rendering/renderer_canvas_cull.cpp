@@ -50,8 +50,25 @@ void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas
 	memset(z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
 	memset(z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
 
-	for (int i = 0; i < p_child_item_count; i++) {
-		_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, false, p_canvas_cull_mask, Point2(), 1, nullptr);
+	if ((uint32_t)p_child_item_count >= threaded_cull_minimum_items) {
+		LocalVector<Item *> items;
+		items.resize(p_child_item_count);
+		for (int i = 0; i < p_child_item_count; i++) {
+			items[i] = p_child_items[i].item;
+		}
+
+		CullChildrenData data;
+		data.items = items.ptr();
+		data.item_count = items.size();
+		data.xform = p_transform;
+		data.clip_rect = p_clip_rect;
+		data.modulate = Color(1, 1, 1, 1);
+		data.canvas_cull_mask = p_canvas_cull_mask;
+		_cull_canvas_children(data, z_list, z_last_list);
+	} else {
+		for (int i = 0; i < p_child_item_count; i++) {
+			_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, false, p_canvas_cull_mask, Point2(), 1, nullptr);
+		}
 	}
 
 	RendererCanvasRender::Item *list = nullptr;
@@ -70,6 +87,12 @@ void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas
 		}
 	}
 
+	// Lights are selected per item by the renderer, so only merge items when no light can be affected by the merged bounds.
+	if (merge_items_enabled && !debug_redraw && p_lights == nullptr && p_directional_lights == nullptr) {
+		RENDER_TIMESTAMP("Merge CanvasItems");
+		list = _merge_canvas_items(list);
+	}
+
 	RENDER_TIMESTAMP("Render CanvasItems");
 
 	bool sdf_flag;
@@ -79,53 +102,343 @@ void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas
 	}
 }
 
+bool RendererCanvasCull::_is_item_mergeable(const Item *p_item, RID &r_texture) const {
+	if (p_item->copy_back_buffer || p_item->use_canvas_group || p_item->canvas_group_owner || p_item->vp_render || p_item->repeat_source_item || p_item->skeleton.is_valid()) {
+		return false;
+	}
+
+	RID material = p_item->material_owner ? p_item->material_owner->material : p_item->material;
+	if (material.is_valid()) {
+		// Materials can read the model matrix or instance uniforms of each item.
+		return false;
+	}
+
+	bool has_draw_command = false;
+	for (const RendererCanvasRender::Item::Command *c = p_item->commands; c; c = c->next) {
+		RID texture;
+		switch (c->type) {
+			case Item::Command::TYPE_RECT: {
+				texture = static_cast<const Item::CommandRect *>(c)->texture;
+			} break;
+			case Item::Command::TYPE_NINEPATCH: {
+				texture = static_cast<const Item::CommandNinePatch *>(c)->texture;
+			} break;
+			case Item::Command::TYPE_PRIMITIVE: {
+				texture = static_cast<const Item::CommandPrimitive *>(c)->texture;
+			} break;
+			case Item::Command::TYPE_TRANSFORM: {
+				continue;
+			}
+			default: {
+				// Polygons and meshes reference shared buffers, and clip ignore or animation slices change the state of the whole item.
+				return false;
+			}
+		}
+
+		if (!has_draw_command) {
+			r_texture = texture;
+			has_draw_command = true;
+		} else if (texture != r_texture) {
+			return false;
+		}
+	}
+
+	return has_draw_command;
+}
+
+template <typename T>
+static T *_copy_canvas_item_command(RendererCanvasRender::Item *p_item, const RendererCanvasRender::Item::Command *p_command) {
+	T *command = p_item->alloc_command<T>();
+	*command = *static_cast<const T *>(p_command);
+	command->next = nullptr;
+	return command;
+}
+
+uint32_t RendererCanvasCull::_get_merge_run_state(const LocalVector<Item *> &p_run) {
+	uint32_t h = hash_murmur3_one_32(p_run.size());
+	for (const Item *item : p_run) {
+		h = hash_murmur3_one_64(hash_make_uint64_t(item), h);
+		h = hash_murmur3_one_64(item->command_version, h);
+		for (int i = 0; i < 3; i++) {
+			h = hash_murmur3_one_real(item->final_transform.columns[i].x, h);
+			h = hash_murmur3_one_real(item->final_transform.columns[i].y, h);
+		}
+		for (int i = 0; i < 4; i++) {
+			h = hash_murmur3_one_float(item->final_modulate.components[i], h);
+		}
+	}
+	return hash_fmix32(h);
+}
+
+RendererCanvasRender::Item *RendererCanvasCull::_get_merged_item(const LocalVector<Item *> &p_run) {
+	MergedItem &merged = merged_items[p_run[0]];
+	merged.last_used_frame = merge_frame;
+
+	uint32_t state = _get_merge_run_state(p_run);
+	if (merged.drawn_frame == merge_frame && merged.drawn_state != state) {
+		merged.conflict_frame = merge_frame;
+	}
+	merged.drawn_frame = merge_frame;
+	merged.drawn_state = state;
+	if (merged.conflict_frame != UINT64_MAX && merge_frame <= merged.conflict_frame + 1) {
+		// Still drawn with different states in the current or previous frame.
+		return nullptr;
+	}
+
+	if (!merged.item) {
+		merged.item = memnew(RendererCanvasRender::Item);
+	}
+	RendererCanvasRender::Item *merged_item = merged.item;
+
+	bool valid = merged.sources.size() == p_run.size();
+	for (uint32_t i = 0; valid && i < p_run.size(); i++) {
+		const MergedItem::Source &source = merged.sources[i];
+		const Item *item = p_run[i];
+		valid = source.item == item && source.command_version == item->command_version && source.transform == item->final_transform && source.modulate == item->final_modulate;
+	}
+
+	if (!valid) {
+		// Bake the transform and modulate of each source into a copy of its commands.
+		merged_item->clear();
+		merged.sources.resize(p_run.size());
+
+		for (uint32_t i = 0; i < p_run.size(); i++) {
+			Item *item = p_run[i];
+			MergedItem::Source &source = merged.sources[i];
+			source.item = item;
+			source.command_version = item->command_version;
+			source.transform = item->final_transform;
+			source.modulate = item->final_modulate;
+
+			Item::CommandTransform *item_xform = merged_item->alloc_command<Item::CommandTransform>();
+			item_xform->xform = item->final_transform;
+
+			for (const RendererCanvasRender::Item::Command *c = item->commands; c; c = c->next) {
+				switch (c->type) {
+					case Item::Command::TYPE_RECT: {
+						Item::CommandRect *rect = _copy_canvas_item_command<Item::CommandRect>(merged_item, c);
+						rect->modulate *= item->final_modulate;
+					} break;
+					case Item::Command::TYPE_NINEPATCH: {
+						Item::CommandNinePatch *np = _copy_canvas_item_command<Item::CommandNinePatch>(merged_item, c);
+						np->color *= item->final_modulate;
+					} break;
+					case Item::Command::TYPE_PRIMITIVE: {
+						Item::CommandPrimitive *primitive = _copy_canvas_item_command<Item::CommandPrimitive>(merged_item, c);
+						for (uint32_t j = 0; j < primitive->point_count; j++) {
+							primitive->colors[j] *= item->final_modulate;
+						}
+					} break;
+					case Item::Command::TYPE_TRANSFORM: {
+						Item::CommandTransform *xform = merged_item->alloc_command<Item::CommandTransform>();
+						xform->xform = item->final_transform * static_cast<const Item::CommandTransform *>(c)->xform;
+					} break;
+					default: {
+						// Other commands are rejected by _is_item_mergeable().
+					} break;
+				}
+			}
+		}
+	}
+
+	// State that is not baked into the commands is taken from the first item every frame.
+	const Item *first = p_run[0];
+	merged_item->final_transform = Transform2D();
+	merged_item->final_modulate = Color(1, 1, 1, 1);
+	merged_item->final_clip_owner = first->final_clip_owner;
+	merged_item->texture_filter = first->texture_filter;
+	merged_item->texture_repeat = first->texture_repeat;
+	merged_item->light_mask = first->light_mask;
+	merged_item->z_final = first->z_final;
+	merged_item->global_rect_cache = first->global_rect_cache;
+	for (uint32_t i = 1; i < p_run.size(); i++) {
+		merged_item->global_rect_cache = merged_item->global_rect_cache.merge(p_run[i]->global_rect_cache);
+	}
+	merged_item->custom_rect = true;
+	merged_item->rect = merged_item->global_rect_cache;
+	merged_item->next = nullptr;
+
+	merged_batch_count++;
+	merged_item_count += p_run.size();
+
+	return merged_item;
+}
+
+RendererCanvasRender::Item *RendererCanvasCull::_merge_canvas_items(RendererCanvasRender::Item *p_list) {
+	uint64_t frame = RSG::rasterizer->get_frame_number();
+	if (frame != merge_frame) {
+		// Free the runs that were not drawn in the previous frame.
+		LocalVector<Item *> unused;
+		for (const KeyValue<Item *, MergedItem> &E : merged_items) {
+			if (E.value.last_used_frame + 1 < frame) {
+				unused.push_back(E.key);
+			}
+		}
+		for (Item *key : unused) {
+			if (merged_items[key].item) {
+				memdelete(merged_items[key].item);
+			}
+			merged_items.erase(key);
+		}
+
+		merge_frame = frame;
+		merged_batch_count = 0;
+		merged_item_count = 0;
+	}
+
+	RendererCanvasRender::Item *list = nullptr;
+	RendererCanvasRender::Item *list_end = nullptr;
+
+	RendererCanvasRender::Item *ci = p_list;
+	while (ci) {
+		// Every item in the list comes from _cull_canvas_item().
+		Item *item = static_cast<Item *>(ci);
+		RendererCanvasRender::Item *next = ci->next;
+		RendererCanvasRender::Item *append = ci;
+		RendererCanvasRender::Item *append_end = ci;
+
+		RID texture;
+		if (_is_item_mergeable(item, texture)) {
+			merge_run.clear();
+			merge_run.push_back(item);
+
+			while (next && merge_run.size() < MERGE_MAX_ITEMS) {
+				Item *next_item = static_cast<Item *>(next);
+				RID next_texture;
+				if (!_is_item_mergeable(next_item, next_texture) || next_texture != texture || next_item->final_clip_owner != item->final_clip_owner || next_item->texture_filter != item->texture_filter || next_item->texture_repeat != item->texture_repeat) {
+					break;
+				}
+				merge_run.push_back(next_item);
+				next = next->next;
+			}
+
+			if (merge_run.size() > 1) {
+				RendererCanvasRender::Item *merged_item = _get_merged_item(merge_run);
+				if (merged_item) {
+					append = merged_item;
+					append_end = merged_item;
+				} else {
+					// Keep the whole run as is, the items are still linked in order.
+					append_end = merge_run[merge_run.size() - 1];
+				}
+			}
+		}
+
+		if (list_end) {
+			list_end->next = append;
+		} else {
+			list = append;
+		}
+		list_end = append_end;
+		list_end->next = nullptr;
+
+		ci = next;
+	}
+
+	return list;
+}
+
+void RendererCanvasCull::_collect_ysort_child(RendererCanvasCull::Item *p_canvas_item, RendererCanvasCull::Item *p_child, RendererCanvasCull::Item *p_material_owner, const Color &p_modulate, RendererCanvasCull::Item **r_items, int &r_index, int p_z) {
+	// To y-sort according to the item's final position, physics interpolation
+	// and transform snapping need to be applied before y-sorting.
+	Transform2D child_xform;
+	if (!_interpolation_data.interpolation_enabled || !p_child->interpolated) {
+		child_xform = p_child->xform_curr;
+	} else {
+		real_t f = Engine::get_singleton()->get_physics_interpolation_fraction();
+		TransformInterpolator::interpolate_transform_2d(p_child->xform_prev, p_child->xform_curr, child_xform, f);
+	}
+
+	if (snapping_2d_transforms_to_pixel) {
+		child_xform.columns[2] = (child_xform.columns[2] + Point2(0.5, 0.5)).floor();
+	}
+
+	r_items[r_index] = p_child;
+	p_child->ysort_xform = p_canvas_item->ysort_xform * child_xform;
+	p_child->material_owner = p_child->use_parent_material ? p_material_owner : nullptr;
+	p_child->ysort_modulate = p_modulate;
+	p_child->ysort_index = r_index;
+	p_child->ysort_parent_abs_z_index = p_z;
+
+	if (!p_child->repeat_source) {
+		p_child->repeat_size = p_canvas_item->repeat_size;
+		p_child->repeat_times = p_canvas_item->repeat_times;
+		p_child->repeat_source_item = p_canvas_item->repeat_source_item;
+	}
+
+	// Y sorted canvas items are flattened into r_items. Calculate their absolute z index to use when rendering r_items.
+	int abs_z = 0;
+	if (p_child->z_relative) {
+		abs_z = CLAMP(p_z + p_child->z_index, RS::CANVAS_ITEM_Z_MIN, RS::CANVAS_ITEM_Z_MAX);
+	} else {
+		abs_z = p_child->z_index;
+	}
+
+	r_index++;
+
+	if (p_child->sort_y) {
+		_collect_ysort_children(p_child, p_child->use_parent_material ? p_material_owner : p_child, p_modulate * p_child->modulate, r_items, r_index, abs_z);
+	}
+}
+
 void RendererCanvasCull::_collect_ysort_children(RendererCanvasCull::Item *p_canvas_item, RendererCanvasCull::Item *p_material_owner, const Color &p_modulate, RendererCanvasCull::Item **r_items, int &r_index, int p_z) {
 	int child_item_count = p_canvas_item->child_items.size();
 	RendererCanvasCull::Item **child_items = p_canvas_item->child_items.ptrw();
 	for (int i = 0; i < child_item_count; i++) {
 		if (child_items[i]->visible) {
-			// To y-sort according to the item's final position, physics interpolation
-			// and transform snapping need to be applied before y-sorting.
-			Transform2D child_xform;
-			if (!_interpolation_data.interpolation_enabled || !child_items[i]->interpolated) {
-				child_xform = child_items[i]->xform_curr;
-			} else {
-				real_t f = Engine::get_singleton()->get_physics_interpolation_fraction();
-				TransformInterpolator::interpolate_transform_2d(child_items[i]->xform_prev, child_items[i]->xform_curr, child_xform, f);
-			}
+			_collect_ysort_child(p_canvas_item, child_items[i], p_material_owner, p_modulate, r_items, r_index, p_z);
+		}
+	}
+}
 
-			if (snapping_2d_transforms_to_pixel) {
-				child_xform.columns[2] = (child_xform.columns[2] + Point2(0.5, 0.5)).floor();
-			}
+void RendererCanvasCull::_collect_ysort_children_threaded(uint32_t p_task, YSortData *p_data) {
+	uint32_t task_count = cull_tasks.size();
+	uint32_t child_count = p_data->child_offsets.size();
+	uint32_t from = p_task * child_count / task_count;
+	uint32_t to = (p_task + 1 == task_count) ? child_count : ((p_task + 1) * child_count / task_count);
 
-			r_items[r_index] = child_items[i];
-			child_items[i]->ysort_xform = p_canvas_item->ysort_xform * child_xform;
-			child_items[i]->material_owner = child_items[i]->use_parent_material ? p_material_owner : nullptr;
-			child_items[i]->ysort_modulate = p_modulate;
-			child_items[i]->ysort_index = r_index;
-			child_items[i]->ysort_parent_abs_z_index = p_z;
-
-			if (!child_items[i]->repeat_source) {
-				child_items[i]->repeat_size = p_canvas_item->repeat_size;
-				child_items[i]->repeat_times = p_canvas_item->repeat_times;
-				child_items[i]->repeat_source_item = p_canvas_item->repeat_source_item;
-			}
+	for (uint32_t i = from; i < to; i++) {
+		int index = p_data->child_offsets[i];
+		if (index >= 0) {
+			_collect_ysort_child(p_data->canvas_item, p_data->child_items[i], p_data->material_owner, Color(1, 1, 1, 1), p_data->items.ptr(), index, p_data->z);
+		}
+	}
+}
 
-			// Y sorted canvas items are flattened into r_items. Calculate their absolute z index to use when rendering r_items.
-			int abs_z = 0;
-			if (child_items[i]->z_relative) {
-				abs_z = CLAMP(p_z + child_items[i]->z_index, RS::CANVAS_ITEM_Z_MIN, RS::CANVAS_ITEM_Z_MAX);
-			} else {
-				abs_z = child_items[i]->z_index;
-			}
+void RendererCanvasCull::_sort_ysort_items_threaded(uint32_t p_run, YSortData *p_data) {
+	uint32_t from = p_run * p_data->sort_run_size;
+	uint32_t to = MIN(from + p_data->sort_run_size, p_data->items.size());
 
-			r_index++;
+	SortArray<Item *, ItemYSort> sorter;
+	sorter.sort(p_data->items.ptr() + from, to - from);
+}
 
-			if (child_items[i]->sort_y) {
-				_collect_ysort_children(child_items[i], child_items[i]->use_parent_material ? p_material_owner : child_items[i], p_modulate * child_items[i]->modulate, r_items, r_index, abs_z);
-			}
+void RendererCanvasCull::_merge_ysort_items_threaded(uint32_t p_pair, YSortData *p_data) {
+	uint32_t count = p_data->items.size();
+	uint32_t from = p_pair * 2 * p_data->sort_run_size;
+	uint32_t middle = MIN(from + p_data->sort_run_size, count);
+	uint32_t to = MIN(middle + p_data->sort_run_size, count);
+
+	Item **src = p_data->sort_from;
+	Item **dst = p_data->sort_to;
+	ItemYSort compare;
+
+	uint32_t left = from;
+	uint32_t right = middle;
+	uint32_t i = from;
+	while (left < middle && right < to) {
+		if (compare(src[right], src[left])) {
+			dst[i++] = src[right++];
+		} else {
+			dst[i++] = src[left++];
 		}
 	}
+	while (left < middle) {
+		dst[i++] = src[left++];
+	}
+	while (right < to) {
+		dst[i++] = src[right++];
+	}
 }
 
 int RendererCanvasCull::_count_ysort_children(RendererCanvasCull::Item *p_canvas_item) {
@@ -150,7 +463,7 @@ void RendererCanvasCull::_mark_ysort_dirty(RendererCanvasCull::Item *ysort_owner
 	} while (ysort_owner && ysort_owner->sort_y);
 }
 
-void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *ci, RendererCanvasCull::Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &p_modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from) {
+void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *ci, RendererCanvasCull::Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &p_modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from, CullTask *p_task) {
 	if (ci->copy_back_buffer) {
 		ci->copy_back_buffer->screen_rect = p_transform.xform(ci->copy_back_buffer->rect).intersection(p_clip_rect);
 	}
@@ -222,7 +535,11 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 		//something to draw?
 
 		if (ci->update_when_visible) {
-			RenderingServerDefault::redraw_request();
+			if (p_task) {
+				p_task->redraw_requested = true;
+			} else {
+				RenderingServerDefault::redraw_request();
+			}
 		}
 
 		if (ci->commands != nullptr || ci->copy_back_buffer) {
@@ -233,6 +550,10 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 			ci->light_masked = false;
 
 			int zidx = p_z - RS::CANVAS_ITEM_Z_MIN;
+			if (p_task) {
+				p_task->z_min = MIN(p_task->z_min, zidx);
+				p_task->z_max = MAX(p_task->z_max, zidx);
+			}
 
 			if (r_z_last_list[zidx]) {
 				r_z_last_list[zidx]->next = ci;
@@ -249,7 +570,10 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 		}
 
 		if (ci->visibility_notifier) {
-			if (!ci->visibility_notifier->visible_element.in_list()) {
+			if (p_task) {
+				// The list is shared, so it's filled in once the task finishes.
+				p_task->visible_notifiers.push_back(ci);
+			} else if (!ci->visibility_notifier->visible_element.in_list()) {
 				visibility_notifier_list.add(&ci->visibility_notifier->visible_element);
 				ci->visibility_notifier->just_visible = true;
 			}
@@ -262,7 +586,7 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 	}
 }
 
-void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2D &p_parent_xform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, Item *p_canvas_clip, Item *p_material_owner, bool p_is_already_y_sorted, uint32_t p_canvas_cull_mask, const Point2 &p_repeat_size, int p_repeat_times, RendererCanvasRender::Item *p_repeat_source_item) {
+void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2D &p_parent_xform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, Item *p_canvas_clip, Item *p_material_owner, bool p_is_already_y_sorted, uint32_t p_canvas_cull_mask, const Point2 &p_repeat_size, int p_repeat_times, RendererCanvasRender::Item *p_repeat_source_item, CullTask *p_task) {
 	Item *ci = p_canvas_item;
 
 	if (!ci->visible) {
@@ -278,7 +602,8 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 		ci->children_order_dirty = false;
 	}
 
-	Rect2 rect = ci->get_rect();
+	// Rects that come from storage were resolved before the task started.
+	Rect2 rect = (p_task && ci->rect_from_storage) ? ci->rect : ci->get_rect();
 
 	if (ci->visibility_notifier) {
 		if (ci->visibility_notifier->area.size != Vector2()) {
@@ -394,12 +719,18 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			}
 
 			child_item_count = ci->ysort_children_count + 1;
-			child_items = (Item **)alloca(child_item_count * sizeof(Item *));
 
 			ci->ysort_xform = Transform2D();
 			ci->ysort_modulate = Color(1, 1, 1, 1);
 			ci->ysort_index = 0;
 			ci->ysort_parent_abs_z_index = parent_z;
+
+			if (p_task == nullptr && (uint32_t)child_item_count >= threaded_cull_minimum_items) {
+				_cull_ysort_children(ci, final_xform, p_clip_rect, modulate, p_z, r_z_list, r_z_last_list, p_material_owner, p_canvas_cull_mask);
+				return;
+			}
+
+			child_items = (Item **)alloca(child_item_count * sizeof(Item *));
 			child_items[0] = ci;
 			int i = 1;
 			_collect_ysort_children(ci, p_material_owner, Color(1, 1, 1, 1), child_items, i, p_z);
@@ -408,7 +739,7 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			sorter.sort(child_items, child_item_count);
 
 			for (i = 0; i < child_item_count; i++) {
-				_cull_canvas_item(child_items[i], final_xform * child_items[i]->ysort_xform, p_clip_rect, modulate * child_items[i]->ysort_modulate, child_items[i]->ysort_parent_abs_z_index, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner, true, p_canvas_cull_mask, child_items[i]->repeat_size, child_items[i]->repeat_times, child_items[i]->repeat_source_item);
+				_cull_canvas_item(child_items[i], final_xform * child_items[i]->ysort_xform, p_clip_rect, modulate * child_items[i]->ysort_modulate, child_items[i]->ysort_parent_abs_z_index, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner, true, p_canvas_cull_mask, child_items[i]->repeat_size, child_items[i]->repeat_times, child_items[i]->repeat_source_item, p_task);
 			}
 		} else {
 			RendererCanvasRender::Item *canvas_group_from = nullptr;
@@ -418,7 +749,7 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 				canvas_group_from = r_z_last_list[zidx];
 			}
 
-			_attach_canvas_item_for_draw(ci, p_canvas_clip, r_z_list, r_z_last_list, final_xform, p_clip_rect, global_rect, modulate, p_z, p_material_owner, use_canvas_group, canvas_group_from);
+			_attach_canvas_item_for_draw(ci, p_canvas_clip, r_z_list, r_z_last_list, final_xform, p_clip_rect, global_rect, modulate, p_z, p_material_owner, use_canvas_group, canvas_group_from, p_task);
 		}
 	} else {
 		RendererCanvasRender::Item *canvas_group_from = nullptr;
@@ -428,22 +759,209 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			canvas_group_from = r_z_last_list[zidx];
 		}
 
+		if (p_task == nullptr && (uint32_t)child_item_count >= threaded_cull_minimum_items) {
+			CullChildrenData data;
+			data.items = child_items;
+			data.item_count = child_item_count;
+			data.cull_children = use_canvas_group ? CULL_CHILDREN_ALL : CULL_CHILDREN_BEHIND;
+			data.xform = final_xform;
+			data.clip_rect = p_clip_rect;
+			data.modulate = modulate;
+			data.z = p_z;
+			data.canvas_clip = (Item *)ci->final_clip_owner;
+			data.material_owner = p_material_owner;
+			data.canvas_cull_mask = p_canvas_cull_mask;
+			data.repeat_size = repeat_size;
+			data.repeat_times = repeat_times;
+			data.repeat_source_item = repeat_source_item;
+
+			_cull_canvas_children(data, r_z_list, r_z_last_list);
+			_attach_canvas_item_for_draw(ci, p_canvas_clip, r_z_list, r_z_last_list, final_xform, p_clip_rect, global_rect, modulate, p_z, p_material_owner, use_canvas_group, canvas_group_from, p_task);
+			if (!use_canvas_group) {
+				data.cull_children = CULL_CHILDREN_IN_FRONT;
+				_cull_canvas_children(data, r_z_list, r_z_last_list);
+			}
+			return;
+		}
+
 		for (int i = 0; i < child_item_count; i++) {
 			if (!child_items[i]->behind && !use_canvas_group) {
 				continue;
 			}
-			_cull_canvas_item(child_items[i], final_xform, p_clip_rect, modulate, p_z, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, p_material_owner, false, p_canvas_cull_mask, repeat_size, repeat_times, repeat_source_item);
+			_cull_canvas_item(child_items[i], final_xform, p_clip_rect, modulate, p_z, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, p_material_owner, false, p_canvas_cull_mask, repeat_size, repeat_times, repeat_source_item, p_task);
 		}
-		_attach_canvas_item_for_draw(ci, p_canvas_clip, r_z_list, r_z_last_list, final_xform, p_clip_rect, global_rect, modulate, p_z, p_material_owner, use_canvas_group, canvas_group_from);
+		_attach_canvas_item_for_draw(ci, p_canvas_clip, r_z_list, r_z_last_list, final_xform, p_clip_rect, global_rect, modulate, p_z, p_material_owner, use_canvas_group, canvas_group_from, p_task);
 		for (int i = 0; i < child_item_count; i++) {
 			if (child_items[i]->behind || use_canvas_group) {
 				continue;
 			}
-			_cull_canvas_item(child_items[i], final_xform, p_clip_rect, modulate, p_z, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, p_material_owner, false, p_canvas_cull_mask, repeat_size, repeat_times, repeat_source_item);
+			_cull_canvas_item(child_items[i], final_xform, p_clip_rect, modulate, p_z, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, p_material_owner, false, p_canvas_cull_mask, repeat_size, repeat_times, repeat_source_item, p_task);
 		}
 	}
 }
 
+void RendererCanvasCull::_cull_canvas_children_threaded(uint32_t p_task, CullChildrenData *p_data) {
+	uint32_t task_count = cull_tasks.size();
+	uint32_t from = p_task * p_data->item_count / task_count;
+	uint32_t to = (p_task + 1 == task_count) ? p_data->item_count : ((p_task + 1) * p_data->item_count / task_count);
+
+	CullTask *task = &cull_tasks[p_task];
+	for (uint32_t i = from; i < to; i++) {
+		Item *child = p_data->items[i];
+		if (p_data->y_sorted) {
+			_cull_canvas_item(child, p_data->xform * child->ysort_xform, p_data->clip_rect, p_data->modulate * child->ysort_modulate, child->ysort_parent_abs_z_index, task->z_list, task->z_last_list, p_data->canvas_clip, (Item *)child->material_owner, true, p_data->canvas_cull_mask, child->repeat_size, child->repeat_times, child->repeat_source_item, task);
+			continue;
+		}
+
+		if ((p_data->cull_children == CULL_CHILDREN_BEHIND && !child->behind) || (p_data->cull_children == CULL_CHILDREN_IN_FRONT && child->behind)) {
+			continue;
+		}
+		_cull_canvas_item(child, p_data->xform, p_data->clip_rect, p_data->modulate, p_data->z, task->z_list, task->z_last_list, p_data->canvas_clip, p_data->material_owner, false, p_data->canvas_cull_mask, p_data->repeat_size, p_data->repeat_times, p_data->repeat_source_item, task);
+	}
+}
+
+void RendererCanvasCull::_resolve_storage_rects(Item *p_canvas_item) {
+	if (!p_canvas_item->visible) {
+		return;
+	}
+
+	if (p_canvas_item->rect_from_storage) {
+		p_canvas_item->get_rect();
+	}
+
+	for (Item *child : p_canvas_item->child_items) {
+		_resolve_storage_rects(child);
+	}
+}
+
+void RendererCanvasCull::_cull_canvas_children(CullChildrenData &p_data, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list) {
+	// Mesh storage updates its dirty lists and caches skinned AABBs while
+	// being queried, so those rects are resolved here instead of in the tasks.
+	for (uint32_t i = 0; i < p_data.item_count; i++) {
+		Item *child = p_data.items[i];
+		if (!p_data.y_sorted && ((p_data.cull_children == CULL_CHILDREN_BEHIND && !child->behind) || (p_data.cull_children == CULL_CHILDREN_IN_FRONT && child->behind))) {
+			continue;
+		}
+		_resolve_storage_rects(child);
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererCanvasCull::_cull_canvas_children_threaded, &p_data, cull_tasks.size(), -1, true, SNAME("RenderCullCanvasItems"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	int z_min = z_range;
+	int z_max = -1;
+	for (const CullTask &task : cull_tasks) {
+		z_min = MIN(z_min, task.z_min);
+		z_max = MAX(z_max, task.z_max);
+	}
+
+	// Tasks cover consecutive ranges of items, so appending their lists in
+	// task order keeps the order a single thread would have produced.
+	for (int i = z_min; i <= z_max; i++) {
+		for (const CullTask &task : cull_tasks) {
+			if (!task.z_list[i]) {
+				continue;
+			}
+			if (r_z_last_list[i]) {
+				r_z_last_list[i]->next = task.z_list[i];
+			} else {
+				r_z_list[i] = task.z_list[i];
+			}
+			r_z_last_list[i] = task.z_last_list[i];
+		}
+	}
+
+	for (CullTask &task : cull_tasks) {
+		if (task.z_min <= task.z_max) {
+			memset(task.z_list + task.z_min, 0, (task.z_max - task.z_min + 1) * sizeof(RendererCanvasRender::Item *));
+			memset(task.z_last_list + task.z_min, 0, (task.z_max - task.z_min + 1) * sizeof(RendererCanvasRender::Item *));
+			task.z_min = z_range;
+			task.z_max = -1;
+		}
+
+		for (Item *ci : task.visible_notifiers) {
+			if (!ci->visibility_notifier->visible_element.in_list()) {
+				visibility_notifier_list.add(&ci->visibility_notifier->visible_element);
+				ci->visibility_notifier->just_visible = true;
+			}
+		}
+		task.visible_notifiers.clear();
+
+		if (task.redraw_requested) {
+			RenderingServerDefault::redraw_request();
+			task.redraw_requested = false;
+		}
+	}
+}
+
+void RendererCanvasCull::_cull_ysort_children(Item *p_canvas_item, const Transform2D &p_xform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, Item *p_material_owner, uint32_t p_canvas_cull_mask) {
+	YSortData data;
+	data.canvas_item = p_canvas_item;
+	data.material_owner = p_material_owner;
+	data.z = p_z;
+
+	// Every direct child starts at a known index, so the subtrees can be
+	// collected in parallel and get the same `ysort_index` as a single pass.
+	int child_count = p_canvas_item->child_items.size();
+	Item **child_items = p_canvas_item->child_items.ptrw();
+	data.child_items = child_items;
+	data.child_offsets.resize(child_count);
+	int item_count = 1;
+	for (int i = 0; i < child_count; i++) {
+		Item *child = child_items[i];
+		if (!child->visible) {
+			data.child_offsets[i] = -1;
+			continue;
+		}
+		data.child_offsets[i] = item_count;
+		item_count++;
+		if (child->sort_y) {
+			if (child->ysort_children_count == -1) {
+				child->ysort_children_count = _count_ysort_children(child);
+			}
+			item_count += child->ysort_children_count;
+		}
+	}
+
+	data.items.resize(item_count);
+	data.items[0] = p_canvas_item;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererCanvasCull::_collect_ysort_children_threaded, &data, cull_tasks.size(), -1, true, SNAME("RenderCollectCanvasYSort"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Sort one run per task, then merge pairs of runs until a single one is left.
+	// `ysort_index` breaks ties, so the result matches a single sort.
+	uint32_t task_count = cull_tasks.size();
+	data.sort_run_size = (data.items.size() + task_count - 1) / task_count;
+	uint32_t run_count = (data.items.size() + data.sort_run_size - 1) / data.sort_run_size;
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererCanvasCull::_sort_ysort_items_threaded, &data, run_count, -1, true, SNAME("RenderSortCanvasYSort"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	data.sort_buffer.resize(data.items.size());
+	data.sort_from = data.items.ptr();
+	data.sort_to = data.sort_buffer.ptr();
+	while (run_count > 1) {
+		uint32_t pair_count = (run_count + 1) / 2;
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererCanvasCull::_merge_ysort_items_threaded, &data, pair_count, -1, true, SNAME("RenderSortCanvasYSort"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		SWAP(data.sort_from, data.sort_to);
+		data.sort_run_size *= 2;
+		run_count = pair_count;
+	}
+
+	CullChildrenData cull_data;
+	cull_data.items = data.sort_from;
+	cull_data.item_count = data.items.size();
+	cull_data.y_sorted = true;
+	cull_data.xform = p_xform;
+	cull_data.clip_rect = p_clip_rect;
+	cull_data.modulate = p_modulate;
+	cull_data.canvas_clip = (Item *)p_canvas_item->final_clip_owner;
+	cull_data.canvas_cull_mask = p_canvas_cull_mask;
+	_cull_canvas_children(cull_data, r_z_list, r_z_last_list);
+}
+
 void RendererCanvasCull::render_canvas(RID p_render_target, Canvas *p_canvas, const Transform2D &p_transform, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, const Rect2 &p_clip_rect, RenderingServer::CanvasItemTextureFilter p_default_filter, RenderingServer::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_transforms_to_pixel, bool p_snap_2d_vertices_to_pixel, uint32_t canvas_cull_mask, RenderingMethod::RenderInfo *r_render_info) {
 	RENDER_TIMESTAMP("> Render Canvas");
 
@@ -2640,9 +3158,31 @@ RendererCanvasCull::RendererCanvasCull() {
 
 	debug_redraw_time = GLOBAL_DEF("debug/canvas_items/debug_redraw_time", 1.0);
 	debug_redraw_color = GLOBAL_DEF("debug/canvas_items/debug_redraw_color", Color(1.0, 0.2, 0.2, 0.5));
+
+	merge_items_enabled = GLOBAL_GET("rendering/2d/batching/merge_items");
+
+	cull_tasks.resize(WorkerThreadPool::get_singleton()->get_thread_count());
+	for (CullTask &task : cull_tasks) {
+		task.z_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
+		task.z_last_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
+		memset(task.z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+		memset(task.z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+	}
+	threaded_cull_minimum_items = GLOBAL_GET("rendering/2d/culling/threaded_cull_minimum_items");
+	// Make sure there is at least one item per task.
+	threaded_cull_minimum_items = MAX(threaded_cull_minimum_items, cull_tasks.size());
 }
 
 RendererCanvasCull::~RendererCanvasCull() {
+	for (KeyValue<Item *, MergedItem> &E : merged_items) {
+		if (E.value.item) {
+			memdelete(E.value.item);
+		}
+	}
+	for (CullTask &task : cull_tasks) {
+		memfree(task.z_list);
+		memfree(task.z_last_list);
+	}
 	memfree(z_list);
 	memfree(z_last_list);
 }
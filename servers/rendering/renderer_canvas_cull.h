@@ -31,11 +31,14 @@
 #ifndef RENDERER_CANVAS_CULL_H
 #define RENDERER_CANVAS_CULL_H
 
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/paged_allocator.h"
 #include "renderer_compositor.h"
 #include "renderer_viewport.h"
 
 class RendererCanvasCull {
+	friend class TestRendererCanvasCullInternalsAccessor;
+
 public:
 	struct Item : public RendererCanvasRender::Item {
 		RID parent; // canvas it belongs to
@@ -183,26 +186,128 @@ public:
 	PagedAllocator<Item::VisibilityNotifierData> visibility_notifier_allocator;
 	SelfList<Item::VisibilityNotifierData>::List visibility_notifier_list;
 
-	_FORCE_INLINE_ void _attach_canvas_item_for_draw(Item *ci, Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from);
+	static constexpr int z_range = RS::CANVAS_ITEM_Z_MAX - RS::CANVAS_ITEM_Z_MIN + 1;
+
+	// Long child lists are culled on worker threads. Every task fills its own
+	// z-lists, which are appended to the parent's in task order afterwards, so
+	// the draw order is the same as culling on a single thread. Side effects on
+	// shared state are deferred until the tasks finish.
+	struct CullTask {
+		RendererCanvasRender::Item **z_list = nullptr;
+		RendererCanvasRender::Item **z_last_list = nullptr;
+		int z_min = z_range;
+		int z_max = -1;
+		LocalVector<Item *> visible_notifiers;
+		bool redraw_requested = false;
+	};
+
+	enum CullChildren {
+		CULL_CHILDREN_ALL,
+		CULL_CHILDREN_BEHIND,
+		CULL_CHILDREN_IN_FRONT,
+	};
+
+	struct CullChildrenData {
+		Item **items = nullptr;
+		uint32_t item_count = 0;
+		CullChildren cull_children = CULL_CHILDREN_ALL;
+		bool y_sorted = false;
+		Transform2D xform;
+		Rect2 clip_rect;
+		Color modulate;
+		int z = 0;
+		Item *canvas_clip = nullptr;
+		Item *material_owner = nullptr;
+		uint32_t canvas_cull_mask = 0;
+		Point2 repeat_size;
+		int repeat_times = 1;
+		RendererCanvasRender::Item *repeat_source_item = nullptr;
+	};
+
+	struct YSortData {
+		Item *canvas_item = nullptr;
+		Item *material_owner = nullptr;
+		int z = 0;
+		Item **child_items = nullptr;
+		LocalVector<int> child_offsets; // Index of each direct child in `items`, -1 if hidden.
+		LocalVector<Item *> items;
+		LocalVector<Item *> sort_buffer;
+		Item **sort_from = nullptr;
+		Item **sort_to = nullptr;
+		uint32_t sort_run_size = 0;
+	};
+
+	LocalVector<CullTask> cull_tasks;
+	uint32_t threaded_cull_minimum_items = 1000;
+
+	_FORCE_INLINE_ void _attach_canvas_item_for_draw(Item *ci, Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from, CullTask *p_task);
 
 private:
 	void _render_canvas_item_tree(RID p_to_render_target, Canvas::ChildItem *p_child_items, int p_child_item_count, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, uint32_t p_canvas_cull_mask, RenderingMethod::RenderInfo *r_render_info = nullptr);
-	void _cull_canvas_item(Item *p_canvas_item, const Transform2D &p_parent_xform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, Item *p_canvas_clip, Item *p_material_owner, bool p_is_already_y_sorted, uint32_t p_canvas_cull_mask, const Point2 &p_repeat_size, int p_repeat_times, RendererCanvasRender::Item *p_repeat_source_item);
+	void _cull_canvas_item(Item *p_canvas_item, const Transform2D &p_parent_xform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, Item *p_canvas_clip, Item *p_material_owner, bool p_is_already_y_sorted, uint32_t p_canvas_cull_mask, const Point2 &p_repeat_size, int p_repeat_times, RendererCanvasRender::Item *p_repeat_source_item, CullTask *p_task = nullptr);
 
+	void _cull_canvas_children_threaded(uint32_t p_task, CullChildrenData *p_data);
+	void _resolve_storage_rects(Item *p_canvas_item);
+	void _cull_canvas_children(CullChildrenData &p_data, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list);
+	void _cull_ysort_children(Item *p_canvas_item, const Transform2D &p_xform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, Item *p_material_owner, uint32_t p_canvas_cull_mask);
+
+	void _collect_ysort_child(RendererCanvasCull::Item *p_canvas_item, RendererCanvasCull::Item *p_child, RendererCanvasCull::Item *p_material_owner, const Color &p_modulate, RendererCanvasCull::Item **r_items, int &r_index, int p_z);
 	void _collect_ysort_children(RendererCanvasCull::Item *p_canvas_item, RendererCanvasCull::Item *p_material_owner, const Color &p_modulate, RendererCanvasCull::Item **r_items, int &r_index, int p_z);
+	void _collect_ysort_children_threaded(uint32_t p_task, YSortData *p_data);
+	void _sort_ysort_items_threaded(uint32_t p_run, YSortData *p_data);
+	void _merge_ysort_items_threaded(uint32_t p_pair, YSortData *p_data);
 	int _count_ysort_children(RendererCanvasCull::Item *p_canvas_item);
 	void _mark_ysort_dirty(RendererCanvasCull::Item *ysort_owner);
 
-	static constexpr int z_range = RS::CANVAS_ITEM_Z_MAX - RS::CANVAS_ITEM_Z_MIN + 1;
-
 	RendererCanvasRender::Item **z_list;
 	RendererCanvasRender::Item **z_last_list;
 
+	// Runs of neighboring items that draw with the same texture and clip are
+	// merged into a single item after culling. The merged command list is kept
+	// across frames and only rebuilt when one of the source items changes.
+	struct MergedItem {
+		struct Source {
+			Item *item = nullptr;
+			uint64_t command_version = 0;
+			Transform2D transform;
+			Color modulate;
+		};
+
+		RendererCanvasRender::Item *item = nullptr;
+		LocalVector<Source> sources;
+		uint64_t last_used_frame = 0;
+
+		// Runs drawn more than once per frame with different transforms or modulates
+		// (e.g. by several viewports) would be rebuilt every time, so they are left unmerged.
+		uint32_t drawn_state = 0;
+		uint64_t drawn_frame = UINT64_MAX;
+		uint64_t conflict_frame = UINT64_MAX;
+	};
+
+	static constexpr uint32_t MERGE_MAX_ITEMS = 128;
+
+	HashMap<Item *, MergedItem> merged_items;
+	LocalVector<Item *> merge_run;
+	bool merge_items_enabled = false;
+	uint64_t merge_frame = 0;
+	uint32_t merged_batch_count = 0;
+	uint32_t merged_item_count = 0;
+
+	bool _is_item_mergeable(const Item *p_item, RID &r_texture) const;
+	static uint32_t _get_merge_run_state(const LocalVector<Item *> &p_run);
+	RendererCanvasRender::Item *_get_merged_item(const LocalVector<Item *> &p_run);
+	RendererCanvasRender::Item *_merge_canvas_items(RendererCanvasRender::Item *p_list);
+
 public:
 	void render_canvas(RID p_render_target, Canvas *p_canvas, const Transform2D &p_transform, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, const Rect2 &p_clip_rect, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_transforms_to_pixel, bool p_snap_2d_vertices_to_pixel, uint32_t p_canvas_cull_mask, RenderingMethod::RenderInfo *r_render_info = nullptr);
 
 	bool was_sdf_used();
 
+	void set_merge_items_enabled(bool p_enabled) { merge_items_enabled = p_enabled; }
+	bool is_merge_items_enabled() const { return merge_items_enabled; }
+	uint32_t get_merged_batch_count() const { return merged_batch_count; }
+	uint32_t get_merged_item_count() const { return merged_item_count; }
+
 	RID canvas_allocate();
 	void canvas_initialize(RID p_rid);
 
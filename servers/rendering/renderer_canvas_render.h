@@ -340,6 +340,9 @@ public:
 		mutable bool custom_rect;
 		mutable bool rect_dirty;
 		mutable Rect2 rect;
+		// Set when the rect depends on mesh, multimesh or particles storage,
+		// which can only be queried from one thread at a time.
+		bool rect_from_storage = false;
 		RID material;
 		RID skeleton;
 
@@ -374,6 +377,12 @@ public:
 		Command *last_command = nullptr;
 		Vector<CommandBlock> blocks;
 		uint32_t current_block;
+
+		// Changes every time the command list is modified, so copies of the
+		// commands (like merged item runs) can be validated cheaply. The counter
+		// is shared by items that may be culled on different threads.
+		static SafeNumeric<uint64_t> command_version_counter;
+		uint64_t command_version = 0;
 #ifdef DEBUG_ENABLED
 		mutable double debug_redraw_time = 0;
 #endif
@@ -421,7 +430,11 @@ public:
 				}
 			}
 
+			if (command->type == Command::TYPE_MESH || command->type == Command::TYPE_MULTIMESH || command->type == Command::TYPE_PARTICLES) {
+				rect_from_storage = true;
+			}
 			rect_dirty = true;
+			command_version = command_version_counter.increment();
 			return command;
 		}
 
@@ -452,6 +465,8 @@ public:
 			current_block = 0;
 			clip = false;
 			rect_dirty = true;
+			rect_from_storage = false;
+			command_version = command_version_counter.increment();
 			final_clip_owner = nullptr;
 			material_owner = nullptr;
 			light_masked = false;
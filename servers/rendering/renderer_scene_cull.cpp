@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "raster_occlusion_cull.h"
 #include "rendering_light_culler.h"
 #include "rendering_server_constants.h"
 #include "rendering_server_default.h"
@@ -409,7 +410,6 @@ void RendererSceneCull::scenario_initialize(RID p_rid) {
 
 	scenario->reflection_atlas = RSG::light_storage->reflection_atlas_create();
 
-	scenario->instance_aabbs.set_page_pool(&instance_aabb_page_pool);
 	scenario->instance_data.set_page_pool(&instance_data_page_pool);
 	scenario->instance_visibility.set_page_pool(&instance_visibility_data_page_pool);
 
@@ -945,12 +945,16 @@ void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D
 	Instance *instance = instance_owner.get_or_null(p_instance);
 	ERR_FAIL_NULL(instance);
 
+	_instance_set_transform(instance, p_transform);
+}
+
+void RendererSceneCull::_instance_set_transform(Instance *p_instance, const Transform3D &p_transform) {
 #ifdef RENDERING_SERVER_DEBUG_PHYSICS_INTERPOLATION
 	print_line("instance_set_transform " + rtos(p_transform.origin.x) + " .. tick " + itos(Engine::get_singleton()->get_physics_frames()));
 #endif
 
-	if (!_interpolation_data.interpolation_enabled || !instance->interpolated || !instance->scenario) {
-		if (instance->transform == p_transform) {
+	if (!_interpolation_data.interpolation_enabled || !p_instance->interpolated || !p_instance->scenario) {
+		if (p_instance->transform == p_transform) {
 			return; // Must be checked to avoid worst evil.
 		}
 
@@ -962,12 +966,12 @@ void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D
 		}
 
 #endif
-		instance->transform = p_transform;
-		_instance_queue_update(instance, true);
+		p_instance->transform = p_transform;
+		_instance_queue_update(p_instance, true);
 
 #if defined(DEBUG_ENABLED) && defined(TOOLS_ENABLED)
-		if (_interpolation_data.interpolation_enabled && !instance->interpolated && Engine::get_singleton()->is_in_physics_frame()) {
-			PHYSICS_INTERPOLATION_NODE_WARNING(instance->object_id, "Non-interpolated instance triggered from physics process");
+		if (_interpolation_data.interpolation_enabled && !p_instance->interpolated && Engine::get_singleton()->is_in_physics_frame()) {
+			PHYSICS_INTERPOLATION_NODE_WARNING(p_instance->object_id, "Non-interpolated instance triggered from physics process");
 		}
 #endif
 
@@ -975,14 +979,14 @@ void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D
 	}
 
 	float new_checksum = TransformInterpolator::checksum_transform_3d(p_transform);
-	bool checksums_match = (instance->transform_checksum_curr == new_checksum) && (instance->transform_checksum_prev == new_checksum);
+	bool checksums_match = (p_instance->transform_checksum_curr == new_checksum) && (p_instance->transform_checksum_prev == new_checksum);
 
 	// We can't entirely reject no changes because we need the interpolation
 	// system to keep on stewing.
 
 	// Optimized check. First checks the checksums. If they pass it does the slow check at the end.
 	// Alternatively we can do this non-optimized and ignore the checksum... if no change.
-	if (checksums_match && (instance->transform_curr == p_transform) && (instance->transform_prev == p_transform)) {
+	if (checksums_match && (p_instance->transform_curr == p_transform) && (p_instance->transform_prev == p_transform)) {
 		return;
 	}
 
@@ -995,18 +999,18 @@ void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D
 
 #endif
 
-	instance->transform_curr = p_transform;
+	p_instance->transform_curr = p_transform;
 
 #ifdef RENDERING_SERVER_DEBUG_PHYSICS_INTERPOLATION
-	print_line("\tprev " + rtos(instance->transform_prev.origin.x) + ", curr " + rtos(instance->transform_curr.origin.x));
+	print_line("\tprev " + rtos(p_instance->transform_prev.origin.x) + ", curr " + rtos(p_instance->transform_curr.origin.x));
 #endif
 
 	// Keep checksums up to date.
-	instance->transform_checksum_curr = new_checksum;
+	p_instance->transform_checksum_curr = new_checksum;
 
-	if (!instance->on_interpolate_transform_list) {
-		_interpolation_data.instance_transform_update_list_curr->push_back(p_instance);
-		instance->on_interpolate_transform_list = true;
+	if (!p_instance->on_interpolate_transform_list) {
+		_interpolation_data.instance_transform_update_list_curr->push_back(p_instance->self);
+		p_instance->on_interpolate_transform_list = true;
 	} else {
 		DEV_ASSERT(_interpolation_data.instance_transform_update_list_curr->size());
 	}
@@ -1015,25 +1019,25 @@ void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D
 	// transform or anything else.
 	// Ideally we would not even call the VisualServer::set_transform() when invisible but that would entail having logic
 	// to keep track of the previous transform on the SceneTree side. The "early out" below is less efficient but a lot cleaner codewise.
-	if (!instance->visible) {
+	if (!p_instance->visible) {
 		return;
 	}
 
 	// Decide on the interpolation method... slerp if possible.
-	instance->interpolation_method = TransformInterpolator::find_method(instance->transform_prev.basis, instance->transform_curr.basis);
+	p_instance->interpolation_method = TransformInterpolator::find_method(p_instance->transform_prev.basis, p_instance->transform_curr.basis);
 
-	if (!instance->on_interpolate_list) {
-		_interpolation_data.instance_interpolate_update_list.push_back(p_instance);
-		instance->on_interpolate_list = true;
+	if (!p_instance->on_interpolate_list) {
+		_interpolation_data.instance_interpolate_update_list.push_back(p_instance->self);
+		p_instance->on_interpolate_list = true;
 	} else {
 		DEV_ASSERT(_interpolation_data.instance_interpolate_update_list.size());
 	}
 
-	_instance_queue_update(instance, true);
+	_instance_queue_update(p_instance, true);
 
 #if defined(DEBUG_ENABLED) && defined(TOOLS_ENABLED)
 	if (!Engine::get_singleton()->is_in_physics_frame()) {
-		PHYSICS_INTERPOLATION_NODE_WARNING(instance->object_id, "Interpolated instance triggered from outside physics process");
+		PHYSICS_INTERPOLATION_NODE_WARNING(p_instance->object_id, "Interpolated instance triggered from outside physics process");
 	}
 #endif
 }
@@ -1101,61 +1105,65 @@ void RendererSceneCull::instance_set_visible(RID p_instance, bool p_visible) {
 	Instance *instance = instance_owner.get_or_null(p_instance);
 	ERR_FAIL_NULL(instance);
 
-	if (instance->visible == p_visible) {
+	_instance_set_visible(instance, p_visible);
+}
+
+void RendererSceneCull::_instance_set_visible(Instance *p_instance, bool p_visible) {
+	if (p_instance->visible == p_visible) {
 		return;
 	}
 
-	instance->visible = p_visible;
+	p_instance->visible = p_visible;
 
 	if (p_visible) {
-		if (instance->scenario != nullptr) {
+		if (p_instance->scenario != nullptr) {
 			// Special case for physics interpolation, we want to ensure the interpolated data is up to date
-			if (_interpolation_data.interpolation_enabled && instance->interpolated && !instance->on_interpolate_list) {
+			if (_interpolation_data.interpolation_enabled && p_instance->interpolated && !p_instance->on_interpolate_list) {
 				// Do all the extra work we normally do on instance_set_transform(), because this is optimized out for hidden instances.
 				// This prevents a glitch of stale interpolation transform data when unhiding before the next physics tick.
-				instance->interpolation_method = TransformInterpolator::find_method(instance->transform_prev.basis, instance->transform_curr.basis);
-				_interpolation_data.instance_interpolate_update_list.push_back(p_instance);
-				instance->on_interpolate_list = true;
+				p_instance->interpolation_method = TransformInterpolator::find_method(p_instance->transform_prev.basis, p_instance->transform_curr.basis);
+				_interpolation_data.instance_interpolate_update_list.push_back(p_instance->self);
+				p_instance->on_interpolate_list = true;
 
 				// We must also place on the transform update list for a tick, so the system
 				// can auto-detect if the instance is no longer moving, and remove from the interpolate lists again.
 				// If this step is ignored, an unmoving instance could remain on the interpolate lists indefinitely
 				// (or rather until the object is deleted) and cause unnecessary updates and drawcalls.
-				if (!instance->on_interpolate_transform_list) {
-					_interpolation_data.instance_transform_update_list_curr->push_back(p_instance);
-					instance->on_interpolate_transform_list = true;
+				if (!p_instance->on_interpolate_transform_list) {
+					_interpolation_data.instance_transform_update_list_curr->push_back(p_instance->self);
+					p_instance->on_interpolate_transform_list = true;
 				}
 			}
-			_instance_queue_update(instance, true, false);
+			_instance_queue_update(p_instance, true, false);
 		}
-	} else if (instance->indexer_id.is_valid()) {
-		_unpair_instance(instance);
+	} else if (p_instance->indexer_id.is_valid()) {
+		_unpair_instance(p_instance);
 	}
 
-	if (instance->base_type == RS::INSTANCE_LIGHT) {
-		InstanceLightData *light = static_cast<InstanceLightData *>(instance->base_data);
-		if (instance->scenario && RSG::light_storage->light_get_type(instance->base) != RS::LIGHT_DIRECTIONAL && light->bake_mode == RS::LIGHT_BAKE_DYNAMIC) {
+	if (p_instance->base_type == RS::INSTANCE_LIGHT) {
+		InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
+		if (p_instance->scenario && RSG::light_storage->light_get_type(p_instance->base) != RS::LIGHT_DIRECTIONAL && light->bake_mode == RS::LIGHT_BAKE_DYNAMIC) {
 			if (p_visible) {
-				instance->scenario->dynamic_lights.push_back(light->instance);
+				p_instance->scenario->dynamic_lights.push_back(light->instance);
 			} else {
-				instance->scenario->dynamic_lights.erase(light->instance);
+				p_instance->scenario->dynamic_lights.erase(light->instance);
 			}
 		}
 	}
 
-	if (instance->base_type == RS::INSTANCE_PARTICLES_COLLISION) {
-		InstanceParticlesCollisionData *collision = static_cast<InstanceParticlesCollisionData *>(instance->base_data);
+	if (p_instance->base_type == RS::INSTANCE_PARTICLES_COLLISION) {
+		InstanceParticlesCollisionData *collision = static_cast<InstanceParticlesCollisionData *>(p_instance->base_data);
 		RSG::particles_storage->particles_collision_instance_set_active(collision->instance, p_visible);
 	}
 
-	if (instance->base_type == RS::INSTANCE_FOG_VOLUME) {
-		InstanceFogVolumeData *volume = static_cast<InstanceFogVolumeData *>(instance->base_data);
+	if (p_instance->base_type == RS::INSTANCE_FOG_VOLUME) {
+		InstanceFogVolumeData *volume = static_cast<InstanceFogVolumeData *>(p_instance->base_data);
 		scene_render->fog_volume_instance_set_active(volume->instance, p_visible);
 	}
 
-	if (instance->base_type == RS::INSTANCE_OCCLUDER) {
-		if (instance->scenario) {
-			RendererSceneOcclusionCull::get_singleton()->scenario_set_instance(instance->scenario->self, p_instance, instance->base, instance->transform, p_visible);
+	if (p_instance->base_type == RS::INSTANCE_OCCLUDER) {
+		if (p_instance->scenario) {
+			RendererSceneOcclusionCull::get_singleton()->scenario_set_instance(p_instance->scenario->self, p_instance->self, p_instance->base, p_instance->transform, p_visible);
 		}
 	}
 }
@@ -1168,23 +1176,74 @@ void RendererSceneCull::instance_set_custom_aabb(RID p_instance, AABB p_aabb) {
 	Instance *instance = instance_owner.get_or_null(p_instance);
 	ERR_FAIL_NULL(instance);
 
+	_instance_set_custom_aabb(instance, p_aabb);
+}
+
+void RendererSceneCull::_instance_set_custom_aabb(Instance *p_instance, const AABB &p_aabb) {
 	if (p_aabb != AABB()) {
 		// Set custom AABB
-		if (instance->custom_aabb == nullptr) {
-			instance->custom_aabb = memnew(AABB);
+		if (p_instance->custom_aabb == nullptr) {
+			p_instance->custom_aabb = memnew(AABB);
 		}
-		*instance->custom_aabb = p_aabb;
+		*p_instance->custom_aabb = p_aabb;
 
 	} else {
 		// Clear custom AABB
-		if (instance->custom_aabb != nullptr) {
-			memdelete(instance->custom_aabb);
-			instance->custom_aabb = nullptr;
+		if (p_instance->custom_aabb != nullptr) {
+			memdelete(p_instance->custom_aabb);
+			p_instance->custom_aabb = nullptr;
 		}
 	}
 
-	if (instance->scenario) {
-		_instance_queue_update(instance, true, false);
+	if (p_instance->scenario) {
+		_instance_queue_update(p_instance, true, false);
+	}
+}
+
+void RendererSceneCull::instances_set_transforms(const Vector<RID> &p_instances, const Vector<float> &p_transforms) {
+	ERR_FAIL_COND_MSG(p_transforms.size() != p_instances.size() * 12, "Transforms must contain 12 floats per instance.");
+
+	const RID *instances = p_instances.ptr();
+	const float *data = p_transforms.ptr();
+	for (int i = 0; i < p_instances.size(); i++) {
+		Instance *instance = instance_owner.get_or_null(instances[i]);
+		ERR_CONTINUE(!instance);
+
+		// Same layout as 3D transforms in multimesh buffers.
+		const float *t = &data[i * 12];
+		Transform3D transform;
+		transform.basis.rows[0] = Vector3(t[0], t[1], t[2]);
+		transform.origin.x = t[3];
+		transform.basis.rows[1] = Vector3(t[4], t[5], t[6]);
+		transform.origin.y = t[7];
+		transform.basis.rows[2] = Vector3(t[8], t[9], t[10]);
+		transform.origin.z = t[11];
+
+		_instance_set_transform(instance, transform);
+	}
+}
+
+void RendererSceneCull::instances_set_custom_aabbs(const Vector<RID> &p_instances, const Vector<float> &p_aabbs) {
+	ERR_FAIL_COND_MSG(p_aabbs.size() != p_instances.size() * 6, "AABBs must contain 6 floats per instance.");
+
+	const RID *instances = p_instances.ptr();
+	const float *data = p_aabbs.ptr();
+	for (int i = 0; i < p_instances.size(); i++) {
+		Instance *instance = instance_owner.get_or_null(instances[i]);
+		ERR_CONTINUE(!instance);
+
+		const float *a = &data[i * 6];
+		_instance_set_custom_aabb(instance, AABB(Vector3(a[0], a[1], a[2]), Vector3(a[3], a[4], a[5])));
+	}
+}
+
+void RendererSceneCull::instances_set_visible(const Vector<RID> &p_instances, bool p_visible) {
+	const RID *instances = p_instances.ptr();
+	for (int i = 0; i < p_instances.size(); i++) {
+		Instance *instance = instance_owner.get_or_null(instances[i]);
+		ERR_CONTINUE(!instance);
+
+		_instance_set_visible(instance, p_visible);
 	}
 }
 
@@ -1716,6 +1775,44 @@ void RendererSceneCull::instance_geometry_get_shader_parameter_list(RID p_instan
 }
 
 void RendererSceneCull::_update_instance(Instance *p_instance) {
+	_update_instance_bounds(p_instance);
+	if (_update_instance_transform(p_instance, false)) {
+		_update_instance_pairs(p_instance);
+	}
+}
+
+void RendererSceneCull::_update_instance_bounds(Instance *p_instance) {
+	// Only touches the instance itself, so it can run for many instances in parallel.
+	if (p_instance->base_type == RS::INSTANCE_NONE || !p_instance->aabb.has_surface()) {
+		return;
+	}
+
+	p_instance->transformed_aabb = p_instance->transform.xform(p_instance->aabb);
+
+	//quantize to improve moving object performance
+	AABB bvh_aabb = p_instance->transformed_aabb;
+
+	if (p_instance->indexer_id.is_valid() && bvh_aabb != p_instance->prev_transformed_aabb) {
+		//assume motion, see if bounds need to be quantized
+		AABB motion_aabb = bvh_aabb.merge(p_instance->prev_transformed_aabb);
+		float motion_longest_axis = motion_aabb.get_longest_axis_size();
+		float longest_axis = p_instance->transformed_aabb.get_longest_axis_size();
+
+		if (motion_longest_axis < longest_axis * 2) {
+			//moved but not a lot, use motion aabb quantizing
+			float quantize_size = Math::pow(2.0, Math::ceil(Math::log(motion_longest_axis) / Math::log(2.0))) * 0.5; //one fifth
+			bvh_aabb.quantize(quantize_size);
+		}
+	}
+
+	p_instance->indexer_aabb = bvh_aabb;
+}
+
+void RendererSceneCull::_update_instance_bounds_threaded(uint32_t p_index, Instance **p_instances) {
+	_update_instance_bounds(p_instances[p_index]);
+}
+
+bool RendererSceneCull::_update_instance_transform(Instance *p_instance, bool p_defer_refit) {
 	p_instance->version++;
 
 	// When not using interpolation the transform is used straight.
@@ -1792,11 +1889,11 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 			RendererSceneOcclusionCull::get_singleton()->scenario_set_instance(p_instance->scenario->self, p_instance->self, p_instance->base, *instance_xform, p_instance->visible);
 		}
 	} else if (p_instance->base_type == RS::INSTANCE_NONE) {
-		return;
+		return false;
 	}
 
 	if (!p_instance->aabb.has_surface()) {
-		return;
+		return false;
 	}
 
 	if (p_instance->base_type == RS::INSTANCE_LIGHTMAP) {
@@ -1810,10 +1907,6 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		}
 	}
 
-	AABB new_aabb;
-	new_aabb = instance_xform->xform(p_instance->aabb);
-	p_instance->transformed_aabb = new_aabb;
-
 	if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
 		InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(p_instance->base_data);
 		//make sure lights are updated if it casts shadow
@@ -1832,36 +1925,22 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 			if (!p_instance->lightmap_sh.is_empty()) {
 				p_instance->lightmap_sh.clear(); //don't need SH
 				p_instance->lightmap_target_sh.clear(); //don't need SH
-				ERR_FAIL_NULL(geom->geometry_instance);
+				ERR_FAIL_NULL_V(geom->geometry_instance, false);
 				geom->geometry_instance->set_lightmap_capture(nullptr);
 			}
 		}
 
-		ERR_FAIL_NULL(geom->geometry_instance);
+		ERR_FAIL_NULL_V(geom->geometry_instance, false);
 		geom->geometry_instance->set_transform(*instance_xform, p_instance->aabb, p_instance->transformed_aabb);
 	}
 
 	// note: we had to remove is equal approx check here, it meant that det == 0.000004 won't work, which is the case for some of our scenes.
 	if (p_instance->scenario == nullptr || !p_instance->visible || instance_xform->basis.determinant() == 0) {
 		p_instance->prev_transformed_aabb = p_instance->transformed_aabb;
-		return;
+		return false;
 	}
 
-	//quantize to improve moving object performance
-	AABB bvh_aabb = p_instance->transformed_aabb;
-
-	if (p_instance->indexer_id.is_valid() && bvh_aabb != p_instance->prev_transformed_aabb) {
-		//assume motion, see if bounds need to be quantized
-		AABB motion_aabb = bvh_aabb.merge(p_instance->prev_transformed_aabb);
-		float motion_longest_axis = motion_aabb.get_longest_axis_size();
-		float longest_axis = p_instance->transformed_aabb.get_longest_axis_size();
-
-		if (motion_longest_axis < longest_axis * 2) {
-			//moved but not a lot, use motion aabb quantizing
-			float quantize_size = Math::pow(2.0, Math::ceil(Math::log(motion_longest_axis) / Math::log(2.0))) * 0.5; //one fifth
-			bvh_aabb.quantize(quantize_size);
-		}
-	}
+	const AABB &bvh_aabb = p_instance->indexer_aabb;
 
 	if (!p_instance->indexer_id.is_valid()) {
 		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
@@ -1954,18 +2033,23 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		p_instance->scenario->instance_aabbs.push_back(InstanceBounds(p_instance->transformed_aabb));
 		_update_instance_visibility_dependencies(p_instance);
 	} else {
-		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
-			p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].update(p_instance->indexer_id, bvh_aabb);
+		DynamicBVH &indexer = p_instance->scenario->indexers[((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) ? Scenario::INDEXER_GEOMETRY : Scenario::INDEXER_VOLUMES];
+		if (p_defer_refit) {
+			indexer.update_deferred(p_instance->indexer_id, bvh_aabb);
 		} else {
-			p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].update(p_instance->indexer_id, bvh_aabb);
+			indexer.update(p_instance->indexer_id, bvh_aabb);
 		}
-		p_instance->scenario->instance_aabbs[p_instance->array_index] = InstanceBounds(p_instance->transformed_aabb);
+		p_instance->scenario->instance_aabbs.set(p_instance->array_index, InstanceBounds(p_instance->transformed_aabb));
 	}
 
 	if (p_instance->visibility_index != -1) {
 		p_instance->scenario->instance_visibility[p_instance->visibility_index].position = p_instance->transformed_aabb.get_center();
 	}
 
+	return true;
+}
+
+void RendererSceneCull::_update_instance_pairs(Instance *p_instance) {
 	//move instance and repair
 	pair_pass++;
 
@@ -2049,7 +2133,7 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 		Instance *swapped_instance = p_instance->scenario->instance_data[swap_with_index].instance;
 		swapped_instance->array_index = p_instance->array_index; //swap
 		p_instance->scenario->instance_data[p_instance->array_index] = p_instance->scenario->instance_data[swap_with_index];
-		p_instance->scenario->instance_aabbs[p_instance->array_index] = p_instance->scenario->instance_aabbs[swap_with_index];
+		p_instance->scenario->instance_aabbs.set(p_instance->array_index, p_instance->scenario->instance_aabbs[swap_with_index]);
 
 		if (swapped_instance->visibility_index != -1) {
 			swapped_instance->scenario->instance_visibility[swapped_instance->visibility_index].array_index = swapped_instance->array_index;
@@ -2469,13 +2553,13 @@ void RendererSceneCull::_light_instance_setup_directional_shadow(int p_shadow_in
 	}
 }
 
-bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_screen_mesh_lod_threshold, uint32_t p_visible_layers) {
+bool RendererSceneCull::_light_instance_add_shadow_views(Instance *p_instance) {
 	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
 
 	Transform3D light_transform = p_instance->transform;
 	light_transform.orthonormalize(); //scale does not count on lights
 
-	bool animated_material_found = false;
+	const uint32_t first_view = shadow_cull_views.size();
 
 	switch (RSG::light_storage->light_get_type(p_instance->base)) {
 		case RS::LIGHT_DIRECTIONAL: {
@@ -2485,75 +2569,33 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 			if (shadow_mode == RS::LIGHT_OMNI_SHADOW_DUAL_PARABOLOID || !RSG::light_storage->light_instances_can_render_shadow_cube()) {
 				if (max_shadows_used + 2 > MAX_UPDATE_SHADOWS) {
-					return true;
+					return false;
 				}
 				for (int i = 0; i < 2; i++) {
-					//using this one ensures that raster deferred will have it
-					RENDER_TIMESTAMP("Cull OmniLight3D Shadow Paraboloid, Half " + itos(i));
-
 					real_t radius = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
 
 					real_t z = i == 0 ? -1 : 1;
-					Vector<Plane> planes;
-					planes.resize(6);
-					planes.write[0] = light_transform.xform(Plane(Vector3(0, 0, z), radius));
-					planes.write[1] = light_transform.xform(Plane(Vector3(1, 0, z).normalized(), radius));
-					planes.write[2] = light_transform.xform(Plane(Vector3(-1, 0, z).normalized(), radius));
-					planes.write[3] = light_transform.xform(Plane(Vector3(0, 1, z).normalized(), radius));
-					planes.write[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
-					planes.write[5] = light_transform.xform(Plane(Vector3(0, 0, -z), 0));
-
-					instance_shadow_cull_result.clear();
-
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-					struct CullConvex {
-						PagedArray<Instance *> *result;
-						_FORCE_INLINE_ bool operator()(void *p_data) {
-							Instance *p_instance = (Instance *)p_data;
-							result->push_back(p_instance);
-							return false;
-						}
-					};
-
-					CullConvex cull_convex;
-					cull_convex.result = &instance_shadow_cull_result;
-
-					p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
-
-					RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
-
-					if (!light->is_shadow_update_full()) {
-						light_culler->cull_regular_light(instance_shadow_cull_result);
-					}
-
-					for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask)) {
-							continue;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-
-							if (instance->mesh_instance.is_valid()) {
-								RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
-							}
-						}
-
-						shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-					}
-
-					RSG::mesh_storage->update_mesh_instances();
-
-					RSG::light_storage->light_instance_set_shadow_transform(light->instance, Projection(), light_transform, radius, 0, i, 0);
-					shadow_data.light = light->instance;
-					shadow_data.pass = i;
+					ShadowCullView view;
+					view.planes.resize(6);
+					view.planes.write[0] = light_transform.xform(Plane(Vector3(0, 0, z), radius));
+					view.planes.write[1] = light_transform.xform(Plane(Vector3(1, 0, z).normalized(), radius));
+					view.planes.write[2] = light_transform.xform(Plane(Vector3(-1, 0, z).normalized(), radius));
+					view.planes.write[3] = light_transform.xform(Plane(Vector3(0, 1, z).normalized(), radius));
+					view.planes.write[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
+					view.planes.write[5] = light_transform.xform(Plane(Vector3(0, 0, -z), 0));
+					view.points = Geometry3D::compute_convex_mesh_points(&view.planes[0], view.planes.size());
+
+					view.light = p_instance;
+					view.transform = light_transform;
+					view.radius = radius;
+					view.pass = i;
+					view.shadow_index = max_shadows_used++;
+					shadow_cull_views.push_back(view);
 				}
 			} else { //shadow cube
 
 				if (max_shadows_used + 6 > MAX_UPDATE_SHADOWS) {
-					return true;
+					return false;
 				}
 
 				real_t radius = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
@@ -2561,9 +2603,6 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 				cm.set_perspective(90, 1, radius * 0.005f, radius);
 
 				for (int i = 0; i < 6; i++) {
-					RENDER_TIMESTAMP("Cull OmniLight3D Shadow Cube, Side " + itos(i));
-					//using this one ensures that raster deferred will have it
-
 					static const Vector3 view_normals[6] = {
 						Vector3(+1, 0, 0),
 						Vector3(-1, 0, 0),
@@ -2583,65 +2622,24 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 					Transform3D xform = light_transform * Transform3D().looking_at(view_normals[i], view_up[i]);
 
-					Vector<Plane> planes = cm.get_projection_planes(xform);
-
-					instance_shadow_cull_result.clear();
-
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-					struct CullConvex {
-						PagedArray<Instance *> *result;
-						_FORCE_INLINE_ bool operator()(void *p_data) {
-							Instance *p_instance = (Instance *)p_data;
-							result->push_back(p_instance);
-							return false;
-						}
-					};
-
-					CullConvex cull_convex;
-					cull_convex.result = &instance_shadow_cull_result;
-
-					p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
-
-					RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
-
-					if (!light->is_shadow_update_full()) {
-						light_culler->cull_regular_light(instance_shadow_cull_result);
-					}
-
-					for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask)) {
-							continue;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-							if (instance->mesh_instance.is_valid()) {
-								RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
-							}
-						}
-
-						shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-					}
-
-					RSG::mesh_storage->update_mesh_instances();
-					RSG::light_storage->light_instance_set_shadow_transform(light->instance, cm, xform, radius, 0, i, 0);
-
-					shadow_data.light = light->instance;
-					shadow_data.pass = i;
+					ShadowCullView view;
+					view.planes = cm.get_projection_planes(xform);
+					view.points = Geometry3D::compute_convex_mesh_points(&view.planes[0], view.planes.size());
+
+					view.light = p_instance;
+					view.projection = cm;
+					view.transform = xform;
+					view.radius = radius;
+					view.pass = i;
+					view.shadow_index = max_shadows_used++;
+					shadow_cull_views.push_back(view);
 				}
-
-				//restore the regular DP matrix
-				//RSG::light_storage->light_instance_set_shadow_transform(light->instance, Projection(), light_transform, radius, 0, 0, 0);
 			}
 
 		} break;
 		case RS::LIGHT_SPOT: {
-			RENDER_TIMESTAMP("Cull SpotLight3D Shadow");
-
 			if (max_shadows_used + 1 > MAX_UPDATE_SHADOWS) {
-				return true;
+				return false;
 			}
 
 			real_t radius = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
@@ -2650,29 +2648,85 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 			Projection cm;
 			cm.set_perspective(angle * 2.0, 1.0, 0.005f * radius, radius);
 
-			Vector<Plane> planes = cm.get_projection_planes(light_transform);
+			ShadowCullView view;
+			view.planes = cm.get_projection_planes(light_transform);
+			view.points = Geometry3D::compute_convex_mesh_points(&view.planes[0], view.planes.size());
 
-			instance_shadow_cull_result.clear();
+			view.light = p_instance;
+			view.projection = cm;
+			view.transform = light_transform;
+			view.radius = radius;
+			view.pass = 0;
+			view.shadow_index = max_shadows_used++;
+			shadow_cull_views.push_back(view);
 
-			Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
+		} break;
+	}
 
-			struct CullConvex {
-				PagedArray<Instance *> *result;
-				_FORCE_INLINE_ bool operator()(void *p_data) {
-					Instance *p_instance = (Instance *)p_data;
-					result->push_back(p_instance);
-					return false;
-				}
-			};
+	for (uint32_t i = first_view; i < shadow_cull_views.size(); i++) {
+		const ShadowCullView &view = shadow_cull_views[i];
+		RSG::light_storage->light_instance_set_shadow_transform(light->instance, view.projection, view.transform, view.radius, 0, view.pass, 0);
+	}
+
+	return true;
+}
+
+void RendererSceneCull::_cull_shadow_views(Scenario *p_scenario, uint32_t p_visible_layers) {
+	if (shadow_cull_views.is_empty()) {
+		return;
+	}
+
+	RENDER_TIMESTAMP("Cull Light3D Shadows");
+
+	struct CullConvexMulti {
+		LocalVector<ShadowCullHit> *result;
+		_FORCE_INLINE_ bool operator()(void *p_data, uint64_t p_mask) {
+			result->push_back({ (Instance *)p_data, p_mask });
+			return false;
+		}
+	};
 
-			CullConvex cull_convex;
-			cull_convex.result = &instance_shadow_cull_result;
+	CullConvexMulti cull_convex;
+	cull_convex.result = &shadow_cull_hits;
 
-			p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
+	DynamicBVH::ConvexQuery queries[DynamicBVH::MAX_CONVEX_MULTI_QUERIES];
+	Instance *prepared_light = nullptr;
 
-			RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
+	// Walk the geometry indexer once for every batch of views, instead of once per view.
+	for (uint32_t from = 0; from < shadow_cull_views.size(); from += DynamicBVH::MAX_CONVEX_MULTI_QUERIES) {
+		uint32_t count = MIN(shadow_cull_views.size() - from, DynamicBVH::MAX_CONVEX_MULTI_QUERIES);
+		for (uint32_t i = 0; i < count; i++) {
+			const ShadowCullView &view = shadow_cull_views[from + i];
+			queries[i].planes = view.planes.ptr();
+			queries[i].plane_count = view.planes.size();
+			queries[i].points = view.points.ptr();
+			queries[i].point_count = view.points.size();
+		}
+
+		shadow_cull_hits.clear();
+		p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query_multi(queries, count, cull_convex);
+
+		for (uint32_t i = 0; i < count; i++) {
+			ShadowCullView &view = shadow_cull_views[from + i];
+			InstanceLightData *light = static_cast<InstanceLightData *>(view.light->base_data);
+
+			// Leaves are reported in the same order a single convex query would visit them.
+			const uint64_t view_bit = uint64_t(1) << i;
+			instance_shadow_cull_result.clear();
+			for (const ShadowCullHit &hit : shadow_cull_hits) {
+				if (hit.view_mask & view_bit) {
+					instance_shadow_cull_result.push_back(hit.instance);
+				}
+			}
+
+			RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[view.shadow_index];
 
 			if (!light->is_shadow_update_full()) {
+				if (prepared_light != view.light) {
+					// Views are culled after all lights were checked, so bring back this light's culling planes.
+					light_culler->prepare_regular_light(*view.light);
+					prepared_light = view.light;
+				}
 				light_culler->cull_regular_light(instance_shadow_cull_result);
 			}
 
@@ -2682,26 +2736,33 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 					continue;
 				} else {
 					if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-						animated_material_found = true;
+						view.animated_material_found = true;
 					}
 
 					if (instance->mesh_instance.is_valid()) {
 						RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
 					}
 				}
+
 				shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
 			}
 
-			RSG::mesh_storage->update_mesh_instances();
-
-			RSG::light_storage->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0, 0);
 			shadow_data.light = light->instance;
-			shadow_data.pass = 0;
+			shadow_data.pass = view.pass;
+		}
+	}
 
-		} break;
+	RSG::mesh_storage->update_mesh_instances();
+
+	// Lights with animated materials must be redrawn next frame, only mark them once all their views were culled.
+	for (const ShadowCullView &view : shadow_cull_views) {
+		if (view.animated_material_found) {
+			static_cast<InstanceLightData *>(view.light->base_data)->make_shadow_dirty();
+		}
 	}
 
-	return animated_material_found;
+	shadow_cull_views.clear();
+	shadow_cull_hits.clear();
 }
 
 void RendererSceneCull::render_camera(const Ref<RenderSceneBuffers> &p_render_buffers, RID p_camera, RID p_scenario, RID p_viewport, Size2 p_viewport_size, uint32_t p_jitter_phase_count, float p_screen_mesh_lod_threshold, RID p_shadow_atlas, Ref<XRInterface> &p_xr_interface, RenderInfo *r_render_info) {
@@ -2905,6 +2966,37 @@ bool RendererSceneCull::_visibility_parent_check(const CullData &p_cull_data, co
 	return ((parent_flags & InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK) == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE) || (parent_flags & InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN);
 }
 
+void RendererSceneCull::InstanceBoundsArray::cull_frustum(const Frustum &p_frustum, uint32_t p_from, uint32_t p_to, uint8_t *r_inside) const {
+	DEV_ASSERT(p_to - p_from <= CULL_BLOCK_SIZE);
+
+	// Same test as InstanceBounds::in_frustum(), but going plane by plane over the whole block.
+	// The inner loop is branchless and works on contiguous arrays, so it compiles to SIMD.
+	// The local mask can't alias the bounds, which would otherwise prevent vectorization.
+	uint8_t inside[CULL_BLOCK_SIZE];
+	const uint32_t count = p_to - p_from;
+	for (uint32_t i = 0; i < count; i++) {
+		inside[i] = 1;
+	}
+
+	for (uint32_t p = 0; p < p_frustum.plane_count; p++) {
+		const Plane &plane = p_frustum.planes_ptr[p];
+		const uint32_t *signs = p_frustum.plane_signs_ptr[p].signs;
+		const real_t *x = bounds[signs[0]].ptr() + p_from;
+		const real_t *y = bounds[signs[1]].ptr() + p_from;
+		const real_t *z = bounds[signs[2]].ptr() + p_from;
+		const real_t nx = plane.normal.x;
+		const real_t ny = plane.normal.y;
+		const real_t nz = plane.normal.z;
+		const real_t d = plane.d;
+
+		for (uint32_t i = 0; i < count; i++) {
+			inside[i] &= uint8_t(!(nx * x[i] + ny * y[i] + nz * z[i] - d >= 0.0));
+		}
+	}
+
+	memcpy(r_inside, inside, count);
+}
+
 void RendererSceneCull::_scene_cull_threaded(uint32_t p_thread, CullData *cull_data) {
 	uint32_t cull_total = cull_data->scenario->instance_data.size();
 	uint32_t total_threads = WorkerThreadPool::get_singleton()->get_thread_count();
@@ -2926,9 +3018,20 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 	Transform3D inv_cam_transform = cull_data.cam_transform.inverse();
 	float z_near = cull_data.camera_matrix->get_z_near();
 
+	// Camera frustum results, tested a block at a time ahead of the main loop.
+	uint8_t in_camera_frustum[InstanceBoundsArray::CULL_BLOCK_SIZE];
+	uint64_t frustum_block_from = p_from;
+	uint64_t frustum_block_to = p_from;
+
 	for (uint64_t i = p_from; i < p_to; i++) {
 		bool mesh_visible = false;
 
+		if (i == frustum_block_to) {
+			frustum_block_from = i;
+			frustum_block_to = MIN(i + InstanceBoundsArray::CULL_BLOCK_SIZE, p_to);
+			cull_data.scenario->instance_aabbs.cull_frustum(cull_data.cull->frustum, frustum_block_from, frustum_block_to, in_camera_frustum);
+		}
+
 		InstanceData &idata = cull_data.scenario->instance_data[i];
 		uint32_t visibility_flags = idata.flags & (InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE | InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN | InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN);
 		int32_t visibility_check = -1;
@@ -2936,13 +3039,14 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 #define HIDDEN_BY_VISIBILITY_CHECKS (visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE || visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN)
 #define LAYER_CHECK (cull_data.visible_layers & idata.layer_mask)
 #define IN_FRUSTUM(f) (cull_data.scenario->instance_aabbs[i].in_frustum(f))
+#define IN_CAMERA_FRUSTUM (in_camera_frustum[i - frustum_block_from])
 #define VIS_RANGE_CHECK ((idata.visibility_index == -1) || _visibility_range_check<false>(cull_data.scenario->instance_visibility[idata.visibility_index], cull_data.cam_transform.origin, cull_data.visibility_viewport_mask) == 0)
 #define VIS_PARENT_CHECK (_visibility_parent_check(cull_data, idata))
 #define VIS_CHECK (visibility_check < 0 ? (visibility_check = (visibility_flags != InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK || (VIS_RANGE_CHECK && VIS_PARENT_CHECK))) : visibility_check)
 #define OCCLUSION_CULLED (cull_data.occlusion_buffer != nullptr && (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_OCCLUSION_CULLING) == 0 && cull_data.occlusion_buffer->is_occluded(cull_data.scenario->instance_aabbs[i].bounds, cull_data.cam_transform.origin, inv_cam_transform, *cull_data.camera_matrix, z_near, cull_data.scenario->instance_data[i].occlusion_timeout))
 
 		if (!HIDDEN_BY_VISIBILITY_CHECKS) {
-			if ((LAYER_CHECK && IN_FRUSTUM(cull_data.cull->frustum) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
+			if ((LAYER_CHECK && IN_CAMERA_FRUSTUM && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
 				uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 				if (base_type == RS::INSTANCE_LIGHT) {
 					cull_result.lights.push_back(idata.instance);
@@ -3152,6 +3256,7 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 #undef HIDDEN_BY_VISIBILITY_CHECKS
 #undef LAYER_CHECK
 #undef IN_FRUSTUM
+#undef IN_CAMERA_FRUSTUM
 #undef VIS_RANGE_CHECK
 #undef VIS_PARENT_CHECK
 #undef VIS_CHECK
@@ -3499,17 +3604,18 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 
 			if (redraw && max_shadows_used < MAX_UPDATE_SHADOWS) {
 				//must redraw!
-				RENDER_TIMESTAMP("> Render Light3D " + itos(i));
-				if (_light_instance_update_shadow(ins, p_camera_data->main_transform, p_camera_data->main_projection, p_camera_data->is_orthogonal, p_camera_data->vaspect, p_shadow_atlas, scenario, p_screen_mesh_lod_threshold, p_visible_layers)) {
+				if (!_light_instance_add_shadow_views(ins)) {
 					light->make_shadow_dirty();
 				}
-				RENDER_TIMESTAMP("< Render Light3D " + itos(i));
 			} else {
 				if (redraw) {
 					light->make_shadow_dirty();
 				}
 			}
 		}
+
+		// Cull all positional shadow views together.
+		_cull_shadow_views(scenario, p_visible_layers);
 	}
 
 	//render SDFGI
@@ -4047,7 +4153,7 @@ void RendererSceneCull::_update_instance_shader_uniforms_from_material(HashMap<S
 	}
 }
 
-void RendererSceneCull::_update_dirty_instance(Instance *p_instance) {
+void RendererSceneCull::_update_dirty_instance_data(Instance *p_instance) {
 	if (p_instance->update_aabb) {
 		_update_instance_aabb(p_instance);
 	}
@@ -4272,6 +4378,10 @@ void RendererSceneCull::_update_dirty_instance(Instance *p_instance) {
 			geom->geometry_instance->set_surface_materials(p_instance->materials);
 		}
 	}
+}
+
+void RendererSceneCull::_update_dirty_instance(Instance *p_instance) {
+	_update_dirty_instance_data(p_instance);
 
 	_instance_update_list.remove(&p_instance->update_item);
 
@@ -4282,8 +4392,54 @@ void RendererSceneCull::_update_dirty_instance(Instance *p_instance) {
 }
 
 void RendererSceneCull::update_dirty_instances() {
+	// Updates may queue more instances (e.g. geometry captured by a moved lightmap), those are handled in the next batch.
 	while (_instance_update_list.first()) {
-		_update_dirty_instance(_instance_update_list.first()->self());
+		_instance_update_batch.clear();
+		while (_instance_update_list.first()) {
+			Instance *instance = _instance_update_list.first()->self();
+			_instance_update_list.remove(&instance->update_item);
+			_instance_update_batch.push_back(instance);
+		}
+
+		// Storage queries aren't thread-safe (skinned mesh AABBs are cached per mesh), so this part stays serial.
+		for (Instance *instance : _instance_update_batch) {
+			_update_dirty_instance_data(instance);
+		}
+
+		uint32_t batch_size = _instance_update_batch.size();
+		if (batch_size >= thread_cull_threshold && WorkerThreadPool::get_singleton()->get_thread_index() == -1) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneCull::_update_instance_bounds_threaded, _instance_update_batch.ptr(), batch_size, -1, true, SNAME("RenderUpdateInstanceBounds"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			for (Instance *instance : _instance_update_batch) {
+				_update_instance_bounds(instance);
+			}
+		}
+
+		// Moved instances only update their own leaf in the indexers, which are refit once per scenario before pairing.
+		uint32_t pair_count = 0;
+		_instance_update_scenarios.clear();
+		for (Instance *instance : _instance_update_batch) {
+			if (_update_instance_transform(instance, true)) {
+				_instance_update_batch[pair_count++] = instance;
+				if (!instance->scenario->indexers_refit_pending) {
+					instance->scenario->indexers_refit_pending = true;
+					_instance_update_scenarios.push_back(instance->scenario);
+				}
+			}
+			instance->update_aabb = false;
+			instance->update_dependencies = false;
+		}
+
+		for (Scenario *scenario : _instance_update_scenarios) {
+			scenario->indexers[Scenario::INDEXER_GEOMETRY].refit();
+			scenario->indexers[Scenario::INDEXER_VOLUMES].refit();
+			scenario->indexers_refit_pending = false;
+		}
+
+		for (uint32_t i = 0; i < pair_count; i++) {
+			_update_instance_pairs(_instance_update_batch[i]);
+		}
 	}
 
 	// Update dirty resources after dirty instances as instance updates may affect resources.
@@ -4531,7 +4687,7 @@ RendererSceneCull::RendererSceneCull() {
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count()); //make sure there is at least one thread per CPU
 	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = GLOBAL_GET("rendering/occlusion_culling/jitter_projection");
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	raster_occlusion_culling = memnew(RasterOcclusionCull);
 
 	light_culler = memnew(RenderingLightCuller);
 
@@ -4557,8 +4713,8 @@ RendererSceneCull::~RendererSceneCull() {
 	}
 	scene_cull_result_threads.clear();
 
-	if (dummy_occlusion_culling) {
-		memdelete(dummy_occlusion_culling);
+	if (raster_occlusion_culling) {
+		memdelete(raster_occlusion_culling);
 	}
 
 	if (light_culler) {
@@ -129,7 +129,7 @@ public:
 
 	/* VISIBILITY NOTIFIER API */
 
-	RendererSceneOcclusionCull *dummy_occlusion_culling = nullptr;
+	RendererSceneOcclusionCull *raster_occlusion_culling = nullptr; // Default backend, replaced by modules providing their own (e.g. raycast).
 
 	/* SCENARIO API */
 
@@ -254,6 +254,50 @@ public:
 		}
 	};
 
+	struct InstanceBoundsArray {
+		// Instance bounds stored as a structure of arrays, so frustum culling can test
+		// a whole block of instances per plane in a loop the compiler can vectorize.
+
+		static constexpr uint32_t CULL_BLOCK_SIZE = 256;
+
+		LocalVector<real_t> bounds[6];
+
+		_FORCE_INLINE_ uint32_t size() const {
+			return bounds[0].size();
+		}
+		_FORCE_INLINE_ void push_back(const InstanceBounds &p_bounds) {
+			for (int i = 0; i < 6; i++) {
+				bounds[i].push_back(p_bounds.bounds[i]);
+			}
+		}
+		_FORCE_INLINE_ void set(uint32_t p_index, const InstanceBounds &p_bounds) {
+			for (int i = 0; i < 6; i++) {
+				bounds[i][p_index] = p_bounds.bounds[i];
+			}
+		}
+		_FORCE_INLINE_ InstanceBounds operator[](uint32_t p_index) const {
+			InstanceBounds ret;
+			for (int i = 0; i < 6; i++) {
+				ret.bounds[i] = bounds[i][p_index];
+			}
+			return ret;
+		}
+		_FORCE_INLINE_ void pop_back() {
+			for (int i = 0; i < 6; i++) {
+				bounds[i].resize(bounds[i].size() - 1);
+			}
+		}
+		void reset() {
+			for (int i = 0; i < 6; i++) {
+				bounds[i].reset();
+			}
+		}
+
+		// Writes 1 to r_inside for each instance in [p_from, p_to) passing InstanceBounds::in_frustum(), 0 otherwise.
+		// At most CULL_BLOCK_SIZE instances are tested per call.
+		void cull_frustum(const Frustum &p_frustum, uint32_t p_from, uint32_t p_to, uint8_t *r_inside) const;
+	};
+
 	struct InstanceVisibilityNotifierData;
 
 	struct InstanceData {
@@ -323,7 +367,6 @@ public:
 		}
 	};
 
-	PagedArrayPool<InstanceBounds> instance_aabb_page_pool;
 	PagedArrayPool<InstanceData> instance_data_page_pool;
 	PagedArrayPool<InstanceVisibilityData> instance_visibility_data_page_pool;
 
@@ -335,6 +378,7 @@ public:
 		};
 
 		DynamicBVH indexers[INDEXER_MAX];
+		bool indexers_refit_pending = false; // Queued in _instance_update_scenarios.
 
 		RID self;
 
@@ -352,7 +396,7 @@ public:
 
 		LocalVector<RID> dynamic_lights;
 
-		PagedArray<InstanceBounds> instance_aabbs;
+		InstanceBoundsArray instance_aabbs;
 		PagedArray<InstanceData> instance_data;
 		VisibilityArray instance_visibility;
 
@@ -459,6 +503,7 @@ public:
 		AABB aabb;
 		AABB transformed_aabb;
 		AABB prev_transformed_aabb;
+		AABB indexer_aabb; // Quantized transformed_aabb, as stored in the scenario indexers.
 
 		struct InstanceShaderParameter {
 			int32_t index = -1;
@@ -652,8 +697,15 @@ public:
 	};
 
 	SelfList<Instance>::List _instance_update_list;
+	LocalVector<Instance *> _instance_update_batch;
+	LocalVector<Scenario *> _instance_update_scenarios;
 	void _instance_queue_update(Instance *p_instance, bool p_update_aabb, bool p_update_dependencies = false);
 
+	// Shared by the single and bulk instance setters.
+	void _instance_set_transform(Instance *p_instance, const Transform3D &p_transform);
+	void _instance_set_visible(Instance *p_instance, bool p_visible);
+	void _instance_set_custom_aabb(Instance *p_instance, const AABB &p_aabb);
+
 	struct InstanceGeometryData : public InstanceBaseData {
 		RenderGeometryInstance *geometry_instance = nullptr;
 		HashSet<Instance *> lights;
@@ -1069,6 +1121,10 @@ public:
 
 	virtual void instance_set_custom_aabb(RID p_instance, AABB p_aabb);
 
+	virtual void instances_set_transforms(const Vector<RID> &p_instances, const Vector<float> &p_transforms);
+	virtual void instances_set_custom_aabbs(const Vector<RID> &p_instances, const Vector<float> &p_aabbs);
+	virtual void instances_set_visible(const Vector<RID> &p_instances, bool p_visible);
+
 	virtual void instance_attach_skeleton(RID p_instance, RID p_skeleton);
 
 	virtual void instance_set_extra_visibility_margin(RID p_instance, real_t p_margin);
@@ -1106,14 +1162,41 @@ public:
 	virtual uint32_t get_pipeline_compilations(RS::PipelineSource p_source);
 
 	_FORCE_INLINE_ void _update_instance(Instance *p_instance);
+	_FORCE_INLINE_ void _update_instance_bounds(Instance *p_instance);
+	void _update_instance_bounds_threaded(uint32_t p_index, Instance **p_instances);
+	_FORCE_INLINE_ bool _update_instance_transform(Instance *p_instance, bool p_defer_refit);
+	_FORCE_INLINE_ void _update_instance_pairs(Instance *p_instance);
 	_FORCE_INLINE_ void _update_instance_aabb(Instance *p_instance);
+	_FORCE_INLINE_ void _update_dirty_instance_data(Instance *p_instance);
 	_FORCE_INLINE_ void _update_dirty_instance(Instance *p_instance);
 	_FORCE_INLINE_ void _update_instance_lightmap_captures(Instance *p_instance);
 	void _unpair_instance(Instance *p_instance);
 
 	void _light_instance_setup_directional_shadow(int p_shadow_index, Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect);
 
-	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_scren_mesh_lod_threshold, uint32_t p_visible_layers = 0xFFFFFF);
+	// Positional light shadows are set up first and culled together, so the BVH is walked once for many views.
+	struct ShadowCullView {
+		Instance *light = nullptr;
+		Vector<Plane> planes;
+		Vector<Vector3> points;
+		Projection projection;
+		Transform3D transform;
+		real_t radius = 0;
+		int pass = 0;
+		uint32_t shadow_index = 0; // In render_shadow_data.
+		bool animated_material_found = false;
+	};
+
+	struct ShadowCullHit {
+		Instance *instance = nullptr;
+		uint64_t view_mask = 0;
+	};
+
+	LocalVector<ShadowCullView> shadow_cull_views;
+	LocalVector<ShadowCullHit> shadow_cull_hits;
+
+	bool _light_instance_add_shadow_views(Instance *p_instance);
+	void _cull_shadow_views(Scenario *p_scenario, uint32_t p_visible_layers);
 
 	RID _render_get_environment(RID p_camera, RID p_scenario);
 	RID _render_get_compositor(RID p_camera, RID p_scenario);
@@ -39,6 +39,8 @@ class RendererSceneOcclusionCull {
 protected:
 	static RendererSceneOcclusionCull *singleton;
 
+	Projection _jitter_projection(const Projection &p_cam_projection, const Size2i &p_viewport_size);
+
 public:
 	class HZBuffer {
 	protected:
@@ -93,6 +93,10 @@ public:
 
 	virtual void instance_set_custom_aabb(RID p_instance, AABB p_aabb) = 0;
 
+	virtual void instances_set_transforms(const Vector<RID> &p_instances, const Vector<float> &p_transforms) = 0;
+	virtual void instances_set_custom_aabbs(const Vector<RID> &p_instances, const Vector<float> &p_aabbs) = 0;
+	virtual void instances_set_visible(const Vector<RID> &p_instances, bool p_visible) = 0;
+
 	virtual void instance_attach_skeleton(RID p_instance, RID p_skeleton) = 0;
 
 	virtual void instance_set_extra_visibility_margin(RID p_instance, real_t p_margin) = 0;
@@ -0,0 +1,616 @@
+/**************************************************************************/
+/*  rendering_server_benchmark.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "rendering_server_benchmark.h"
+
+#ifdef TOOLS_ENABLED
+
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "core/templates/sort_array.h"
+#include "servers/rendering/raster_occlusion_cull.h"
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+#include "servers/rendering/shader_language.h"
+#include "servers/rendering/shader_types.h"
+#include "servers/xr/xr_interface.h"
+
+const RenderingServerBenchmark::SceneSettings RenderingServerBenchmark::scene_presets[] = {
+	// Name, instances, moving instances, lights, multimesh instances, canvas items, occluders.
+	{ "instances", 20000, 2000, 0, 0, 0, 0 },
+	{ "lights", 5000, 500, 256, 0, 0, 0 },
+	{ "multimesh", 0, 0, 0, 16384, 0, 0 },
+	{ "canvas", 0, 0, 0, 0, 10000, 0 },
+	{ "occluders", 10000, 1000, 0, 0, 0, 4000 },
+	{ "mixed", 10000, 1000, 64, 4096, 2000, 0 },
+};
+
+static const Size2i BENCHMARK_VIEWPORT_SIZE = Size2i(1920, 1080);
+// Fixed instead of derived from the thread count like viewports do, so results compare across machines.
+static const Size2i BENCHMARK_OCCLUSION_BUFFER_SIZE = Size2i(480, 270);
+static const Transform3D BENCHMARK_CAMERA_TRANSFORM = Transform3D(Basis(), Vector3(0, 10, 200));
+static const float BENCHMARK_CAMERA_FOV = 75.0f;
+static const float BENCHMARK_CAMERA_NEAR = 0.05f;
+static const float BENCHMARK_CAMERA_FAR = 500.0f;
+static const uint32_t BENCHMARK_WARMUP_FRAMES = 5;
+static const uint32_t BENCHMARK_SEED = 0x9E3779B9;
+static const uint32_t CANVAS_TREE_BRANCHING = 4;
+static const uint32_t SHADER_HELPER_FUNCTION_COUNT = 32;
+
+const char *RenderingServerBenchmark::get_phase_name(Phase p_phase) {
+	switch (p_phase) {
+		case PHASE_COMMAND_QUEUE:
+			return "command_queue";
+		case PHASE_INSTANCE_UPDATES:
+			return "instance_updates";
+		case PHASE_CULLING:
+			return "culling";
+		case PHASE_CANVAS_CULLING:
+			return "canvas_culling";
+		case PHASE_OCCLUSION_RASTER:
+			return "occlusion_raster";
+		case PHASE_OCCLUSION_RAYCAST:
+			return "occlusion_raycast";
+		case PHASE_MAX:
+			break;
+	}
+	return "";
+}
+
+// Unit box, scaled into walls by the instance transforms.
+static void _get_occluder_box(PackedVector3Array &r_vertices, PackedInt32Array &r_indices) {
+	for (int i = 0; i < 8; i++) {
+		r_vertices.push_back(Vector3((i & 1) ? 0.5 : -0.5, (i & 2) ? 1.0 : 0.0, (i & 4) ? 0.5 : -0.5));
+	}
+
+	static const int32_t faces[6][4] = {
+		{ 0, 1, 3, 2 }, { 4, 6, 7, 5 }, // -Z, +Z
+		{ 0, 4, 5, 1 }, { 2, 3, 7, 6 }, // -Y, +Y
+		{ 0, 2, 6, 4 }, { 1, 5, 7, 3 }, // -X, +X
+	};
+	for (const int32_t *face : faces) {
+		r_indices.push_back(face[0]);
+		r_indices.push_back(face[1]);
+		r_indices.push_back(face[2]);
+		r_indices.push_back(face[0]);
+		r_indices.push_back(face[2]);
+		r_indices.push_back(face[3]);
+	}
+}
+
+void RenderingServerBenchmark::_create_scene() {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RandomPCG rng(BENCHMARK_SEED);
+
+	scenario = rs->scenario_create();
+
+	camera = rs->camera_create();
+	rs->camera_set_perspective(camera, BENCHMARK_CAMERA_FOV, BENCHMARK_CAMERA_NEAR, BENCHMARK_CAMERA_FAR);
+	rs->camera_set_transform(camera, BENCHMARK_CAMERA_TRANSFORM);
+
+	// The dummy mesh storage does not keep surfaces, so every geometry instance gets a custom AABB instead.
+	mesh = rs->mesh_create();
+
+	instances.resize(settings.instance_count);
+	for (uint32_t i = 0; i < settings.instance_count; i++) {
+		instances[i] = rs->instance_create2(mesh, scenario);
+		rs->instance_set_custom_aabb(instances[i], AABB(Vector3(-1, -1, -1), Vector3(2, 2, 2) * rng.random(0.5f, 4.0f)));
+		rs->instance_set_transform(instances[i], Transform3D(Basis(Vector3(0, 1, 0), rng.random(0.0f, Math_TAU)), Vector3(rng.random(-400.0f, 400.0f), rng.random(-20.0f, 40.0f), rng.random(-400.0f, 400.0f))));
+	}
+
+	lights.resize(settings.light_count);
+	light_instances.resize(settings.light_count);
+	for (uint32_t i = 0; i < settings.light_count; i++) {
+		// One directional light, the rest split between omni and spot lights.
+		if (i == 0) {
+			lights[i] = rs->directional_light_create();
+		} else if (i % 2) {
+			lights[i] = rs->omni_light_create();
+		} else {
+			lights[i] = rs->spot_light_create();
+		}
+		rs->light_set_param(lights[i], RS::LIGHT_PARAM_RANGE, rng.random(5.0f, 30.0f));
+
+		// Parameters must be set before the instance is created, as the dummy storage has no dependency tracking.
+		light_instances[i] = rs->instance_create2(lights[i], scenario);
+		rs->instance_set_transform(light_instances[i], Transform3D(Basis::from_euler(Vector3(rng.random(-Math_PI, 0.0f), rng.random(0.0f, Math_TAU), 0)), Vector3(rng.random(-400.0f, 400.0f), rng.random(0.0f, 30.0f), rng.random(-400.0f, 400.0f))));
+	}
+
+	if (settings.multimesh_instance_count > 0) {
+		multimesh = rs->multimesh_create();
+		rs->multimesh_set_mesh(multimesh, mesh);
+		rs->multimesh_allocate_data(multimesh, settings.multimesh_instance_count, RS::MULTIMESH_TRANSFORM_3D);
+		multimesh_buffer.resize(settings.multimesh_instance_count * 12);
+
+		multimesh_instance = rs->instance_create2(multimesh, scenario);
+		rs->instance_set_custom_aabb(multimesh_instance, AABB(Vector3(-100, -10, -100), Vector3(200, 20, 200)));
+	}
+
+	if (settings.occluder_count > 0) {
+		// Walls standing on the ground between the instances, like buildings in a city.
+		PackedVector3Array vertices;
+		PackedInt32Array indices;
+		_get_occluder_box(vertices, indices);
+		occluder = rs->occluder_create();
+		rs->occluder_set_mesh(occluder, vertices, indices);
+
+		occluder_instances.resize(settings.occluder_count);
+		occluder_transforms.resize(settings.occluder_count);
+		for (uint32_t i = 0; i < settings.occluder_count; i++) {
+			Basis basis = Basis(Vector3(0, 1, 0), rng.random(0.0f, Math_TAU)) * Basis::from_scale(Vector3(rng.random(4.0f, 30.0f), rng.random(3.0f, 25.0f), rng.random(0.5f, 2.0f)));
+			occluder_transforms[i] = Transform3D(basis, Vector3(rng.random(-400.0f, 400.0f), -20.0f, rng.random(-400.0f, 400.0f)));
+			occluder_instances[i] = rs->instance_create2(occluder, scenario);
+			rs->instance_set_transform(occluder_instances[i], occluder_transforms[i]);
+		}
+	}
+
+	if (settings.canvas_item_count > 0) {
+		canvas = rs->canvas_create();
+
+		// A tree of canvas items where each item is offset from its parent, like nested controls or sprites.
+		canvas_items.resize(settings.canvas_item_count);
+		for (uint32_t i = 0; i < settings.canvas_item_count; i++) {
+			canvas_items[i] = rs->canvas_item_create();
+			rs->canvas_item_set_parent(canvas_items[i], i == 0 ? canvas : canvas_items[(i - 1) / CANVAS_TREE_BRANCHING]);
+			rs->canvas_item_set_transform(canvas_items[i], Transform2D(0.0, Vector2(rng.random(-200.0f, 400.0f), rng.random(-200.0f, 400.0f))));
+			rs->canvas_item_add_rect(canvas_items[i], Rect2(0, 0, rng.random(8.0f, 64.0f), rng.random(8.0f, 64.0f)), Color(1, 1, 1));
+		}
+	}
+
+	render_buffers = RSG::scene->render_buffers_create();
+
+	rs->sync();
+}
+
+void RenderingServerBenchmark::_free_scene() {
+	RenderingServer *rs = RenderingServer::get_singleton();
+
+	for (const RID &rid : canvas_items) {
+		rs->free(rid);
+	}
+	for (const RID &rid : occluder_instances) {
+		rs->free(rid);
+	}
+	for (const RID &rid : light_instances) {
+		rs->free(rid);
+	}
+	for (const RID &rid : lights) {
+		rs->free(rid);
+	}
+	for (const RID &rid : instances) {
+		rs->free(rid);
+	}
+	canvas_items.clear();
+	occluder_instances.clear();
+	occluder_transforms.clear();
+	light_instances.clear();
+	lights.clear();
+	instances.clear();
+
+	if (canvas.is_valid()) {
+		rs->free(canvas);
+		canvas = RID();
+	}
+	if (occluder.is_valid()) {
+		rs->free(occluder);
+		occluder = RID();
+	}
+	if (multimesh_instance.is_valid()) {
+		rs->free(multimesh_instance);
+		multimesh_instance = RID();
+	}
+	if (multimesh.is_valid()) {
+		rs->free(multimesh);
+		multimesh = RID();
+	}
+	multimesh_buffer.clear();
+
+	rs->free(mesh);
+	rs->free(camera);
+	rs->free(scenario);
+	render_buffers.unref();
+
+	rs->sync();
+}
+
+void RenderingServerBenchmark::_create_occlusion_buffers() {
+	// Runs on the rendering thread. Without a viewport, the camera is used as the key of the occlusion buffers.
+	RendererSceneOcclusionCull *occlusion_cull = RendererSceneOcclusionCull::get_singleton();
+	RasterOcclusionCull *raster_occlusion_cull = RasterOcclusionCull::get_raster_singleton();
+
+	occlusion_cull->add_buffer(camera);
+	occlusion_cull->buffer_set_scenario(camera, scenario);
+	occlusion_cull->buffer_set_size(camera, BENCHMARK_OCCLUSION_BUFFER_SIZE);
+
+	if (raster_occlusion_cull == occlusion_cull) {
+		return;
+	}
+
+	// The raycast backend is active and received the occluders through the scenario,
+	// so the rasterizer is given the same occluders directly to compare both.
+	PackedVector3Array vertices;
+	PackedInt32Array indices;
+	_get_occluder_box(vertices, indices);
+	raster_occluder = raster_occlusion_cull->occluder_allocate();
+	raster_occlusion_cull->occluder_initialize(raster_occluder);
+	raster_occlusion_cull->occluder_set_mesh(raster_occluder, vertices, indices);
+
+	raster_occlusion_cull->add_scenario(scenario);
+	for (uint32_t i = 0; i < occluder_instances.size(); i++) {
+		raster_occlusion_cull->scenario_set_instance(scenario, occluder_instances[i], raster_occluder, occluder_transforms[i], true);
+	}
+
+	raster_occlusion_cull->add_buffer(camera);
+	raster_occlusion_cull->buffer_set_scenario(camera, scenario);
+	raster_occlusion_cull->buffer_set_size(camera, BENCHMARK_OCCLUSION_BUFFER_SIZE);
+}
+
+void RenderingServerBenchmark::_free_occlusion_buffers() {
+	RendererSceneOcclusionCull *occlusion_cull = RendererSceneOcclusionCull::get_singleton();
+	RasterOcclusionCull *raster_occlusion_cull = RasterOcclusionCull::get_raster_singleton();
+
+	occlusion_cull->remove_buffer(camera);
+
+	if (raster_occlusion_cull == occlusion_cull) {
+		return;
+	}
+
+	raster_occlusion_cull->remove_buffer(camera);
+	for (const RID &rid : occluder_instances) {
+		raster_occlusion_cull->scenario_remove_instance(scenario, rid);
+	}
+	raster_occlusion_cull->remove_scenario(scenario);
+	raster_occlusion_cull->free_occluder(raster_occluder);
+	raster_occluder = RID();
+}
+
+void RenderingServerBenchmark::_issue_frame_commands(uint32_t p_frame) {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	const float time = p_frame / 60.0f;
+
+	for (uint32_t i = 0; i < settings.moving_instance_count && i < instances.size(); i++) {
+		const float phase = time + i * 0.37f;
+		Vector3 origin = Vector3(Math::sin(phase) * 400.0f, Math::cos(phase * 0.5f) * 20.0f, Math::cos(phase) * 400.0f);
+		rs->instance_set_transform(instances[i], Transform3D(Basis(Vector3(0, 1, 0), phase), origin));
+	}
+
+	if (multimesh.is_valid()) {
+		float *w = multimesh_buffer.ptrw();
+		for (uint32_t i = 0; i < settings.multimesh_instance_count; i++) {
+			const float phase = time + i * 0.11f;
+			float *t = &w[i * 12];
+			t[0] = 1.0f;
+			t[1] = 0.0f;
+			t[2] = 0.0f;
+			t[3] = Math::sin(phase) * 100.0f;
+			t[4] = 0.0f;
+			t[5] = 1.0f;
+			t[6] = 0.0f;
+			t[7] = Math::sin(phase * 0.5f) * 10.0f;
+			t[8] = 0.0f;
+			t[9] = 0.0f;
+			t[10] = 1.0f;
+			t[11] = Math::cos(phase) * 100.0f;
+		}
+		rs->multimesh_set_buffer(multimesh, multimesh_buffer);
+	}
+
+	// Move a tenth of the canvas items each frame, spread over the whole tree.
+	for (uint32_t i = p_frame % 10; i < canvas_items.size(); i += 10) {
+		const float phase = time + i * 0.23f;
+		rs->canvas_item_set_transform(canvas_items[i], Transform2D(phase * 0.1f, Vector2(Math::sin(phase) * 300.0f + 100.0f, Math::cos(phase) * 300.0f + 100.0f)));
+	}
+}
+
+void RenderingServerBenchmark::_render_frame() {
+	// Runs on the rendering thread, mirroring the order of RenderingServerDefault::_draw().
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	RSG::scene->update();
+	uint64_t end = OS::get_singleton()->get_ticks_usec();
+	phase_usec[PHASE_INSTANCE_UPDATES].push_back(end - begin);
+
+	begin = end;
+	Ref<XRInterface> xr_interface;
+	// Without a viewport, this doesn't use occlusion culling. The occlusion buffers are timed separately below.
+	RSG::scene->render_camera(render_buffers, camera, scenario, RID(), BENCHMARK_VIEWPORT_SIZE, 0, 1.0, RID(), xr_interface, nullptr);
+	end = OS::get_singleton()->get_ticks_usec();
+	phase_usec[PHASE_CULLING].push_back(end - begin);
+
+	begin = end;
+	RendererCanvasCull::Canvas *canvas_ptr = RSG::canvas->canvas_owner.get_or_null(canvas);
+	if (canvas_ptr) {
+		RSG::canvas->render_canvas(RID(), canvas_ptr, Transform2D(), nullptr, nullptr, Rect2(Point2(), BENCHMARK_VIEWPORT_SIZE), RS::CANVAS_ITEM_TEXTURE_FILTER_LINEAR, RS::CANVAS_ITEM_TEXTURE_REPEAT_DISABLED, false, false, 0xFFFFFFFF);
+	}
+	end = OS::get_singleton()->get_ticks_usec();
+	phase_usec[PHASE_CANVAS_CULLING].push_back(end - begin);
+
+	if (settings.occluder_count == 0) {
+		return;
+	}
+
+	RendererSceneOcclusionCull *occlusion_cull = RendererSceneOcclusionCull::get_singleton();
+	RasterOcclusionCull *raster_occlusion_cull = RasterOcclusionCull::get_raster_singleton();
+	Projection cam_projection;
+	cam_projection.set_perspective(BENCHMARK_CAMERA_FOV, BENCHMARK_VIEWPORT_SIZE.aspect(), BENCHMARK_CAMERA_NEAR, BENCHMARK_CAMERA_FAR);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	raster_occlusion_cull->buffer_update(camera, BENCHMARK_CAMERA_TRANSFORM, cam_projection, false);
+	end = OS::get_singleton()->get_ticks_usec();
+	phase_usec[PHASE_OCCLUSION_RASTER].push_back(end - begin);
+
+	if (occlusion_cull != raster_occlusion_cull) {
+		begin = end;
+		occlusion_cull->buffer_update(camera, BENCHMARK_CAMERA_TRANSFORM, cam_projection, false);
+		end = OS::get_singleton()->get_ticks_usec();
+		phase_usec[PHASE_OCCLUSION_RAYCAST].push_back(end - begin);
+	}
+}
+
+Dictionary RenderingServerBenchmark::_get_sample_stats(LocalVector<uint64_t> &p_samples) {
+	SortArray<uint64_t> sorter;
+	sorter.sort(p_samples.ptr(), p_samples.size());
+
+	uint64_t total = 0;
+	for (uint64_t sample : p_samples) {
+		total += sample;
+	}
+
+	Dictionary stats;
+	stats["average_msec"] = double(total) / p_samples.size() / 1000.0;
+	stats["median_msec"] = p_samples[p_samples.size() / 2] / 1000.0;
+	stats["min_msec"] = p_samples[0] / 1000.0;
+	stats["max_msec"] = p_samples[p_samples.size() - 1] / 1000.0;
+	return stats;
+}
+
+Dictionary RenderingServerBenchmark::_run_scene(const SceneSettings &p_settings, uint32_t p_frame_count) {
+	RenderingServer *rs = RenderingServer::get_singleton();
+
+	settings = p_settings;
+	for (uint32_t i = 0; i < PHASE_MAX; i++) {
+		phase_usec[i].clear();
+	}
+
+	_create_scene();
+
+	if (settings.occluder_count > 0) {
+		rs->call_on_render_thread(callable_mp(this, &RenderingServerBenchmark::_create_occlusion_buffers));
+		rs->sync();
+	}
+
+	for (uint32_t frame = 0; frame < BENCHMARK_WARMUP_FRAMES + p_frame_count; frame++) {
+		// With a separate rendering thread, this measures pushing the commands and waiting for the queue to drain.
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		_issue_frame_commands(frame);
+		rs->sync();
+		phase_usec[PHASE_COMMAND_QUEUE].push_back(OS::get_singleton()->get_ticks_usec() - begin);
+
+		rs->call_on_render_thread(callable_mp(this, &RenderingServerBenchmark::_render_frame));
+		rs->sync();
+	}
+
+	if (settings.occluder_count > 0) {
+		rs->call_on_render_thread(callable_mp(this, &RenderingServerBenchmark::_free_occlusion_buffers));
+		rs->sync();
+	}
+
+	_free_scene();
+
+	Dictionary phases;
+	for (uint32_t i = 0; i < PHASE_MAX; i++) {
+		// Drop the warmup frames, they include building the BVHs and the first pairing pass.
+		LocalVector<uint64_t> samples;
+		for (uint32_t j = BENCHMARK_WARMUP_FRAMES; j < phase_usec[i].size(); j++) {
+			samples.push_back(phase_usec[i][j]);
+		}
+		if (samples.is_empty()) {
+			// Occlusion phases only run in scenes with occluders, and with the backends available.
+			continue;
+		}
+
+		phases[get_phase_name(Phase(i))] = _get_sample_stats(samples);
+	}
+
+	Dictionary result;
+	result["instances"] = p_settings.instance_count;
+	result["moving_instances"] = p_settings.moving_instance_count;
+	result["lights"] = p_settings.light_count;
+	result["multimesh_instances"] = p_settings.multimesh_instance_count;
+	result["canvas_items"] = p_settings.canvas_item_count;
+	result["occluders"] = p_settings.occluder_count;
+	result["phases"] = phases;
+	return result;
+}
+
+// Builds a shader of the given mode with a chain of helper functions using
+// structs, loops, branches, swizzles and built-in calls, so the tokenizer and
+// parser see the constructs of typical hand-written shaders.
+static String _generate_shader(RS::ShaderMode p_mode) {
+	String code;
+	switch (p_mode) {
+		case RS::SHADER_SPATIAL:
+			code += "shader_type spatial;\nrender_mode cull_disabled, depth_prepass_alpha;\n\n";
+			break;
+		case RS::SHADER_CANVAS_ITEM:
+			code += "shader_type canvas_item;\nrender_mode blend_mix;\n\n";
+			break;
+		case RS::SHADER_PARTICLES:
+			code += "shader_type particles;\n\n";
+			break;
+		default:
+			ERR_FAIL_V(String());
+	}
+
+	code += "const int ITERATIONS = 4;\n";
+	code += "const float WEIGHTS[4] = { 0.1, 0.35, 0.6, 1.0 };\n\n";
+	code += "struct Layer {\n\tvec3 color;\n\tfloat weight;\n};\n\n";
+	code += "uniform vec3 tint : source_color = vec3(0.8, 0.3, 0.2);\n";
+	code += "uniform float strength : hint_range(0.0, 1.0) = 0.5;\n";
+	code += "uniform int octaves : hint_range(1, 8) = 3;\n";
+	if (p_mode != RS::SHADER_PARTICLES) {
+		code += "uniform sampler2D noise_texture : filter_linear_mipmap, repeat_enable;\n";
+	}
+	code += "\n";
+
+	for (uint32_t i = 0; i < SHADER_HELPER_FUNCTION_COUNT; i++) {
+		code += vformat("float helper_%d(vec3 p_value, Layer p_layer) {\n", i);
+		code += "\tfloat result = 0.0;\n";
+		code += "\tfor (int i = 0; i < ITERATIONS; i++) {\n";
+		code += vformat("\t\tresult += dot(p_value.zxy * float(i + %d), p_layer.color) * WEIGHTS[i] * p_layer.weight;\n", i);
+		code += "\t\tif (result > 10.0) {\n\t\t\tresult = fract(result);\n\t\t} else if (result < -10.0) {\n\t\t\tbreak;\n\t\t}\n";
+		code += "\t}\n";
+		if (i > 0) {
+			code += vformat("\treturn mix(result, helper_%d(p_value.yzx, p_layer), clamp(strength, 0.0, 1.0));\n", i - 1);
+		} else {
+			code += "\treturn smoothstep(0.0, 1.0, sin(result) * 0.5 + 0.5);\n";
+		}
+		code += "}\n\n";
+	}
+
+	const String last_helper = vformat("helper_%d", SHADER_HELPER_FUNCTION_COUNT - 1);
+	switch (p_mode) {
+		case RS::SHADER_SPATIAL:
+			code += "void vertex() {\n";
+			code += "\tfloat offset = 0.0;\n";
+			code += "\tfor (int i = 1; i <= octaves; i++) {\n\t\toffset += sin(VERTEX.x * float(i) * 3.0 + TIME * float(i)) / float(i);\n\t}\n";
+			code += "\tVERTEX += NORMAL * offset * " + last_helper + "(VERTEX, Layer(tint, strength)) * 0.05;\n";
+			code += "}\n\n";
+			code += "void fragment() {\n";
+			code += "\tLayer layer = Layer(tint, strength);\n";
+			code += "\tvec4 noise = texture(noise_texture, UV * 4.0);\n";
+			code += "\tALBEDO = mix(layer.color, noise.rgb, clamp(" + last_helper + "(noise.xyz, layer), 0.0, 1.0));\n";
+			code += "\tROUGHNESS = 1.0 - noise.a;\n";
+			code += "}\n\n";
+			code += "void light() {\n";
+			code += "\tfloat ndotl = clamp(dot(NORMAL, LIGHT), 0.0, 1.0);\n";
+			code += "\tDIFFUSE_LIGHT += ALBEDO * LIGHT_COLOR * ATTENUATION * step(0.5, ndotl);\n";
+			code += "}\n";
+			break;
+		case RS::SHADER_CANVAS_ITEM:
+			code += "void vertex() {\n";
+			code += "\tVERTEX += vec2(" + last_helper + "(vec3(VERTEX, TIME), Layer(tint, strength)));\n";
+			code += "}\n\n";
+			code += "void fragment() {\n";
+			code += "\tvec4 color = texture(TEXTURE, UV);\n";
+			code += "\tvec4 noise = texture(noise_texture, UV);\n";
+			code += "\tCOLOR = vec4(mix(color.rgb, tint, " + last_helper + "(noise.rgb, Layer(color.rgb, strength))), color.a);\n";
+			code += "}\n";
+			break;
+		case RS::SHADER_PARTICLES:
+			code += "void start() {\n";
+			code += "\tTRANSFORM[3].xyz = vec3(float(INDEX % 16u), 0.0, float(INDEX / 16u));\n";
+			code += "\tVELOCITY = vec3(0.0, " + last_helper + "(TRANSFORM[3].xyz, Layer(tint, strength)), 0.0);\n";
+			code += "}\n\n";
+			code += "void process() {\n";
+			code += "\tVELOCITY += vec3(0.0, -9.8, 0.0) * DELTA;\n";
+			code += "\tCOLOR.rgb = tint * " + last_helper + "(VELOCITY, Layer(tint, strength));\n";
+			code += "}\n";
+			break;
+		default:
+			break;
+	}
+
+	return code;
+}
+
+Dictionary RenderingServerBenchmark::_run_shader_language(uint32_t p_pass_count) {
+	const RS::ShaderMode modes[] = { RS::SHADER_SPATIAL, RS::SHADER_CANVAS_ITEM, RS::SHADER_PARTICLES };
+
+	LocalVector<String> corpus;
+	LocalVector<ShaderLanguage::ShaderCompileInfo> compile_infos;
+	for (RS::ShaderMode mode : modes) {
+		corpus.push_back(_generate_shader(mode));
+
+		ShaderLanguage::ShaderCompileInfo info;
+		info.functions = ShaderTypes::get_singleton()->get_functions(mode);
+		info.render_modes = ShaderTypes::get_singleton()->get_modes(mode);
+		info.shader_types = ShaderTypes::get_singleton()->get_types();
+		compile_infos.push_back(info);
+	}
+
+	// The same parser is reused for every shader, like in ShaderCompiler.
+	ShaderLanguage parser;
+	LocalVector<uint64_t> pass_usec;
+	for (uint32_t pass = 0; pass < BENCHMARK_WARMUP_FRAMES + p_pass_count; pass++) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < corpus.size(); i++) {
+			Error err = parser.compile(corpus[i], compile_infos[i]);
+			ERR_FAIL_COND_V_MSG(err != OK, Dictionary(), vformat("Benchmark shader failed to compile at line %d: %s", parser.get_error_line(), parser.get_error_text()));
+		}
+		if (pass >= BENCHMARK_WARMUP_FRAMES) {
+			pass_usec.push_back(OS::get_singleton()->get_ticks_usec() - begin);
+		}
+	}
+
+	Dictionary result;
+	result["shaders"] = corpus.size();
+	result["helper_functions"] = SHADER_HELPER_FUNCTION_COUNT;
+	result["compile"] = _get_sample_stats(pass_usec);
+	return result;
+}
+
+Dictionary RenderingServerBenchmark::run(uint32_t p_frame_count) {
+	ERR_FAIL_NULL_V(RSG::scene, Dictionary());
+	ERR_FAIL_NULL_V(RSG::canvas, Dictionary());
+	ERR_FAIL_COND_V(p_frame_count == 0, Dictionary());
+
+	Dictionary scenes;
+	for (const SceneSettings &preset : scene_presets) {
+		print_line(vformat("Benchmarking rendering server scene \"%s\"...", preset.name));
+		scenes[preset.name] = _run_scene(preset, p_frame_count);
+	}
+
+	print_line("Benchmarking shader language...");
+
+	Dictionary result;
+	result["frames"] = p_frame_count;
+	result["threaded"] = RSG::threaded;
+	result["scenes"] = scenes;
+	result["shader_language"] = _run_shader_language(p_frame_count);
+	return result;
+}
+
+Error RenderingServerBenchmark::run_and_save(const String &p_path, uint32_t p_frame_count) {
+	RenderingServerBenchmark *benchmark = memnew(RenderingServerBenchmark);
+	Dictionary result = benchmark->run(p_frame_count);
+	memdelete(benchmark);
+	ERR_FAIL_COND_V(result.is_empty(), FAILED);
+
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_CANT_CREATE, vformat("Cannot open file '%s' for writing.", p_path));
+	f->store_string(JSON::stringify(result, "\t", false) + "\n");
+
+	print_line(vformat("Rendering server benchmark results saved to \"%s\".", p_path));
+	return OK;
+}
+
+#endif // TOOLS_ENABLED
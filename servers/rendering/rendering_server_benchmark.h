@@ -0,0 +1,112 @@
+/**************************************************************************/
+/*  rendering_server_benchmark.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef RENDERING_SERVER_BENCHMARK_H
+#define RENDERING_SERVER_BENCHMARK_H
+
+#ifdef TOOLS_ENABLED
+
+#include "core/object/object.h"
+#include "core/templates/local_vector.h"
+#include "servers/rendering/storage/render_scene_buffers.h"
+
+// Replays synthetic scenes through the rendering server front end on the dummy
+// rasterizer and reports the CPU cost of each frame phase, so regressions in
+// RendererSceneCull and RendererCanvasCull can be tracked on machines without a GPU.
+// Also times ShaderLanguage on a generated shader corpus.
+class RenderingServerBenchmark : public Object {
+	GDCLASS(RenderingServerBenchmark, Object);
+
+public:
+	struct SceneSettings {
+		const char *name = "";
+		uint32_t instance_count = 0;
+		uint32_t moving_instance_count = 0;
+		uint32_t light_count = 0;
+		uint32_t multimesh_instance_count = 0;
+		uint32_t canvas_item_count = 0;
+		uint32_t occluder_count = 0;
+	};
+
+	enum Phase {
+		PHASE_COMMAND_QUEUE,
+		PHASE_INSTANCE_UPDATES,
+		PHASE_CULLING,
+		PHASE_CANVAS_CULLING,
+		PHASE_OCCLUSION_RASTER,
+		PHASE_OCCLUSION_RAYCAST,
+		PHASE_MAX,
+	};
+
+private:
+	static const SceneSettings scene_presets[];
+
+	SceneSettings settings;
+
+	RID scenario;
+	RID camera;
+	RID mesh;
+	RID multimesh;
+	RID multimesh_instance;
+	RID canvas;
+	RID occluder;
+	RID raster_occluder;
+	LocalVector<RID> instances;
+	LocalVector<RID> occluder_instances;
+	LocalVector<Transform3D> occluder_transforms;
+	LocalVector<RID> lights;
+	LocalVector<RID> light_instances;
+	LocalVector<RID> canvas_items;
+	Vector<float> multimesh_buffer;
+	Ref<RenderSceneBuffers> render_buffers;
+
+	LocalVector<uint64_t> phase_usec[PHASE_MAX];
+
+	void _create_scene();
+	void _create_occlusion_buffers();
+	void _free_occlusion_buffers();
+	void _free_scene();
+	void _issue_frame_commands(uint32_t p_frame);
+	void _render_frame();
+	Dictionary _run_scene(const SceneSettings &p_settings, uint32_t p_frame_count);
+	Dictionary _run_shader_language(uint32_t p_pass_count);
+
+	static Dictionary _get_sample_stats(LocalVector<uint64_t> &p_samples);
+
+public:
+	static const char *get_phase_name(Phase p_phase);
+
+	Dictionary run(uint32_t p_frame_count);
+	static Error run_and_save(const String &p_path, uint32_t p_frame_count = 120);
+};
+
+#endif // TOOLS_ENABLED
+
+#endif // RENDERING_SERVER_BENCHMARK_H
@@ -291,6 +291,10 @@ uint64_t RenderingServerDefault::get_rendering_info(RenderingInfo p_info) {
 		return RSG::canvas_render->get_pipeline_compilations(PIPELINE_SOURCE_DRAW) + RSG::scene->get_pipeline_compilations(PIPELINE_SOURCE_DRAW);
 	} else if (p_info == RENDERING_INFO_PIPELINE_COMPILATIONS_SPECIALIZATION) {
 		return RSG::canvas_render->get_pipeline_compilations(PIPELINE_SOURCE_SPECIALIZATION) + RSG::scene->get_pipeline_compilations(PIPELINE_SOURCE_SPECIALIZATION);
+	} else if (p_info == RENDERING_INFO_CANVAS_MERGED_BATCHES_IN_FRAME) {
+		return RSG::canvas->get_merged_batch_count();
+	} else if (p_info == RENDERING_INFO_CANVAS_MERGED_ITEMS_IN_FRAME) {
+		return RSG::canvas->get_merged_item_count();
 	}
 	return RSG::utilities->get_rendering_info(p_info);
 }
@@ -879,6 +879,10 @@ public:
 
 	FUNC2(instance_set_custom_aabb, RID, AABB)
 
+	FUNC2(instances_set_transforms, const Vector<RID> &, const Vector<float> &)
+	FUNC2(instances_set_custom_aabbs, const Vector<RID> &, const Vector<float> &)
+	FUNC2(instances_set_visible, const Vector<RID> &, bool)
+
 	FUNC2(instance_attach_skeleton, RID, RID)
 
 	FUNC2(instance_set_extra_visibility_margin, RID, real_t)
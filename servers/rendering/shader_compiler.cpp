@@ -31,7 +31,11 @@
 #include "shader_compiler.h"
 
 #include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
 #include "core/os/os.h"
+#include "core/string/string_builder.h"
+#include "core/version.h"
 #include "servers/rendering/rendering_server_globals.h"
 #include "servers/rendering/shader_types.h"
 
@@ -1471,7 +1475,74 @@ ShaderLanguage::DataType ShaderCompiler::_get_global_shader_uniform_type(const S
 	return (ShaderLanguage::DataType)RS::global_shader_uniform_type_get_shader_datatype(gvt);
 }
 
+static void _record_flags(const HashMap<StringName, bool *> &p_flags, LocalVector<StringName> &r_names, LocalVector<bool> &r_values, HashMap<StringName, bool *> &r_recording) {
+	for (const KeyValue<StringName, bool *> &E : p_flags) {
+		r_names.push_back(E.key);
+	}
+	r_values.resize(r_names.size());
+	for (uint32_t i = 0; i < r_names.size(); i++) {
+		r_values[i] = false;
+		r_recording[r_names[i]] = &r_values[i];
+	}
+}
+
+static void _get_recorded_flags(const LocalVector<StringName> &p_names, const LocalVector<bool> &p_values, LocalVector<StringName> &r_set) {
+	for (uint32_t i = 0; i < p_names.size(); i++) {
+		if (p_values[i]) {
+			r_set.push_back(p_names[i]);
+		}
+	}
+}
+
+static void _store_strings(const Ref<FileAccess> &p_file, const Vector<String> &p_strings) {
+	p_file->store_32(p_strings.size());
+	for (const String &string : p_strings) {
+		p_file->store_pascal_string(string);
+	}
+}
+
+static void _get_strings(const Ref<FileAccess> &p_file, Vector<String> &r_strings) {
+	uint32_t count = p_file->get_32();
+	ERR_FAIL_COND(count > p_file->get_length());
+	r_strings.resize(count);
+	for (String &string : r_strings) {
+		string = p_file->get_pascal_string();
+	}
+}
+
+static void _store_names(const Ref<FileAccess> &p_file, const LocalVector<StringName> &p_names) {
+	p_file->store_32(p_names.size());
+	for (const StringName &name : p_names) {
+		p_file->store_pascal_string(name);
+	}
+}
+
+static void _get_names(const Ref<FileAccess> &p_file, LocalVector<StringName> &r_names) {
+	uint32_t count = p_file->get_32();
+	ERR_FAIL_COND(count > p_file->get_length());
+	r_names.resize(count);
+	for (StringName &name : r_names) {
+		name = p_file->get_pascal_string();
+	}
+}
+
 Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+	const String cache_key = _get_cache_key(p_mode, p_code, *p_actions);
+	const CacheEntry *cached = compile_cache.getptr(cache_key);
+	if (cached && !_is_cache_entry_valid(*cached)) {
+		cached = nullptr;
+	}
+	if (!cached && !shader_cache_dir.is_empty()) {
+		CacheEntry entry;
+		if (_load_from_cache(cache_key, entry) && _is_cache_entry_valid(entry)) {
+			cached = compile_cache.insert(cache_key, entry);
+		}
+	}
+	if (cached) {
+		_apply_cache_entry(*cached, p_actions, r_gen_code);
+		return OK;
+	}
+
 	SL::ShaderCompileInfo info;
 	info.functions = ShaderTypes::get_singleton()->get_functions(p_mode);
 	info.render_modes = ShaderTypes::get_singleton()->get_modes(p_mode);
@@ -1554,34 +1625,379 @@ Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, Ident
 		return err;
 	}
 
-	r_gen_code.defines.clear();
-	r_gen_code.code.clear();
-	for (int i = 0; i < STAGE_MAX; i++) {
-		r_gen_code.stage_globals[i] = String();
-	}
-	r_gen_code.uses_fragment_time = false;
-	r_gen_code.uses_vertex_time = false;
-	r_gen_code.uses_global_textures = false;
-	r_gen_code.uses_screen_texture_mipmaps = false;
-	r_gen_code.uses_screen_texture = false;
-	r_gen_code.uses_depth_texture = false;
-	r_gen_code.uses_normal_roughness_texture = false;
-
 	used_name_defines.clear();
 	used_rmode_defines.clear();
 	used_flag_pointers.clear();
 	fragment_varyings.clear();
 
+	// Point the identifier actions at local storage, to record what the shader sets.
+	CacheEntry entry;
+	IdentifierActions recording;
+	recording.entry_point_stages = p_actions->entry_point_stages;
+	recording.uniforms = &entry.uniforms;
+
+	// Render mode values that share a pointer overwrite each other, so only the
+	// last one written to each pointer is kept.
+	HashMap<int *, uint32_t> value_slots;
+	LocalVector<StringName> value_names;
+	for (const KeyValue<StringName, Pair<int *, int>> &E : p_actions->render_mode_values) {
+		if (!value_slots.has(E.value.first)) {
+			value_slots.insert(E.value.first, value_slots.size());
+		}
+		value_names.push_back(E.key);
+	}
+	LocalVector<int> values;
+	values.resize(value_slots.size());
+	for (int &value : values) {
+		value = 0;
+	}
+	for (uint32_t i = 0; i < value_names.size(); i++) {
+		recording.render_mode_values[value_names[i]] = Pair<int *, int>(&values[value_slots[p_actions->render_mode_values[value_names[i]].first]], i + 1);
+	}
+
+	LocalVector<StringName> render_mode_flag_names;
+	LocalVector<bool> render_mode_flags;
+	_record_flags(p_actions->render_mode_flags, render_mode_flag_names, render_mode_flags, recording.render_mode_flags);
+	LocalVector<StringName> usage_flag_names;
+	LocalVector<bool> usage_flags;
+	_record_flags(p_actions->usage_flag_pointers, usage_flag_names, usage_flags, recording.usage_flag_pointers);
+	LocalVector<StringName> write_flag_names;
+	LocalVector<bool> write_flags;
+	_record_flags(p_actions->write_flag_pointers, write_flag_names, write_flags, recording.write_flag_pointers);
+
 	shader = parser.get_shader();
 	function = nullptr;
-	_dump_node_code(shader, 1, r_gen_code, *p_actions, actions, false);
+	_dump_node_code(shader, 1, entry.gen_code, recording, actions, false);
+
+	for (int value : values) {
+		if (value > 0) {
+			entry.render_mode_values.push_back(value_names[value - 1]);
+		}
+	}
+	_get_recorded_flags(render_mode_flag_names, render_mode_flags, entry.render_mode_flags);
+	_get_recorded_flags(usage_flag_names, usage_flags, entry.usage_flags);
+	_get_recorded_flags(write_flag_names, write_flags, entry.write_flags);
+
+	compile_cache.insert(cache_key, entry);
+	if (!shader_cache_dir.is_empty()) {
+		_save_to_cache(cache_key, entry);
+	}
 
+	_apply_cache_entry(entry, p_actions, r_gen_code);
 	return OK;
 }
 
+String ShaderCompiler::_get_cache_key(RS::ShaderMode p_mode, const String &p_code, const IdentifierActions &p_actions) const {
+	StringBuilder key;
+	key.append("[version]");
+	key.append(VERSION_HASH);
+	key.append("[mode]");
+	key.append(itos(p_mode));
+	key.append("[default_actions]");
+	key.append(actions_hash);
+
+	// Parsing and code generation also depend on these.
+	key.append("[low_end]");
+	key.append(RS::get_singleton()->is_low_end() ? "1" : "0");
+	key.append("[rendering_method]");
+	key.append(OS::get_singleton()->get_current_rendering_method());
+	key.append("[editor]");
+	key.append(Engine::get_singleton()->is_editor_hint() ? "1" : "0");
+
+	key.append("[actions]");
+	for (const KeyValue<StringName, Stage> &E : p_actions.entry_point_stages) {
+		key.append(String(E.key) + ":" + itos(E.value) + ";");
+	}
+	for (const KeyValue<StringName, Pair<int *, int>> &E : p_actions.render_mode_values) {
+		key.append(String(E.key) + ";");
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions.render_mode_flags) {
+		key.append(String(E.key) + ";");
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions.usage_flag_pointers) {
+		key.append(String(E.key) + ";");
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions.write_flag_pointers) {
+		key.append(String(E.key) + ";");
+	}
+
+	key.append("[code]");
+	key.append(p_code);
+
+	return key.as_string().sha256_text();
+}
+
+bool ShaderCompiler::_is_cache_entry_valid(const CacheEntry &p_entry) const {
+	if (!Engine::get_singleton()->is_editor_hint()) {
+		return true;
+	}
+
+	// Global uniform types are only checked by the parser in the editor, where
+	// they can also change after the shader was cached.
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : p_entry.uniforms) {
+		if (E.value.scope == SL::ShaderNode::Uniform::SCOPE_GLOBAL && _get_global_shader_uniform_type(E.key) != E.value.type) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void ShaderCompiler::_apply_cache_entry(const CacheEntry &p_entry, IdentifierActions *p_actions, GeneratedCode &r_gen_code) const {
+	for (const StringName &name : p_entry.render_mode_values) {
+		const Pair<int *, int> *value = p_actions->render_mode_values.getptr(name);
+		if (value) {
+			*value->first = value->second;
+		}
+	}
+	for (const StringName &name : p_entry.render_mode_flags) {
+		bool **flag = p_actions->render_mode_flags.getptr(name);
+		if (flag) {
+			**flag = true;
+		}
+	}
+	for (const StringName &name : p_entry.usage_flags) {
+		bool **flag = p_actions->usage_flag_pointers.getptr(name);
+		if (flag) {
+			**flag = true;
+		}
+	}
+	for (const StringName &name : p_entry.write_flags) {
+		bool **flag = p_actions->write_flag_pointers.getptr(name);
+		if (flag) {
+			**flag = true;
+		}
+	}
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : p_entry.uniforms) {
+		p_actions->uniforms->insert(E.key, E.value);
+	}
+
+	r_gen_code = p_entry.gen_code;
+}
+
+static const char *compiler_cache_header = "GDSC";
+static const uint32_t compiler_cache_version = 1;
+
+bool ShaderCompiler::_load_from_cache(const String &p_key, CacheEntry &r_entry) const {
+	Ref<FileAccess> f = FileAccess::open(shader_cache_dir.path_join(p_key + ".cache"), FileAccess::READ);
+	if (f.is_null()) {
+		return false;
+	}
+
+	char header[5] = { 0, 0, 0, 0, 0 };
+	f->get_buffer((uint8_t *)header, 4);
+	ERR_FAIL_COND_V(header != String(compiler_cache_header), false);
+
+	if (f->get_32() != compiler_cache_version) {
+		return false; // Wrong version.
+	}
+
+	GeneratedCode &gen_code = r_entry.gen_code;
+	_get_strings(f, gen_code.defines);
+
+	uint32_t texture_count = f->get_32();
+	ERR_FAIL_COND_V(texture_count > f->get_length(), false);
+	gen_code.texture_uniforms.resize(texture_count);
+	for (GeneratedCode::Texture &texture : gen_code.texture_uniforms) {
+		texture.name = f->get_pascal_string();
+		texture.type = SL::DataType(f->get_32());
+		texture.hint = SL::ShaderNode::Uniform::Hint(f->get_32());
+		texture.use_color = f->get_8();
+		texture.filter = SL::TextureFilter(f->get_32());
+		texture.repeat = SL::TextureRepeat(f->get_32());
+		texture.global = f->get_8();
+		texture.array_size = f->get_32();
+	}
+
+	uint32_t offset_count = f->get_32();
+	ERR_FAIL_COND_V(offset_count > f->get_length(), false);
+	gen_code.uniform_offsets.resize(offset_count);
+	for (uint32_t &offset : gen_code.uniform_offsets) {
+		offset = f->get_32();
+	}
+	gen_code.uniform_total_size = f->get_32();
+	gen_code.uniforms = f->get_pascal_string();
+	for (int i = 0; i < STAGE_MAX; i++) {
+		gen_code.stage_globals[i] = f->get_pascal_string();
+	}
+
+	uint32_t code_count = f->get_32();
+	ERR_FAIL_COND_V(code_count > f->get_length(), false);
+	for (uint32_t i = 0; i < code_count; i++) {
+		String name = f->get_pascal_string();
+		gen_code.code[name] = f->get_pascal_string();
+	}
+
+	gen_code.uses_global_textures = f->get_8();
+	gen_code.uses_fragment_time = f->get_8();
+	gen_code.uses_vertex_time = f->get_8();
+	gen_code.uses_screen_texture_mipmaps = f->get_8();
+	gen_code.uses_screen_texture = f->get_8();
+	gen_code.uses_depth_texture = f->get_8();
+	gen_code.uses_normal_roughness_texture = f->get_8();
+
+	_get_names(f, r_entry.render_mode_values);
+	_get_names(f, r_entry.render_mode_flags);
+	_get_names(f, r_entry.usage_flags);
+	_get_names(f, r_entry.write_flags);
+
+	uint32_t uniform_count = f->get_32();
+	ERR_FAIL_COND_V(uniform_count > f->get_length(), false);
+	for (uint32_t i = 0; i < uniform_count; i++) {
+		StringName name = f->get_pascal_string();
+		SL::ShaderNode::Uniform uniform;
+		uniform.order = f->get_32();
+		uniform.prop_order = f->get_32();
+		uniform.texture_order = f->get_32();
+		uniform.texture_binding = f->get_32();
+		uniform.type = SL::DataType(f->get_32());
+		uniform.precision = SL::DataPrecision(f->get_32());
+		uniform.array_size = f->get_32();
+		uint32_t value_count = f->get_32();
+		ERR_FAIL_COND_V(value_count > f->get_length(), false);
+		uniform.default_value.resize(value_count);
+		for (SL::Scalar &value : uniform.default_value) {
+			value.uint = f->get_32();
+		}
+		uniform.scope = SL::ShaderNode::Uniform::Scope(f->get_32());
+		uniform.hint = SL::ShaderNode::Uniform::Hint(f->get_32());
+		uniform.use_color = f->get_8();
+		uniform.filter = SL::TextureFilter(f->get_32());
+		uniform.repeat = SL::TextureRepeat(f->get_32());
+		for (int j = 0; j < 3; j++) {
+			uniform.hint_range[j] = f->get_float();
+		}
+		Vector<String> enum_names;
+		_get_strings(f, enum_names);
+		uniform.hint_enum_names = enum_names;
+		uniform.instance_index = f->get_32();
+		uniform.group = f->get_pascal_string();
+		uniform.subgroup = f->get_pascal_string();
+		r_entry.uniforms.insert(name, uniform);
+	}
+
+	// A truncated file reads past the end.
+	return f->get_error() == OK;
+}
+
+void ShaderCompiler::_save_to_cache(const String &p_key, const CacheEntry &p_entry) const {
+	Ref<FileAccess> f = FileAccess::open(shader_cache_dir.path_join(p_key + ".cache"), FileAccess::WRITE);
+	ERR_FAIL_COND(f.is_null());
+	f->store_buffer((const uint8_t *)compiler_cache_header, 4);
+	f->store_32(compiler_cache_version);
+
+	const GeneratedCode &gen_code = p_entry.gen_code;
+	_store_strings(f, gen_code.defines);
+
+	f->store_32(gen_code.texture_uniforms.size());
+	for (const GeneratedCode::Texture &texture : gen_code.texture_uniforms) {
+		f->store_pascal_string(texture.name);
+		f->store_32(texture.type);
+		f->store_32(texture.hint);
+		f->store_8(texture.use_color);
+		f->store_32(texture.filter);
+		f->store_32(texture.repeat);
+		f->store_8(texture.global);
+		f->store_32(texture.array_size);
+	}
+
+	f->store_32(gen_code.uniform_offsets.size());
+	for (uint32_t offset : gen_code.uniform_offsets) {
+		f->store_32(offset);
+	}
+	f->store_32(gen_code.uniform_total_size);
+	f->store_pascal_string(gen_code.uniforms);
+	for (int i = 0; i < STAGE_MAX; i++) {
+		f->store_pascal_string(gen_code.stage_globals[i]);
+	}
+
+	f->store_32(gen_code.code.size());
+	for (const KeyValue<String, String> &E : gen_code.code) {
+		f->store_pascal_string(E.key);
+		f->store_pascal_string(E.value);
+	}
+
+	f->store_8(gen_code.uses_global_textures);
+	f->store_8(gen_code.uses_fragment_time);
+	f->store_8(gen_code.uses_vertex_time);
+	f->store_8(gen_code.uses_screen_texture_mipmaps);
+	f->store_8(gen_code.uses_screen_texture);
+	f->store_8(gen_code.uses_depth_texture);
+	f->store_8(gen_code.uses_normal_roughness_texture);
+
+	_store_names(f, p_entry.render_mode_values);
+	_store_names(f, p_entry.render_mode_flags);
+	_store_names(f, p_entry.usage_flags);
+	_store_names(f, p_entry.write_flags);
+
+	f->store_32(p_entry.uniforms.size());
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : p_entry.uniforms) {
+		const SL::ShaderNode::Uniform &uniform = E.value;
+		f->store_pascal_string(E.key);
+		f->store_32(uniform.order);
+		f->store_32(uniform.prop_order);
+		f->store_32(uniform.texture_order);
+		f->store_32(uniform.texture_binding);
+		f->store_32(uniform.type);
+		f->store_32(uniform.precision);
+		f->store_32(uniform.array_size);
+		f->store_32(uniform.default_value.size());
+		for (const SL::Scalar &value : uniform.default_value) {
+			f->store_32(value.uint);
+		}
+		f->store_32(uniform.scope);
+		f->store_32(uniform.hint);
+		f->store_8(uniform.use_color);
+		f->store_32(uniform.filter);
+		f->store_32(uniform.repeat);
+		for (int j = 0; j < 3; j++) {
+			f->store_float(uniform.hint_range[j]);
+		}
+		_store_strings(f, uniform.hint_enum_names);
+		f->store_32(uniform.instance_index);
+		f->store_pascal_string(uniform.group);
+		f->store_pascal_string(uniform.subgroup);
+	}
+}
+
+void ShaderCompiler::set_shader_cache_dir(const String &p_dir) {
+	shader_cache_dir = String();
+	if (p_dir.is_empty()) {
+		return;
+	}
+
+	Ref<DirAccess> d = DirAccess::open(p_dir);
+	ERR_FAIL_COND(d.is_null());
+	if (d->change_dir("compiler") != OK) {
+		Error err = d->make_dir("compiler");
+		ERR_FAIL_COND(err != OK);
+	}
+	shader_cache_dir = p_dir.path_join("compiler");
+}
+
+String ShaderCompiler::shader_cache_dir;
+
+static void _append_actions(StringBuilder &r_hash, const char *p_name, const HashMap<StringName, String> &p_actions) {
+	r_hash.append(p_name);
+	for (const KeyValue<StringName, String> &E : p_actions) {
+		r_hash.append(String(E.key) + "=" + E.value + ";");
+	}
+}
+
 void ShaderCompiler::initialize(DefaultIdentifierActions p_actions) {
 	actions = p_actions;
 
+	// Cached code is only reused by compilers with the same default actions.
+	StringBuilder hash;
+	_append_actions(hash, "[renames]", actions.renames);
+	_append_actions(hash, "[render_mode_defines]", actions.render_mode_defines);
+	_append_actions(hash, "[usage_defines]", actions.usage_defines);
+	_append_actions(hash, "[custom_samplers]", actions.custom_samplers);
+	hash.append("[options]");
+	hash.append(itos(actions.default_filter) + ";" + itos(actions.default_repeat) + ";" + itos(actions.base_texture_binding_index) + ";" + itos(actions.texture_layout_set) + ";");
+	hash.append(actions.base_uniform_string + ";" + actions.global_buffer_array_variable + ";" + actions.instance_uniform_index_variable + ";");
+	hash.append(itos(actions.base_varying_index) + ";" + itos(actions.apply_luminance_multiplier) + ";" + itos(actions.check_multiview_samplers));
+	actions_hash = hash.as_string().sha256_text();
+
 	time_name = "TIME";
 
 	List<String> func_list;
@@ -1605,4 +2021,5 @@ void ShaderCompiler::initialize(DefaultIdentifierActions p_actions) {
 }
 
 ShaderCompiler::ShaderCompiler() {
+	compile_cache.set_capacity(COMPILE_CACHE_SIZE);
 }
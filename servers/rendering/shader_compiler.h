@@ -31,11 +31,14 @@
 #ifndef SHADER_COMPILER_H
 #define SHADER_COMPILER_H
 
+#include "core/templates/lru.h"
 #include "core/templates/pair.h"
 #include "servers/rendering/shader_language.h"
 #include "servers/rendering_server.h"
 
 class ShaderCompiler {
+	friend class TestShaderCompilerInternalsAccessor;
+
 public:
 	enum Stage {
 		STAGE_VERTEX,
@@ -124,13 +127,41 @@ private:
 	HashSet<StringName> fragment_varyings;
 
 	DefaultIdentifierActions actions;
+	String actions_hash;
 
 	static ShaderLanguage::DataType _get_global_shader_uniform_type(const StringName &p_name);
 
+	// Successful compilations are cached by a hash of the preprocessed code and
+	// the compile options, in memory and optionally on disk. The effects on the
+	// identifier actions are stored by name, so they can be replayed for the
+	// pointers of any caller.
+	struct CacheEntry {
+		GeneratedCode gen_code;
+		LocalVector<StringName> render_mode_values;
+		LocalVector<StringName> render_mode_flags;
+		LocalVector<StringName> usage_flags;
+		LocalVector<StringName> write_flags;
+		HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+	};
+
+	static constexpr int COMPILE_CACHE_SIZE = 256;
+
+	LRUCache<String, CacheEntry> compile_cache;
+	static String shader_cache_dir;
+
+	String _get_cache_key(RS::ShaderMode p_mode, const String &p_code, const IdentifierActions &p_actions) const;
+	bool _is_cache_entry_valid(const CacheEntry &p_entry) const;
+	void _apply_cache_entry(const CacheEntry &p_entry, IdentifierActions *p_actions, GeneratedCode &r_gen_code) const;
+	bool _load_from_cache(const String &p_key, CacheEntry &r_entry) const;
+	void _save_to_cache(const String &p_key, const CacheEntry &p_entry) const;
+
 public:
 	Error compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
 
 	void initialize(DefaultIdentifierActions p_actions);
+
+	static void set_shader_cache_dir(const String &p_dir);
+
 	ShaderCompiler();
 };
 
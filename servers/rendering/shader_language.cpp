@@ -400,8 +400,24 @@ const ShaderLanguage::KeyWord ShaderLanguage::keyword_list[] = {
 	{ TK_ERROR, nullptr, CF_UNSPECIFIED, {}, {} }
 };
 
+const HashMap<String, ShaderLanguage::TokenType> &ShaderLanguage::_get_keyword_map() {
+	static const HashMap<String, TokenType> keyword_map = []() {
+		HashMap<String, TokenType> map;
+		for (int idx = 0; keyword_list[idx].text; idx++) {
+			if (!map.has(keyword_list[idx].text)) {
+				map.insert(keyword_list[idx].text, keyword_list[idx].token);
+			}
+		}
+		return map;
+	}();
+	return keyword_map;
+}
+
 ShaderLanguage::Token ShaderLanguage::_get_token() {
-#define GETCHAR(m_idx) (((char_idx + m_idx) < code.length()) ? code[char_idx + m_idx] : char32_t(0))
+	const char32_t *code_ptr = code.ptr();
+	const int code_length = code.length();
+
+#define GETCHAR(m_idx) (((char_idx + m_idx) < code_length) ? code_ptr[char_idx + m_idx] : char32_t(0))
 
 	while (true) {
 		char_idx++;
@@ -739,7 +755,6 @@ ShaderLanguage::Token ShaderLanguage::_get_token() {
 						}
 					}
 
-					String str;
 					int i = 0;
 					bool digit_after_exp = false;
 
@@ -804,10 +819,18 @@ ShaderLanguage::Token ShaderLanguage::_get_token() {
 							}
 							return _make_token(TK_ERROR, "Invalid (integer) numeric constant");
 						}
-						str += symbol;
 						i++;
 					}
 
+					// Copy the whole constant at once, lowercased like the checks above.
+					String str;
+					str.resize(i + 1);
+					char32_t *str_ptr = str.ptrw();
+					for (int j = 0; j < i; j++) {
+						str_ptr[j] = String::char_lowercase(code_ptr[char_idx + j]);
+					}
+					str_ptr[i] = 0;
+
 					char32_t last_char = str[str.length() - 1];
 
 					if (hexa_found) { // Integer (hex).
@@ -898,22 +921,17 @@ ShaderLanguage::Token ShaderLanguage::_get_token() {
 
 				if (is_ascii_identifier_char(GETCHAR(0))) {
 					// parse identifier
-					String str;
-
-					while (is_ascii_identifier_char(GETCHAR(0))) {
-						str += char32_t(GETCHAR(0));
-						char_idx++;
+					int len = 0;
+					while (is_ascii_identifier_char(GETCHAR(len))) {
+						len++;
 					}
+					String str(code_ptr + char_idx, len);
+					char_idx += len;
 
 					//see if keyword
-					//should be converted to a static map
-					int idx = 0;
-
-					while (keyword_list[idx].text) {
-						if (str == keyword_list[idx].text) {
-							return _make_token(keyword_list[idx].token);
-						}
-						idx++;
+					const TokenType *keyword = _get_keyword_map().getptr(str);
+					if (keyword) {
+						return _make_token(*keyword);
 					}
 
 					str = str.replace("dus_", "_");
@@ -1327,7 +1345,45 @@ void ShaderLanguage::clear() {
 	while (nodes) {
 		Node *n = nodes;
 		nodes = nodes->next;
-		memdelete(n);
+		n->~Node();
+	}
+	node_arena.reset();
+}
+
+void *ShaderLanguage::NodeArena::allocate(uint32_t p_size) {
+	p_size = (p_size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	if (unlikely(p_size > PAGE_SIZE)) {
+		uint8_t *mem = (uint8_t *)memalloc(p_size);
+		large_allocations.push_back(mem);
+		return mem;
+	}
+
+	if (offset + p_size > PAGE_SIZE) {
+		if (used_pages == pages.size()) {
+			pages.push_back((uint8_t *)memalloc(PAGE_SIZE));
+		}
+		used_pages++;
+		offset = 0;
+	}
+
+	void *mem = pages[used_pages - 1] + offset;
+	offset += p_size;
+	return mem;
+}
+
+void ShaderLanguage::NodeArena::reset() {
+	for (uint8_t *mem : large_allocations) {
+		memfree(mem);
+	}
+	large_allocations.clear();
+	used_pages = 0;
+	offset = PAGE_SIZE;
+}
+
+ShaderLanguage::NodeArena::~NodeArena() {
+	reset();
+	for (uint8_t *mem : pages) {
+		memfree(mem);
 	}
 }
 
@@ -1386,12 +1442,13 @@ bool ShaderLanguage::_find_identifier(const BlockNode *p_block, bool p_allow_rea
 			}
 		}
 	} else {
-		if (p_function_info.built_ins.has(p_identifier)) {
+		const BuiltInInfo *built_in = p_function_info.built_ins.getptr(p_identifier);
+		if (built_in) {
 			if (r_data_type) {
-				*r_data_type = p_function_info.built_ins[p_identifier].type;
+				*r_data_type = built_in->type;
 			}
 			if (r_is_const) {
-				*r_is_const = p_function_info.built_ins[p_identifier].constant;
+				*r_is_const = built_in->constant;
 			}
 			if (r_type) {
 				*r_type = IDENTIFIER_BUILTIN_VAR;
@@ -1400,9 +1457,10 @@ bool ShaderLanguage::_find_identifier(const BlockNode *p_block, bool p_allow_rea
 		}
 	}
 
-	if (p_function_info.stage_functions.has(p_identifier)) {
+	const StageFunctionInfo *stage_function = p_function_info.stage_functions.getptr(p_identifier);
+	if (stage_function) {
 		if (r_data_type) {
-			*r_data_type = p_function_info.stage_functions[p_identifier].return_type;
+			*r_data_type = stage_function->return_type;
 		}
 		if (r_is_const) {
 			*r_is_const = true;
@@ -1416,21 +1474,22 @@ bool ShaderLanguage::_find_identifier(const BlockNode *p_block, bool p_allow_rea
 	FunctionNode *function = nullptr;
 
 	while (p_block) {
-		if (p_block->variables.has(p_identifier)) {
+		const BlockNode::Variable *variable = p_block->variables.getptr(p_identifier);
+		if (variable) {
 			if (r_data_type) {
-				*r_data_type = p_block->variables[p_identifier].type;
+				*r_data_type = variable->type;
 			}
 			if (r_is_const) {
-				*r_is_const = p_block->variables[p_identifier].is_const;
+				*r_is_const = variable->is_const;
 			}
 			if (r_array_size) {
-				*r_array_size = p_block->variables[p_identifier].array_size;
+				*r_array_size = variable->array_size;
 			}
 			if (r_struct_name) {
-				*r_struct_name = p_block->variables[p_identifier].struct_name;
+				*r_struct_name = variable->struct_name;
 			}
-			if (r_constant_values && !p_block->variables[p_identifier].values.is_empty()) {
-				*r_constant_values = p_block->variables[p_identifier].values;
+			if (r_constant_values && !variable->values.is_empty()) {
+				*r_constant_values = variable->values;
 			}
 			if (r_type) {
 				*r_type = IDENTIFIER_LOCAL_VAR;
@@ -1473,12 +1532,13 @@ bool ShaderLanguage::_find_identifier(const BlockNode *p_block, bool p_allow_rea
 		}
 	}
 
-	if (shader->varyings.has(p_identifier)) {
+	const ShaderNode::Varying *varying = shader->varyings.getptr(p_identifier);
+	if (varying) {
 		if (r_data_type) {
-			*r_data_type = shader->varyings[p_identifier].type;
+			*r_data_type = varying->type;
 		}
 		if (r_array_size) {
-			*r_array_size = shader->varyings[p_identifier].array_size;
+			*r_array_size = varying->array_size;
 		}
 		if (r_type) {
 			*r_type = IDENTIFIER_VARYING;
@@ -1486,12 +1546,13 @@ bool ShaderLanguage::_find_identifier(const BlockNode *p_block, bool p_allow_rea
 		return true;
 	}
 
-	if (shader->uniforms.has(p_identifier)) {
+	const ShaderNode::Uniform *uniform = shader->uniforms.getptr(p_identifier);
+	if (uniform) {
 		if (r_data_type) {
-			*r_data_type = shader->uniforms[p_identifier].type;
+			*r_data_type = uniform->type;
 		}
 		if (r_array_size) {
-			*r_array_size = shader->uniforms[p_identifier].array_size;
+			*r_array_size = uniform->array_size;
 		}
 		if (r_type) {
 			*r_type = IDENTIFIER_UNIFORM;
@@ -1499,22 +1560,24 @@ bool ShaderLanguage::_find_identifier(const BlockNode *p_block, bool p_allow_rea
 		return true;
 	}
 
-	if (shader->constants.has(p_identifier)) {
+	const ShaderNode::Constant *constant = shader->constants.getptr(p_identifier);
+	if (constant) {
 		if (r_is_const) {
 			*r_is_const = true;
 		}
 		if (r_data_type) {
-			*r_data_type = shader->constants[p_identifier].type;
+			*r_data_type = constant->type;
 		}
 		if (r_array_size) {
-			*r_array_size = shader->constants[p_identifier].array_size;
+			*r_array_size = constant->array_size;
 		}
 		if (r_struct_name) {
-			*r_struct_name = shader->constants[p_identifier].struct_name;
+			*r_struct_name = constant->struct_name;
 		}
-		if (r_constant_values) {
-			if (shader->constants[p_identifier].initializer && !shader->constants[p_identifier].initializer->get_values().is_empty()) {
-				*r_constant_values = shader->constants[p_identifier].initializer->get_values();
+		if (r_constant_values && constant->initializer) {
+			Vector<Scalar> values = constant->initializer->get_values();
+			if (!values.is_empty()) {
+				*r_constant_values = values;
 			}
 		}
 		if (r_type) {
@@ -3513,6 +3576,7 @@ const ShaderLanguage::BuiltinFuncDef ShaderLanguage::builtin_func_defs[] = {
 };
 
 HashSet<StringName> global_func_set;
+HashMap<StringName, LocalVector<int>> builtin_func_indices; // Overloads of each built-in function, in declaration order.
 
 const ShaderLanguage::BuiltinFuncOutArgs ShaderLanguage::builtin_func_out_args[] = {
 	{ "modf", { 1, -1 } },
@@ -3593,207 +3657,201 @@ bool ShaderLanguage::_validate_function_call(BlockNode *p_block, const FunctionI
 	bool unsupported_builtin = false;
 	int builtin_idx = 0;
 
-	if (argcount <= 4) {
+	const LocalVector<int> *overloads = argcount <= 4 ? builtin_func_indices.getptr(name) : nullptr;
+	if (overloads) {
 		// test builtins
-		int idx = 0;
-
-		while (builtin_func_defs[idx].name) {
+		for (int idx : *overloads) {
 			if (completion_class != builtin_func_defs[idx].tag) {
-				idx++;
 				continue;
 			}
 
-			if (name == builtin_func_defs[idx].name) {
-				failed_builtin = true;
-				bool fail = false;
-				for (int i = 0; i < argcount; i++) {
-					if (p_func->arguments[i + 1]->type == Node::NODE_TYPE_ARRAY) {
-						const ArrayNode *anode = static_cast<const ArrayNode *>(p_func->arguments[i + 1]);
-						if (anode->call_expression == nullptr && !anode->is_indexed()) {
-							fail = true;
-							break;
-						}
-					}
-					if (get_scalar_type(args[i]) == args[i] && p_func->arguments[i + 1]->type == Node::NODE_TYPE_CONSTANT && convert_constant(static_cast<ConstantNode *>(p_func->arguments[i + 1]), builtin_func_defs[idx].args[i])) {
-						//all good, but needs implicit conversion later
-					} else if (args[i] != builtin_func_defs[idx].args[i]) {
+			failed_builtin = true;
+			bool fail = false;
+			for (int i = 0; i < argcount; i++) {
+				if (p_func->arguments[i + 1]->type == Node::NODE_TYPE_ARRAY) {
+					const ArrayNode *anode = static_cast<const ArrayNode *>(p_func->arguments[i + 1]);
+					if (anode->call_expression == nullptr && !anode->is_indexed()) {
 						fail = true;
 						break;
 					}
 				}
+				if (get_scalar_type(args[i]) == args[i] && p_func->arguments[i + 1]->type == Node::NODE_TYPE_CONSTANT && convert_constant(static_cast<ConstantNode *>(p_func->arguments[i + 1]), builtin_func_defs[idx].args[i])) {
+					//all good, but needs implicit conversion later
+				} else if (args[i] != builtin_func_defs[idx].args[i]) {
+					fail = true;
+					break;
+				}
+			}
 
-				if (!fail) {
-					if (RenderingServer::get_singleton()->is_low_end()) {
-						if (builtin_func_defs[idx].high_end) {
-							fail = true;
-							unsupported_builtin = true;
-							builtin_idx = idx;
-						}
+			if (!fail) {
+				if (RenderingServer::get_singleton()->is_low_end()) {
+					if (builtin_func_defs[idx].high_end) {
+						fail = true;
+						unsupported_builtin = true;
+						builtin_idx = idx;
 					}
 				}
+			}
 
-				if (!fail && argcount < 4 && builtin_func_defs[idx].args[argcount] != TYPE_VOID) {
-					fail = true; //make sure the number of arguments matches
-				}
+			if (!fail && argcount < 4 && builtin_func_defs[idx].args[argcount] != TYPE_VOID) {
+				fail = true; //make sure the number of arguments matches
+			}
 
-				if (!fail) {
-					{
-						int constarg_idx = 0;
-						while (builtin_func_const_args[constarg_idx].name) {
-							if (String(name) == builtin_func_const_args[constarg_idx].name) {
-								int arg = builtin_func_const_args[constarg_idx].arg + 1;
-								if (p_func->arguments.size() <= arg) {
-									break;
-								}
+			if (!fail) {
+				{
+					int constarg_idx = 0;
+					while (builtin_func_const_args[constarg_idx].name) {
+						if (String(name) == builtin_func_const_args[constarg_idx].name) {
+							int arg = builtin_func_const_args[constarg_idx].arg + 1;
+							if (p_func->arguments.size() <= arg) {
+								break;
+							}
 
-								int min = builtin_func_const_args[constarg_idx].min;
-								int max = builtin_func_const_args[constarg_idx].max;
+							int min = builtin_func_const_args[constarg_idx].min;
+							int max = builtin_func_const_args[constarg_idx].max;
 
-								bool error = false;
-								Vector<Scalar> values = _get_node_values(p_block, p_func->arguments[arg]);
-								if (p_func->arguments[arg]->get_datatype() == TYPE_INT && !values.is_empty()) {
-									if (values[0].sint < min || values[0].sint > max) {
-										error = true;
-									}
-								} else {
+							bool error = false;
+							Vector<Scalar> values = _get_node_values(p_block, p_func->arguments[arg]);
+							if (p_func->arguments[arg]->get_datatype() == TYPE_INT && !values.is_empty()) {
+								if (values[0].sint < min || values[0].sint > max) {
 									error = true;
 								}
+							} else {
+								error = true;
+							}
 
-								if (error) {
-									_set_error(vformat(RTR("Expected integer constant within [%d..%d] range."), min, max));
-									return false;
-								}
+							if (error) {
+								_set_error(vformat(RTR("Expected integer constant within [%d..%d] range."), min, max));
+								return false;
 							}
-							constarg_idx++;
 						}
+						constarg_idx++;
 					}
+				}
 
-					//make sure its not an out argument used in the wrong way
-					int outarg_idx = 0;
-					while (builtin_func_out_args[outarg_idx].name) {
-						if (String(name) == builtin_func_out_args[outarg_idx].name) {
-							for (int arg = 0; arg < BuiltinFuncOutArgs::MAX_ARGS; arg++) {
-								int arg_idx = builtin_func_out_args[outarg_idx].arguments[arg];
-								if (arg_idx == -1) {
-									break;
+				//make sure its not an out argument used in the wrong way
+				int outarg_idx = 0;
+				while (builtin_func_out_args[outarg_idx].name) {
+					if (String(name) == builtin_func_out_args[outarg_idx].name) {
+						for (int arg = 0; arg < BuiltinFuncOutArgs::MAX_ARGS; arg++) {
+							int arg_idx = builtin_func_out_args[outarg_idx].arguments[arg];
+							if (arg_idx == -1) {
+								break;
+							}
+							if (arg_idx < argcount) {
+								if (p_func->arguments[arg_idx + 1]->type != Node::NODE_TYPE_VARIABLE && p_func->arguments[arg_idx + 1]->type != Node::NODE_TYPE_MEMBER && p_func->arguments[arg_idx + 1]->type != Node::NODE_TYPE_ARRAY) {
+									_set_error(vformat(RTR("Argument %d of function '%s' is not a variable, array, or member."), arg_idx + 1, String(name)));
+									return false;
 								}
-								if (arg_idx < argcount) {
-									if (p_func->arguments[arg_idx + 1]->type != Node::NODE_TYPE_VARIABLE && p_func->arguments[arg_idx + 1]->type != Node::NODE_TYPE_MEMBER && p_func->arguments[arg_idx + 1]->type != Node::NODE_TYPE_ARRAY) {
-										_set_error(vformat(RTR("Argument %d of function '%s' is not a variable, array, or member."), arg_idx + 1, String(name)));
-										return false;
-									}
 
-									if (p_func->arguments[arg_idx + 1]->type == Node::NODE_TYPE_ARRAY) {
-										ArrayNode *mn = static_cast<ArrayNode *>(p_func->arguments[arg_idx + 1]);
-										if (mn->is_const) {
-											fail = true;
-										}
-									} else if (p_func->arguments[arg_idx + 1]->type == Node::NODE_TYPE_MEMBER) {
-										MemberNode *mn = static_cast<MemberNode *>(p_func->arguments[arg_idx + 1]);
-										if (mn->basetype_const) {
-											fail = true;
-										}
-									} else { // TYPE_VARIABLE
-										VariableNode *vn = static_cast<VariableNode *>(p_func->arguments[arg_idx + 1]);
-										if (vn->is_const) {
+								if (p_func->arguments[arg_idx + 1]->type == Node::NODE_TYPE_ARRAY) {
+									ArrayNode *mn = static_cast<ArrayNode *>(p_func->arguments[arg_idx + 1]);
+									if (mn->is_const) {
+										fail = true;
+									}
+								} else if (p_func->arguments[arg_idx + 1]->type == Node::NODE_TYPE_MEMBER) {
+									MemberNode *mn = static_cast<MemberNode *>(p_func->arguments[arg_idx + 1]);
+									if (mn->basetype_const) {
+										fail = true;
+									}
+								} else { // TYPE_VARIABLE
+									VariableNode *vn = static_cast<VariableNode *>(p_func->arguments[arg_idx + 1]);
+									if (vn->is_const) {
+										fail = true;
+									} else {
+										StringName varname = vn->name;
+										if (shader->uniforms.has(varname)) {
 											fail = true;
 										} else {
-											StringName varname = vn->name;
-											if (shader->uniforms.has(varname)) {
-												fail = true;
-											} else {
-												if (shader->varyings.has(varname)) {
-													_set_error(vformat(RTR("Varyings cannot be passed for the '%s' parameter."), "out"));
-													return false;
-												}
-												if (p_function_info.built_ins.has(varname)) {
-													BuiltInInfo info = p_function_info.built_ins[varname];
-													if (info.constant) {
-														fail = true;
-													}
+											if (shader->varyings.has(varname)) {
+												_set_error(vformat(RTR("Varyings cannot be passed for the '%s' parameter."), "out"));
+												return false;
+											}
+											if (p_function_info.built_ins.has(varname)) {
+												BuiltInInfo info = p_function_info.built_ins[varname];
+												if (info.constant) {
+													fail = true;
 												}
 											}
 										}
 									}
-									if (fail) {
-										_set_error(vformat(RTR("A constant value cannot be passed for the '%s' parameter."), "out"));
+								}
+								if (fail) {
+									_set_error(vformat(RTR("A constant value cannot be passed for the '%s' parameter."), "out"));
+									return false;
+								}
+
+								StringName var_name;
+								if (p_func->arguments[arg_idx + 1]->type == Node::NODE_TYPE_ARRAY) {
+									var_name = static_cast<const ArrayNode *>(p_func->arguments[arg_idx + 1])->name;
+								} else if (p_func->arguments[arg_idx + 1]->type == Node::NODE_TYPE_MEMBER) {
+									Node *n = static_cast<const MemberNode *>(p_func->arguments[arg_idx + 1])->owner;
+									while (n->type == Node::NODE_TYPE_MEMBER) {
+										n = static_cast<const MemberNode *>(n)->owner;
+									}
+									if (n->type != Node::NODE_TYPE_VARIABLE && n->type != Node::NODE_TYPE_ARRAY) {
+										_set_error(vformat(RTR("Argument %d of function '%s' is not a variable, array, or member."), arg_idx + 1, String(name)));
 										return false;
 									}
-
-									StringName var_name;
-									if (p_func->arguments[arg_idx + 1]->type == Node::NODE_TYPE_ARRAY) {
-										var_name = static_cast<const ArrayNode *>(p_func->arguments[arg_idx + 1])->name;
-									} else if (p_func->arguments[arg_idx + 1]->type == Node::NODE_TYPE_MEMBER) {
-										Node *n = static_cast<const MemberNode *>(p_func->arguments[arg_idx + 1])->owner;
-										while (n->type == Node::NODE_TYPE_MEMBER) {
-											n = static_cast<const MemberNode *>(n)->owner;
-										}
-										if (n->type != Node::NODE_TYPE_VARIABLE && n->type != Node::NODE_TYPE_ARRAY) {
-											_set_error(vformat(RTR("Argument %d of function '%s' is not a variable, array, or member."), arg_idx + 1, String(name)));
-											return false;
-										}
-										if (n->type == Node::NODE_TYPE_VARIABLE) {
-											var_name = static_cast<const VariableNode *>(n)->name;
-										} else { // TYPE_ARRAY
-											var_name = static_cast<const ArrayNode *>(n)->name;
-										}
-									} else { // TYPE_VARIABLE
-										var_name = static_cast<const VariableNode *>(p_func->arguments[arg_idx + 1])->name;
+									if (n->type == Node::NODE_TYPE_VARIABLE) {
+										var_name = static_cast<const VariableNode *>(n)->name;
+									} else { // TYPE_ARRAY
+										var_name = static_cast<const ArrayNode *>(n)->name;
 									}
-									const BlockNode *b = p_block;
-									bool valid = false;
-									while (b) {
-										if (b->variables.has(var_name) || p_function_info.built_ins.has(var_name)) {
-											valid = true;
-											break;
-										}
-										if (b->parent_function) {
-											for (int i = 0; i < b->parent_function->arguments.size(); i++) {
-												if (b->parent_function->arguments[i].name == var_name) {
-													valid = true;
-													break;
-												}
+								} else { // TYPE_VARIABLE
+									var_name = static_cast<const VariableNode *>(p_func->arguments[arg_idx + 1])->name;
+								}
+								const BlockNode *b = p_block;
+								bool valid = false;
+								while (b) {
+									if (b->variables.has(var_name) || p_function_info.built_ins.has(var_name)) {
+										valid = true;
+										break;
+									}
+									if (b->parent_function) {
+										for (int i = 0; i < b->parent_function->arguments.size(); i++) {
+											if (b->parent_function->arguments[i].name == var_name) {
+												valid = true;
+												break;
 											}
 										}
-										b = b->parent_block;
 									}
+									b = b->parent_block;
+								}
 
-									if (!valid) {
-										_set_error(vformat(RTR("Argument %d of function '%s' can only take a local variable, array, or member."), arg_idx + 1, String(name)));
-										return false;
-									}
+								if (!valid) {
+									_set_error(vformat(RTR("Argument %d of function '%s' can only take a local variable, array, or member."), arg_idx + 1, String(name)));
+									return false;
 								}
 							}
 						}
-						outarg_idx++;
 					}
-					//implicitly convert values if possible
-					for (int i = 0; i < argcount; i++) {
-						if (get_scalar_type(args[i]) != args[i] || args[i] == builtin_func_defs[idx].args[i] || p_func->arguments[i + 1]->type != Node::NODE_TYPE_CONSTANT) {
-							//can't do implicit conversion here
-							continue;
-						}
-
-						//this is an implicit conversion
-						ConstantNode *constant = static_cast<ConstantNode *>(p_func->arguments[i + 1]);
-						ConstantNode *conversion = alloc_node<ConstantNode>();
+					outarg_idx++;
+				}
+				//implicitly convert values if possible
+				for (int i = 0; i < argcount; i++) {
+					if (get_scalar_type(args[i]) != args[i] || args[i] == builtin_func_defs[idx].args[i] || p_func->arguments[i + 1]->type != Node::NODE_TYPE_CONSTANT) {
+						//can't do implicit conversion here
+						continue;
+					}
 
-						conversion->datatype = builtin_func_defs[idx].args[i];
-						conversion->values.resize(1);
+					//this is an implicit conversion
+					ConstantNode *constant = static_cast<ConstantNode *>(p_func->arguments[i + 1]);
+					ConstantNode *conversion = alloc_node<ConstantNode>();
 
-						convert_constant(constant, builtin_func_defs[idx].args[i], conversion->values.ptrw());
-						p_func->arguments.write[i + 1] = conversion;
-					}
+					conversion->datatype = builtin_func_defs[idx].args[i];
+					conversion->values.resize(1);
 
-					if (r_ret_type) {
-						*r_ret_type = builtin_func_defs[idx].rettype;
-					}
+					convert_constant(constant, builtin_func_defs[idx].args[i], conversion->values.ptrw());
+					p_func->arguments.write[i + 1] = conversion;
+				}
 
-					return true;
+				if (r_ret_type) {
+					*r_ret_type = builtin_func_defs[idx].rettype;
 				}
-			}
 
-			idx++;
+				return true;
+			}
 		}
 	}
 
@@ -6177,15 +6235,16 @@ ShaderLanguage::Node *ShaderLanguage::_parse_expression(BlockNode *p_block, cons
 				bool is_local = false;
 
 				if (p_block && p_block->block_tag != SubClassTag::TAG_GLOBAL) {
-					int idx = 0;
 					bool found = false;
 
-					while (builtin_func_defs[idx].name) {
-						if (builtin_func_defs[idx].tag == p_block->block_tag && builtin_func_defs[idx].name == identifier) {
-							found = true;
-							break;
+					const LocalVector<int> *overloads = builtin_func_indices.getptr(identifier);
+					if (overloads) {
+						for (int idx : *overloads) {
+							if (builtin_func_defs[idx].tag == p_block->block_tag) {
+								found = true;
+								break;
+							}
 						}
-						idx++;
 					}
 					if (!found) {
 						_set_error(vformat(RTR("Unknown identifier in expression: '%s'."), String(identifier)));
@@ -10185,7 +10244,7 @@ Error ShaderLanguage::_parse_shader(const HashMap<StringName, FunctionInfo> &p_f
 
 								array_size = constant.array_size;
 
-								ConstantNode *expr = memnew(ConstantNode);
+								ConstantNode *expr = alloc_node<ConstantNode>();
 
 								expr->datatype = constant.type;
 
@@ -11564,6 +11623,7 @@ ShaderLanguage::ShaderLanguage() {
 			if (builtin_func_defs[idx].tag == SubClassTag::TAG_GLOBAL) {
 				global_func_set.insert(builtin_func_defs[idx].name);
 			}
+			builtin_func_indices[builtin_func_defs[idx].name].push_back(idx);
 			idx++;
 		}
 	}
@@ -11585,5 +11645,6 @@ ShaderLanguage::~ShaderLanguage() {
 	instance_counter--;
 	if (instance_counter == 0) {
 		global_func_set.clear();
+		builtin_func_indices.clear();
 	}
 }
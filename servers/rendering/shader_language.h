@@ -35,6 +35,7 @@
 #include "core/string/string_name.h"
 #include "core/string/ustring.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rb_map.h"
 #include "core/typedefs.h"
 #include "core/variant/variant.h"
@@ -395,9 +396,28 @@ public:
 		virtual ~Node() {}
 	};
 
+	// Nodes are placed in pages that are kept between compilations, and are all
+	// released at once when the parser is cleared.
+	struct NodeArena {
+		static constexpr uint32_t PAGE_SIZE = 64 * 1024;
+		static constexpr uint32_t ALIGNMENT = 16;
+
+		LocalVector<uint8_t *> pages;
+		LocalVector<uint8_t *> large_allocations;
+		uint32_t used_pages = 0;
+		uint32_t offset = PAGE_SIZE;
+
+		void *allocate(uint32_t p_size);
+		void reset();
+		~NodeArena();
+	};
+
+	NodeArena node_arena;
+
 	template <typename T>
 	T *alloc_node() {
-		T *node = memnew(T);
+		static_assert(alignof(T) <= NodeArena::ALIGNMENT);
+		T *node = memnew_placement(node_arena.allocate(sizeof(T)), T);
 		node->next = nodes;
 		nodes = node;
 		return node;
@@ -938,6 +958,7 @@ private:
 	};
 
 	static const KeyWord keyword_list[];
+	static const HashMap<String, TokenType> &_get_keyword_map();
 
 	GlobalShaderUniformGetTypeFunc global_shader_uniform_get_type_func = nullptr;
 
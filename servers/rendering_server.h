@@ -1380,6 +1380,16 @@ public:
 
 	virtual void instance_set_custom_aabb(RID p_instance, AABB aabb) = 0;
 
+	// Update many instances with a single command. Transforms use 12 floats per
+	// instance (the layout of multimesh buffers), AABBs use 6 (position and size).
+	virtual void instances_set_transforms(const Vector<RID> &p_instances, const Vector<float> &p_transforms) = 0;
+	virtual void instances_set_custom_aabbs(const Vector<RID> &p_instances, const Vector<float> &p_aabbs) = 0;
+	virtual void instances_set_visible(const Vector<RID> &p_instances, bool p_visible) = 0;
+
+	void _instances_set_transforms_bind(const TypedArray<RID> &p_instances, const PackedFloat32Array &p_transforms);
+	void _instances_set_custom_aabbs_bind(const TypedArray<RID> &p_instances, const PackedFloat32Array &p_aabbs);
+	void _instances_set_visible_bind(const TypedArray<RID> &p_instances, bool p_visible);
+
 	virtual void instance_attach_skeleton(RID p_instance, RID p_skeleton) = 0;
 
 	virtual void instance_set_extra_visibility_margin(RID p_instance, real_t p_margin) = 0;
@@ -1715,6 +1725,8 @@ public:
 		RENDERING_INFO_PIPELINE_COMPILATIONS_SURFACE,
 		RENDERING_INFO_PIPELINE_COMPILATIONS_DRAW,
 		RENDERING_INFO_PIPELINE_COMPILATIONS_SPECIALIZATION,
+		RENDERING_INFO_CANVAS_MERGED_BATCHES_IN_FRAME,
+		RENDERING_INFO_CANVAS_MERGED_ITEMS_IN_FRAME,
 		RENDERING_INFO_MAX
 	};
 
@@ -107,6 +107,25 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+
+TEST_CASE("[FileAccess] Open prefetched file from memory") {
+	const String path = TestUtils::get_data_path("line_endings_lf.test.txt");
+
+	FileAccess::PrefetchedFile prefetched;
+	prefetched.path = path;
+	prefetched.data = String("Prefetched contents").to_utf8_buffer();
+
+	FileAccess::set_thread_prefetched_file(&prefetched);
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+	FileAccess::set_thread_prefetched_file(nullptr);
+
+	REQUIRE(!f.is_null());
+	CHECK_MESSAGE(f->get_as_utf8_string() == "Prefetched contents", "The prefetched data should be read instead of the file on disk.");
+
+	Ref<FileAccess> f_disk = FileAccess::open(path, FileAccess::READ);
+	REQUIRE(!f_disk.is_null());
+	CHECK_MESSAGE(f_disk->get_as_utf8_string() == "Hello darkness\nMy old friend\nI've come to talk\nWith you again\n", "The file on disk should be read once the prefetched data is unset.");
+}
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
@@ -32,6 +32,7 @@
 #define TEST_IMAGE_H
 
 #include "core/io/image.h"
+#include "core/math/random_pcg.h"
 #include "core/os/os.h"
 
 #include "tests/test_utils.h"
@@ -221,6 +222,232 @@ TEST_CASE("[Image] Resizing") {
 			"get_size() should return the correct size after resize_to_po2().");
 }
 
+TEST_CASE("[Image] Processing large images") {
+	// Just large enough for the row-striped (multi-threaded) code paths to be used.
+	const int size = 512;
+	const Image::Format formats[] = { Image::FORMAT_RGBA8, Image::FORMAT_RGBAH, Image::FORMAT_RGBAF };
+	const char *interpolation_names[] = { "Nearest", "Bilinear", "Cubic", "Trilinear", "Lanczos" };
+
+	for (Image::Format format : formats) {
+		Ref<Image> source = Image::create_empty(size, size, false, format);
+		source->fill(Color(0.5, 0.25, 1, 1));
+		// Compare against the stored color, as 8-bit formats can't represent 0.5 exactly.
+		const Color color = source->get_pixel(0, 0);
+
+		for (int i = 0; i < 5; i++) {
+			Ref<Image> image = memnew(Image());
+			image->copy_internals_from(source);
+			Image::Interpolation interpolation = static_cast<Image::Interpolation>(i);
+			image->resize(size * 3 / 4, size / 2, interpolation);
+
+			CHECK(image->get_size() == Vector2i(size * 3 / 4, size / 2));
+			// Each stripe must be written, so check the first and last rows as well as the middle.
+			CHECK_MESSAGE(
+					image->get_pixel(0, 0).is_equal_approx(color),
+					vformat("%s resize should keep the color of the first row.", interpolation_names[i]));
+			CHECK_MESSAGE(
+					image->get_pixel(image->get_width() / 2, image->get_height() / 2).is_equal_approx(color),
+					vformat("%s resize should keep the color of the middle row.", interpolation_names[i]));
+			CHECK_MESSAGE(
+					image->get_pixel(image->get_width() - 1, image->get_height() - 1).is_equal_approx(color),
+					vformat("%s resize should keep the color of the last row.", interpolation_names[i]));
+		}
+
+		Ref<Image> image = memnew(Image());
+		image->copy_internals_from(source);
+		image->generate_mipmaps();
+
+		Ref<Image> mip = image->get_image_from_mipmap(1);
+		CHECK(mip->get_size() == Vector2i(size / 2, size / 2));
+		CHECK(mip->get_pixel(size / 2 - 1, size / 2 - 1).is_equal_approx(color));
+	}
+
+	// Nearest scaling only horizontally keeps each row, so stripes must not be shifted.
+	Ref<Image> rows = Image::create_empty(size, size, false, Image::FORMAT_RGBA8);
+	for (int y = 0; y < size; y++) {
+		rows->fill_rect(Rect2i(0, y, size, 1), Color::hex(((y & 0xFF) << 24) | ((y >> 8) << 16) | 0xFF));
+	}
+	rows->resize(size / 2, size, Image::INTERPOLATE_NEAREST);
+	bool rows_match = true;
+	for (int y = 0; y < size; y++) {
+		rows_match = rows_match && rows->get_pixel(size / 4, y).is_equal_approx(Color::hex(((y & 0xFF) << 24) | ((y >> 8) << 16) | 0xFF));
+	}
+	CHECK_MESSAGE(rows_match, "Nearest resize should keep every row in place.");
+
+	// Conversion.
+	Ref<Image> convert = Image::create_empty(size, size, false, Image::FORMAT_RGBA8);
+	convert->fill(Color::hex(0x0a141e28));
+	convert->convert(Image::FORMAT_RGB8);
+	CHECK(convert->get_pixel(size - 1, size - 1).is_equal_approx(Color::hex(0x0a141eff)));
+
+	Ref<Image> convert_float = Image::create_empty(size, size, false, Image::FORMAT_RGBF);
+	convert_float->fill(Color(0.5, 0.25, 0.125));
+	convert_float->convert(Image::FORMAT_RGBAF);
+	CHECK(convert_float->get_pixel(size - 1, size - 1) == Color(0.5, 0.25, 0.125, 1));
+
+	// sRGB to linear must match the result of a small (single-threaded) image.
+	Ref<Image> small = Image::create_empty(1, 1, false, Image::FORMAT_RGBA8);
+	small->set_pixel(0, 0, Color::hex(0xc86432ff));
+	small->srgb_to_linear();
+	Ref<Image> large = Image::create_empty(size, size, false, Image::FORMAT_RGBA8);
+	large->fill(Color::hex(0xc86432ff));
+	large->srgb_to_linear();
+	CHECK(large->get_pixel(0, 0) == small->get_pixel(0, 0));
+	CHECK(large->get_pixel(size - 1, size - 1) == small->get_pixel(0, 0));
+}
+
+TEST_CASE("[Image] Batch loading from buffers") {
+	Ref<Image> source = memnew(Image(64, 48, false, Image::FORMAT_RGBA8));
+	for (int y = 0; y < source->get_height(); y++) {
+		for (int x = 0; x < source->get_width(); x++) {
+			source->set_pixel(x, y, Color(x / 64.0, y / 48.0, 0.5, 1.0));
+		}
+	}
+
+	const int count = 8;
+	TypedArray<PackedByteArray> buffers;
+	const PackedByteArray png = source->save_png_to_buffer();
+	for (int i = 0; i < count; i++) {
+		buffers.push_back(png);
+	}
+
+	TypedArray<Image> images = Image::load_images_from_buffers(buffers);
+
+	REQUIRE(images.size() == count);
+	for (int i = 0; i < count; i++) {
+		Ref<Image> image = images[i];
+		REQUIRE(image.is_valid());
+		CHECK(image->get_data() == source->get_data());
+	}
+
+#ifdef MODULE_WEBP_ENABLED
+	buffers.clear();
+	const PackedByteArray webp = source->save_webp_to_buffer();
+	for (int i = 0; i < count; i++) {
+		buffers.push_back(webp);
+	}
+
+	images = Image::load_images_from_buffers(buffers);
+
+	REQUIRE(images.size() == count);
+	for (int i = 0; i < count; i++) {
+		Ref<Image> image = images[i];
+		REQUIRE(image.is_valid());
+		CHECK(image->get_size() == source->get_size());
+	}
+#endif // MODULE_WEBP_ENABLED
+
+#ifdef MODULE_JPG_ENABLED
+	buffers.clear();
+	const PackedByteArray jpg = source->save_jpg_to_buffer();
+	for (int i = 0; i < count; i++) {
+		buffers.push_back(jpg);
+	}
+
+	images = Image::load_images_from_buffers(buffers);
+
+	REQUIRE(images.size() == count);
+	for (int i = 0; i < count; i++) {
+		Ref<Image> image = images[i];
+		REQUIRE(image.is_valid());
+		CHECK(image->get_size() == source->get_size());
+	}
+#endif // MODULE_JPG_ENABLED
+
+	// Invalid buffers are reported without affecting the others.
+	buffers.clear();
+	buffers.push_back(PackedByteArray());
+	buffers.push_back(png);
+	PackedByteArray garbage;
+	garbage.resize(32);
+	garbage.fill(0x42);
+	buffers.push_back(garbage);
+
+	ERR_PRINT_OFF;
+	images = Image::load_images_from_buffers(buffers);
+	ERR_PRINT_ON;
+
+	REQUIRE(images.size() == 3);
+	CHECK(Ref<Image>(images[0]).is_null());
+	CHECK(Ref<Image>(images[1]).is_valid());
+	CHECK(Ref<Image>(images[2]).is_null());
+}
+
+// Per-pixel reference for blend_rect(), clipping omitted.
+static void _blend_rect_reference(const Ref<Image> &p_dst, const Ref<Image> &p_src, const Ref<Image> &p_mask, const Rect2i &p_src_rect, const Point2i &p_dest) {
+	for (int y = 0; y < p_src_rect.size.y; y++) {
+		for (int x = 0; x < p_src_rect.size.x; x++) {
+			Point2i sp = p_src_rect.position + Point2i(x, y);
+			Point2i dp = p_dest + Point2i(x, y);
+			if (p_mask.is_valid() && p_mask->get_pixelv(sp).a == 0) {
+				continue;
+			}
+			Color sc = p_src->get_pixelv(sp);
+			if (sc.a != 0) {
+				p_dst->set_pixelv(dp, p_dst->get_pixelv(dp).blend(sc));
+			}
+		}
+	}
+}
+
+static Ref<Image> _make_blend_test_image(int p_width, int p_height, Image::Format p_format, uint32_t p_seed) {
+	Ref<Image> image = Image::create_empty(p_width, p_height, false, p_format);
+	RandomPCG rng(p_seed);
+	for (int y = 0; y < p_height; y++) {
+		for (int x = 0; x < p_width; x++) {
+			// Include fully transparent and fully opaque pixels.
+			float a = CLAMP(rng.random(-0.25f, 1.25f), 0.0f, 1.0f);
+			image->set_pixel(x, y, Color(rng.randf(), rng.randf(), rng.randf(), a));
+		}
+	}
+	return image;
+}
+
+TEST_CASE("[Image] Blending rectangles") {
+	const Image::Format formats[] = { Image::FORMAT_RGBA8, Image::FORMAT_RGBAF, Image::FORMAT_LA8 };
+
+	for (Image::Format format : formats) {
+		Ref<Image> src = _make_blend_test_image(300, 300, format, 1);
+		Ref<Image> mask = _make_blend_test_image(300, 300, Image::FORMAT_RGBA8, 2);
+		Ref<Image> dst = _make_blend_test_image(320, 320, format, 3);
+
+		Ref<Image> expected = dst->duplicate();
+		_blend_rect_reference(expected, src, Ref<Image>(), Rect2i(0, 0, 300, 300), Point2i(10, 20));
+		Ref<Image> result = dst->duplicate();
+		result->blend_rect(src, Rect2i(0, 0, 300, 300), Point2i(10, 20));
+		CHECK_MESSAGE(result->get_data() == expected->get_data(), vformat("blend_rect() should match per-pixel blending for %s.", Image::get_format_name(format)));
+
+		expected = dst->duplicate();
+		_blend_rect_reference(expected, src, mask, Rect2i(5, 5, 280, 290), Point2i(0, 0));
+		result = dst->duplicate();
+		result->blend_rect_mask(src, mask, Rect2i(5, 5, 280, 290), Point2i(0, 0));
+		CHECK_MESSAGE(result->get_data() == expected->get_data(), vformat("blend_rect_mask() should match per-pixel blending for %s.", Image::get_format_name(format)));
+
+		// Overlapping rectangles are blended in order.
+		TypedArray<Image> sources;
+		TypedArray<Rect2i> src_rects;
+		TypedArray<Vector2i> dests;
+		expected = dst->duplicate();
+		for (int i = 0; i < 16; i++) {
+			Rect2i src_rect(i * 7, i * 5, 120, 90);
+			Vector2i dest(i * 13, i * 17);
+			sources.push_back(src);
+			src_rects.push_back(src_rect);
+			dests.push_back(dest);
+			expected->blend_rect(src, src_rect, dest);
+		}
+		// Clipped by the destination bounds.
+		sources.push_back(src);
+		src_rects.push_back(Rect2i(0, 0, 300, 300));
+		dests.push_back(Vector2i(250, -100));
+		expected->blend_rect(src, Rect2i(0, 0, 300, 300), Vector2i(250, -100));
+
+		result = dst->duplicate();
+		result->blend_rects(sources, src_rects, dests);
+		CHECK_MESSAGE(result->get_data() == expected->get_data(), vformat("blend_rects() should match successive blend_rect() calls for %s.", Image::get_format_name(format)));
+	}
+}
+
 TEST_CASE("[Image] Modifying pixels of an image") {
 	Ref<Image> image = memnew(Image(3, 3, false, Image::FORMAT_RGBA8));
 	image->set_pixel(0, 0, Color(1, 1, 1, 1));
@@ -117,6 +117,59 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 27000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+TEST_CASE("[PCKPacker] Deduplicate identical files") {
+	const String base_dir = OS::get_singleton()->get_executable_path().get_base_dir();
+	const String output_pck_path = TestUtils::get_temp_path("output_deduplicated.pck");
+	const String reference_pck_path = TestUtils::get_temp_path("output_not_deduplicated.pck");
+
+	PCKPacker reference_packer;
+	CHECK(reference_packer.pck_start(reference_pck_path) == OK);
+	CHECK(reference_packer.add_file("icon.png", base_dir.path_join("../icon.png")) == OK);
+	CHECK(reference_packer.add_file("copies/icon.png", base_dir.path_join("../icon.png")) == OK);
+	CHECK(reference_packer.add_file("logo.png", base_dir.path_join("../logo.png")) == OK);
+	CHECK(reference_packer.flush() == OK);
+	CHECK_MESSAGE(
+			reference_packer.get_deduplicated_bytes() == 0,
+			"No bytes should be deduplicated when deduplication is disabled.");
+
+	PCKPacker pck_packer;
+	pck_packer.set_deduplicate_files(true);
+	CHECK(pck_packer.is_deduplicating_files());
+	CHECK(pck_packer.pck_start(output_pck_path) == OK);
+	CHECK(pck_packer.add_file("icon.png", base_dir.path_join("../icon.png")) == OK);
+	CHECK(pck_packer.add_file("copies/icon.png", base_dir.path_join("../icon.png")) == OK);
+	CHECK(pck_packer.add_file("logo.png", base_dir.path_join("../logo.png")) == OK);
+	CHECK(pck_packer.flush() == OK);
+
+	const uint64_t icon_size = FileAccess::get_file_as_bytes(base_dir.path_join("../icon.png")).size();
+	CHECK_MESSAGE(
+			pck_packer.get_deduplicated_bytes() == icon_size,
+			"The duplicated file should be reported as saved bytes.");
+
+	Ref<FileAccess> f_dedup = FileAccess::open(output_pck_path, FileAccess::READ);
+	Ref<FileAccess> f_reference = FileAccess::open(reference_pck_path, FileAccess::READ);
+	REQUIRE(f_dedup.is_valid());
+	REQUIRE(f_reference.is_valid());
+	CHECK_MESSAGE(
+			f_dedup->get_length() + icon_size <= f_reference->get_length(),
+			"The deduplicated PCK should not store the duplicated file again.");
+
+	// Every path must still read back the contents it was added with.
+	PackedData *packed_data = PackedData::get_singleton();
+	REQUIRE(packed_data);
+	REQUIRE(packed_data->add_pack(output_pck_path, true, 0) == OK);
+	const char *const packed_paths[] = { "icon.png", "copies/icon.png", "logo.png" };
+	const char *const source_paths[] = { "../icon.png", "../icon.png", "../logo.png" };
+	for (int i = 0; i < 3; i++) {
+		Ref<FileAccess> packed_file = packed_data->try_open_path(packed_paths[i]);
+		REQUIRE_MESSAGE(packed_file.is_valid(), vformat("\"%s\" should be found in the deduplicated PCK.", packed_paths[i]));
+		CHECK_MESSAGE(
+				packed_file->get_buffer(packed_file->get_length()) == FileAccess::get_file_as_bytes(base_dir.path_join(source_paths[i])),
+				vformat("\"%s\" should read back the same bytes as its source file.", packed_paths[i]));
+	}
+	packed_data->clear(); // Tests don't load any other pack.
+}
 } // namespace TestPCKPacker
 
 #endif // TEST_PCK_PACKER_H
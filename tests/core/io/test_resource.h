@@ -31,14 +31,18 @@
 #ifndef TEST_RESOURCE_H
 #define TEST_RESOURCE_H
 
+#include "core/io/dir_access.h"
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 #include "core/os/os.h"
+#include "scene/resources/resource_format_text.h"
 
 #include "thirdparty/doctest/doctest.h"
 
+#include "tests/core/config/test_project_settings.h"
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace TestResource {
 
@@ -166,6 +170,95 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	// Break circular reference to avoid memory leak
 	resource_c->remove_meta("next");
 }
+
+static String find_text_resource_cache_file(const String &p_cache_dir, const String &p_extension) {
+	for (const String &file : DirAccess::get_files_at(p_cache_dir)) {
+		if (file.get_extension() == p_extension) {
+			return p_cache_dir.path_join(file);
+		}
+	}
+	return String();
+}
+
+TEST_CASE("[Resource] Binary cache of text resources") {
+	// The cache is only used for projects running from their files, so point res:// to a temporary project.
+	String old_resource_path = TestProjectSettingsInternalsAccessor::resource_path();
+	String project_path = TestUtils::get_temp_path("text_resource_cache_project");
+	DirAccess::make_dir_recursive_absolute(project_path.path_join(".godot"));
+	TestProjectSettingsInternalsAccessor::resource_path() = project_path;
+
+	const String source_path = "res://cached.tres";
+	const String cache_dir = "res://.godot/text_resource_cache";
+
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_name("Source");
+	ResourceSaver::save(resource, source_path);
+
+	ResourceFormatLoaderText *loader = ResourceFormatLoaderText::singleton;
+	REQUIRE(loader);
+	loader->set_binary_cache_enabled(true);
+
+	Ref<Resource> loaded = loader->load(source_path, "", nullptr, false, nullptr, ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(loaded.is_valid());
+	CHECK(loaded->get_name() == "Source");
+
+	const String cache_path = find_text_resource_cache_file(cache_dir, "res");
+	REQUIRE_MESSAGE(!cache_path.is_empty(), "Loading the text resource should create a binary cache entry.");
+	CHECK(FileAccess::exists(cache_path + ".info"));
+	CHECK_MESSAGE(find_text_resource_cache_file(cache_dir, "tmp").is_empty(), "No temporary files should be left behind.");
+
+	SUBCASE("Cache hit") {
+		// Put a different resource in the cache entry, to tell which file the load read.
+		Ref<Resource> cached = memnew(Resource);
+		cached->set_name("Cached");
+		ResourceSaver::save(cached, cache_path, ResourceSaver::FLAG_NONE);
+
+		loaded = loader->load(source_path, "", nullptr, false, nullptr, ResourceFormatLoader::CACHE_MODE_IGNORE);
+		REQUIRE(loaded.is_valid());
+		CHECK(loaded->get_name() == "Cached");
+	}
+
+	SUBCASE("Invalidation when the source changes") {
+		resource->set_name("Changed");
+		ResourceSaver::save(resource, source_path);
+
+		// Modified times have a one second resolution, so also mark the entry as older than the source.
+		Ref<FileAccess> f = FileAccess::open(cache_path + ".info", FileAccess::READ);
+		Vector<String> info = f->get_as_text().split("\n");
+		f = FileAccess::open(cache_path + ".info", FileAccess::WRITE);
+		info.write[3] = "0";
+		f->store_string(String("\n").join(info));
+		f.unref();
+
+		loaded = loader->load(source_path, "", nullptr, false, nullptr, ResourceFormatLoader::CACHE_MODE_IGNORE);
+		REQUIRE(loaded.is_valid());
+		CHECK(loaded->get_name() == "Changed");
+
+		// The entry was refreshed with the new contents.
+		f = FileAccess::open(cache_path + ".info", FileAccess::READ);
+		info = f->get_as_text().split("\n");
+		CHECK(info[4] == FileAccess::get_md5(source_path));
+	}
+
+	SUBCASE("Fallback when the cache file is corrupt") {
+		Ref<FileAccess> f = FileAccess::open(cache_path, FileAccess::WRITE);
+		f->store_string("not a binary resource");
+		f.unref();
+
+		ERR_PRINT_OFF;
+		loaded = loader->load(source_path, "", nullptr, false, nullptr, ResourceFormatLoader::CACHE_MODE_IGNORE);
+		ERR_PRINT_ON;
+		REQUIRE(loaded.is_valid());
+		CHECK(loaded->get_name() == "Source");
+	}
+
+	loader->set_binary_cache_enabled(false);
+	TestProjectSettingsInternalsAccessor::resource_path() = old_resource_path;
+	Ref<DirAccess> da = DirAccess::open(project_path);
+	if (da.is_valid()) {
+		da->erase_contents_recursive();
+	}
+}
 } // namespace TestResource
 
 #endif // TEST_RESOURCE_H
@@ -107,6 +107,29 @@ TEST_CASE("[WorkerThreadPool] Process elements using group tasks") {
 	}
 }
 
+TEST_CASE("[WorkerThreadPool] Process contiguous ranges of elements") {
+	const uint32_t counts[] = { 0, 1, 7, 1000 };
+	for (uint32_t count : counts) {
+		counter.clear();
+		counter.resize(count);
+		SafeNumeric<uint32_t> ranges;
+		WorkerThreadPool::process_ranges(count, 4, [&](uint32_t p_from, uint32_t p_to) {
+			ranges.increment();
+			for (uint32_t i = p_from; i < p_to; i++) {
+				counter[i].increment();
+			}
+		});
+
+		bool all_run_once = true;
+		for (uint32_t i = 0; i < count; i++) {
+			//Reduce number of check messages
+			all_run_once &= counter[i].get() == 1;
+		}
+		CHECK(all_run_once);
+		CHECK(ranges.get() <= MAX(count, 1u));
+	}
+}
+
 static void static_test_daemon(void *p_arg) {
 	while (!exit.is_set()) {
 		counter[0].add(1);
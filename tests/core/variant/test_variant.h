@@ -1755,6 +1755,46 @@ TEST_CASE("[Variant] Writer and parser array") {
 	CHECK_MESSAGE(a_parsed == Variant(a), "Should parse back.");
 }
 
+TEST_CASE("[Variant] Writer and parser large packed arrays") {
+	PackedInt32Array ints;
+	PackedFloat32Array floats;
+	PackedVector3Array vectors;
+	for (int i = 0; i < 1000; i++) {
+		ints.push_back(i * 3 - 500);
+		floats.push_back(i * 0.5f);
+		vectors.push_back(Vector3(i, -i, i * 0.25f));
+	}
+
+	String errs;
+	int line;
+	Variant parsed;
+
+	String ints_str;
+	VariantWriter::write_to_string(ints, ints_str);
+	VariantParser::StreamString ints_ss;
+	ints_ss.s = ints_str;
+	CHECK(VariantParser::parse(&ints_ss, parsed, errs, line) == OK);
+	CHECK_MESSAGE(parsed == Variant(ints), "Should parse back.");
+
+	String floats_str;
+	VariantWriter::write_to_string(floats, floats_str);
+	VariantParser::StreamString floats_ss;
+	floats_ss.s = floats_str;
+	CHECK(VariantParser::parse(&floats_ss, parsed, errs, line) == OK);
+	CHECK_MESSAGE(parsed == Variant(floats), "Should parse back.");
+
+	String vectors_str;
+	VariantWriter::write_to_string(vectors, vectors_str);
+	VariantParser::StreamString vectors_ss;
+	vectors_ss.s = vectors_str;
+	CHECK(VariantParser::parse(&vectors_ss, parsed, errs, line) == OK);
+	CHECK_MESSAGE(parsed == Variant(vectors), "Should parse back.");
+
+	VariantParser::StreamString invalid_ss;
+	invalid_ss.s = "PackedInt32Array(1, 2, 3, )";
+	CHECK_MESSAGE(VariantParser::parse(&invalid_ss, parsed, errs, line) == ERR_PARSE_ERROR, "Should fail on a missing element.");
+}
+
 TEST_CASE("[Variant] Writer recursive array") {
 	// There is no way to accurately represent a recursive array,
 	// the only thing we can do is make sure the writer doesn't blow up
@@ -0,0 +1,71 @@
+/**************************************************************************/
+/*  test_editor_file_system.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_EDITOR_FILE_SYSTEM_H
+#define TEST_EDITOR_FILE_SYSTEM_H
+
+#include "editor/editor_file_system.h"
+#include "editor/editor_paths.h"
+#include "editor/editor_settings.h"
+
+#include "tests/test_macros.h"
+
+class TestEditorFileSystemInternalsAccessor {
+public:
+	static String import_cache_dir_setting() {
+		return EditorFileSystem::_get_import_cache_dir_setting();
+	}
+};
+
+namespace TestEditorFileSystem {
+
+TEST_CASE("[Editor][EditorFileSystem] Shared import cache folder follows the editor settings") {
+	EditorSettings *settings = EditorSettings::get_singleton();
+
+	settings->set_setting("filesystem/import/shared_cache/enabled", false);
+	settings->set_setting("filesystem/import/shared_cache/path", "/tmp/import_cache");
+	CHECK_MESSAGE(
+			TestEditorFileSystemInternalsAccessor::import_cache_dir_setting().is_empty(),
+			"The shared import cache should be unused while disabled, even with a path set.");
+
+	settings->set_setting("filesystem/import/shared_cache/enabled", true);
+	CHECK(TestEditorFileSystemInternalsAccessor::import_cache_dir_setting() == "/tmp/import_cache");
+
+	settings->set_setting("filesystem/import/shared_cache/path", "");
+	CHECK_MESSAGE(
+			TestEditorFileSystemInternalsAccessor::import_cache_dir_setting() == EditorPaths::get_singleton()->get_cache_dir().path_join("import_cache"),
+			"An empty path should fall back to the editor cache folder.");
+
+	settings->set_setting("filesystem/import/shared_cache/enabled", false);
+}
+
+} // namespace TestEditorFileSystem
+
+#endif // TEST_EDITOR_FILE_SYSTEM_H
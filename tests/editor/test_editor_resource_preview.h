@@ -0,0 +1,243 @@
+/**************************************************************************/
+/*  test_editor_resource_preview.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_EDITOR_RESOURCE_PREVIEW_H
+#define TEST_EDITOR_RESOURCE_PREVIEW_H
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/image.h"
+#include "core/math/random_pcg.h"
+#include "editor/editor_resource_preview.h"
+#include "editor/editor_settings.h"
+#include "scene/resources/image_texture.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+class TestEditorResourcePreviewInternalsAccessor {
+public:
+	static EditorResourcePreview *create(const String &p_disk_cache_dir) {
+		EditorResourcePreview *preview = memnew(EditorResourcePreview);
+		preview->disk_cache_dir = p_disk_cache_dir;
+		return preview;
+	}
+
+	static void destroy(EditorResourcePreview *p_preview) {
+		memdelete(p_preview);
+		EditorResourcePreview::singleton = nullptr;
+	}
+
+	static String get_key(EditorResourcePreview *p_preview, const String &p_path) {
+		return p_preview->_get_disk_cache_key(p_path);
+	}
+
+	static String get_entry_base(EditorResourcePreview *p_preview, const String &p_key) {
+		return p_preview->_get_disk_cache_base(p_key);
+	}
+
+	static String get_index_path(EditorResourcePreview *p_preview, const String &p_path) {
+		return p_preview->_get_disk_cache_index(p_path);
+	}
+
+	// Same files as a generated preview (see _generate_preview()).
+	static void save_entry(EditorResourcePreview *p_preview, const String &p_path, const String &p_key, const Ref<Image> &p_image) {
+		String cache_base = p_preview->_get_disk_cache_base(p_key);
+		p_preview->_save_disk_cache_file(cache_base + ".png", p_image);
+		p_preview->_write_preview_cache_file(cache_base + ".txt", p_image->get_width(), false, 0, p_key, Dictionary());
+		p_preview->_write_preview_cache_file(p_preview->_get_disk_cache_index(p_path), p_image->get_width(), false, 0, p_key, Dictionary());
+		p_preview->_touch_disk_cache(p_key);
+	}
+
+	static Ref<ImageTexture> load_entry(EditorResourcePreview *p_preview, const String &p_key) {
+		Ref<ImageTexture> texture;
+		Ref<ImageTexture> small_texture;
+		p_preview->_load_disk_cache(p_key, false, texture, small_texture);
+		return texture;
+	}
+
+	static bool has_last_used(EditorResourcePreview *p_preview, const String &p_key) {
+		return p_preview->disk_cache_last_used.has(p_key);
+	}
+
+	static uint64_t get_last_used(EditorResourcePreview *p_preview, const String &p_key) {
+		return p_preview->disk_cache_last_used.has(p_key) ? p_preview->disk_cache_last_used[p_key] : 0;
+	}
+
+	static void set_last_used(EditorResourcePreview *p_preview, const String &p_key, uint64_t p_time) {
+		p_preview->disk_cache_last_used[p_key] = p_time;
+	}
+
+	static void enforce_budget(EditorResourcePreview *p_preview) {
+		p_preview->_enforce_disk_cache_budget();
+	}
+};
+
+namespace TestEditorResourcePreview {
+
+static void write_file(const String &p_path, const String &p_contents) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_string(p_contents);
+}
+
+// Noise doesn't compress, so the size of each entry on disk is known.
+static Ref<Image> make_noise_image(int p_size, uint32_t p_seed) {
+	RandomPCG rng(p_seed);
+	Vector<uint8_t> data;
+	data.resize(p_size * p_size * 4);
+	uint8_t *w = data.ptrw();
+	for (int i = 0; i < data.size(); i++) {
+		w[i] = rng.rand() & 0xFF;
+	}
+	return Image::create_from_data(p_size, p_size, false, Image::FORMAT_RGBA8, data);
+}
+
+TEST_CASE("[Editor][EditorResourcePreview] Disk cache") {
+	const String temp_dir = TestUtils::get_temp_path("editor_resource_preview");
+	const String cache_dir = temp_dir.path_join("cache");
+	DirAccess::make_dir_recursive_absolute(cache_dir);
+	Ref<DirAccess> da = DirAccess::open(temp_dir);
+	REQUIRE(da.is_valid());
+	da->erase_contents_recursive(); // Left over from an interrupted run.
+	DirAccess::make_dir_recursive_absolute(cache_dir);
+
+	EditorResourcePreview *preview = TestEditorResourcePreviewInternalsAccessor::create(cache_dir);
+	const Variant budget = EditorSettings::get_singleton()->get_setting("filesystem/resource_preview/disk_cache_size_mb");
+
+	const String file_a = temp_dir.path_join("a.txt");
+	const String file_b = temp_dir.path_join("b.txt");
+	const String file_c = temp_dir.path_join("c.txt");
+	write_file(file_a, "first");
+	write_file(file_b, "second");
+	write_file(file_c, "third");
+
+	SUBCASE("Keys only depend on the contents") {
+		const String key = TestEditorResourcePreviewInternalsAccessor::get_key(preview, file_a);
+		CHECK(key.length() == 32);
+		CHECK(TestEditorResourcePreviewInternalsAccessor::get_key(preview, file_a) == key);
+		CHECK(TestEditorResourcePreviewInternalsAccessor::get_key(preview, file_b) != key);
+
+		const String copy = temp_dir.path_join("copy_of_a.txt");
+		write_file(copy, "first");
+		CHECK_MESSAGE(TestEditorResourcePreviewInternalsAccessor::get_key(preview, copy) == key, "Moved or duplicated files should reuse the thumbnail.");
+
+		write_file(file_a, "changed");
+		CHECK(TestEditorResourcePreviewInternalsAccessor::get_key(preview, file_a) != key);
+		CHECK(TestEditorResourcePreviewInternalsAccessor::get_key(preview, temp_dir.path_join("missing.txt")).is_empty());
+	}
+
+	SUBCASE("Saved entries are hit and marked as used") {
+		const String key = TestEditorResourcePreviewInternalsAccessor::get_key(preview, file_a);
+		ERR_PRINT_OFF;
+		CHECK(TestEditorResourcePreviewInternalsAccessor::load_entry(preview, key).is_null());
+		ERR_PRINT_ON;
+
+		Ref<Image> image = make_noise_image(16, 1);
+		TestEditorResourcePreviewInternalsAccessor::save_entry(preview, file_a, key, image);
+		TestEditorResourcePreviewInternalsAccessor::set_last_used(preview, key, 1);
+
+		Ref<ImageTexture> texture = TestEditorResourcePreviewInternalsAccessor::load_entry(preview, key);
+		REQUIRE(texture.is_valid());
+		CHECK(texture->get_image()->get_data() == image->get_data());
+		CHECK_MESSAGE(TestEditorResourcePreviewInternalsAccessor::get_last_used(preview, key) > 1, "Loading an entry should move it to the back of the LRU.");
+
+		// Another file with the same contents reaches the same entry.
+		const String copy = temp_dir.path_join("copy_of_a.txt");
+		write_file(copy, "first");
+		CHECK(TestEditorResourcePreviewInternalsAccessor::load_entry(preview, TestEditorResourcePreviewInternalsAccessor::get_key(preview, copy)).is_valid());
+	}
+
+	SUBCASE("Least recently used entries are evicted first") {
+		// About 1.4 MiB per entry, so only two of them fit.
+		EditorSettings::get_singleton()->set_setting("filesystem/resource_preview/disk_cache_size_mb", 3);
+
+		const String files[3] = { file_a, file_b, file_c };
+		String keys[3];
+		for (int i = 0; i < 3; i++) {
+			keys[i] = TestEditorResourcePreviewInternalsAccessor::get_key(preview, files[i]);
+			TestEditorResourcePreviewInternalsAccessor::save_entry(preview, files[i], keys[i], make_noise_image(600, i + 1));
+		}
+		// Used in the order b, a, c.
+		TestEditorResourcePreviewInternalsAccessor::set_last_used(preview, keys[1], 100);
+		TestEditorResourcePreviewInternalsAccessor::set_last_used(preview, keys[0], 200);
+		TestEditorResourcePreviewInternalsAccessor::set_last_used(preview, keys[2], 300);
+
+		TestEditorResourcePreviewInternalsAccessor::enforce_budget(preview);
+
+		const String evicted_base = TestEditorResourcePreviewInternalsAccessor::get_entry_base(preview, keys[1]);
+		CHECK_FALSE(FileAccess::exists(evicted_base + ".png"));
+		CHECK_FALSE(FileAccess::exists(evicted_base + ".txt"));
+		CHECK_FALSE_MESSAGE(FileAccess::exists(TestEditorResourcePreviewInternalsAccessor::get_index_path(preview, file_b)), "The path index of an evicted entry should go with it.");
+		CHECK_FALSE(TestEditorResourcePreviewInternalsAccessor::has_last_used(preview, keys[1]));
+
+		for (int i : { 0, 2 }) {
+			CHECK(FileAccess::exists(TestEditorResourcePreviewInternalsAccessor::get_entry_base(preview, keys[i]) + ".png"));
+			CHECK(FileAccess::exists(TestEditorResourcePreviewInternalsAccessor::get_index_path(preview, files[i])));
+			CHECK(TestEditorResourcePreviewInternalsAccessor::get_last_used(preview, keys[i]) == (i == 0 ? 200u : 300u));
+		}
+	}
+
+	SUBCASE("Stale files are removed regardless of the budget") {
+		EditorSettings::get_singleton()->set_setting("filesystem/resource_preview/disk_cache_size_mb", 0);
+
+		const String key = TestEditorResourcePreviewInternalsAccessor::get_key(preview, file_a);
+		TestEditorResourcePreviewInternalsAccessor::save_entry(preview, file_a, key, make_noise_image(16, 1));
+		const String kept_key = TestEditorResourcePreviewInternalsAccessor::get_key(preview, file_b);
+		TestEditorResourcePreviewInternalsAccessor::save_entry(preview, file_b, kept_key, make_noise_image(16, 2));
+		const String entry_base = TestEditorResourcePreviewInternalsAccessor::get_entry_base(preview, key);
+		DirAccess::remove_absolute(entry_base + ".png");
+
+		// Files of the previous layout. Only the path-keyed image can be a scene thumbnail.
+		const String legacy_base = cache_dir.path_join("resthumb-0123456789abcdef0123456789abcdef");
+		make_noise_image(16, 3)->save_png(legacy_base + ".png");
+		make_noise_image(8, 3)->save_png(legacy_base + "_small.png");
+		write_file(legacy_base + ".txt", "64\n1\n0\n\n\n2\n");
+
+		TestEditorResourcePreviewInternalsAccessor::enforce_budget(preview);
+
+		CHECK_FALSE(FileAccess::exists(entry_base + ".txt"));
+		CHECK_FALSE_MESSAGE(FileAccess::exists(TestEditorResourcePreviewInternalsAccessor::get_index_path(preview, file_a)), "Path indexes pointing to a missing entry should be removed.");
+		CHECK(FileAccess::exists(TestEditorResourcePreviewInternalsAccessor::get_index_path(preview, file_b)));
+		CHECK(FileAccess::exists(TestEditorResourcePreviewInternalsAccessor::get_entry_base(preview, kept_key) + ".png"));
+		CHECK_FALSE(FileAccess::exists(legacy_base + ".txt"));
+		CHECK_FALSE(FileAccess::exists(legacy_base + "_small.png"));
+		CHECK(FileAccess::exists(legacy_base + ".png"));
+	}
+
+	EditorSettings::get_singleton()->set_setting("filesystem/resource_preview/disk_cache_size_mb", budget);
+	TestEditorResourcePreviewInternalsAccessor::destroy(preview);
+	da->erase_contents_recursive();
+	DirAccess::remove_absolute(temp_dir);
+}
+
+} // namespace TestEditorResourcePreview
+
+#endif // TEST_EDITOR_RESOURCE_PREVIEW_H
@@ -0,0 +1,182 @@
+/**************************************************************************/
+/*  test_compressed_texture.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_COMPRESSED_TEXTURE_H
+#define TEST_COMPRESSED_TEXTURE_H
+
+#include "core/config/project_settings.h"
+#include "core/io/file_access.h"
+#include "core/io/image.h"
+#include "scene/resources/compressed_texture.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestCompressedTexture {
+
+// Writes the image the same way the texture importer does for VRAM Uncompressed textures.
+static void _save_ctex(const String &p_path, const Ref<Image> &p_image) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_8('G');
+	f->store_8('S');
+	f->store_8('T');
+	f->store_8('2');
+	f->store_32(CompressedTexture2D::FORMAT_VERSION);
+	f->store_32(p_image->get_width());
+	f->store_32(p_image->get_height());
+	f->store_32(p_image->has_mipmaps() ? CompressedTexture2D::FORMAT_BIT_HAS_MIPMAPS : 0);
+	f->store_32(0); // Mipmap limit.
+	f->store_32(0);
+	f->store_32(0);
+	f->store_32(0);
+
+	f->store_32(CompressedTexture2D::DATA_FORMAT_IMAGE);
+	f->store_16(p_image->get_width());
+	f->store_16(p_image->get_height());
+	f->store_32(p_image->get_mipmap_count());
+	f->store_32(p_image->get_format());
+	f->store_buffer(p_image->get_data());
+}
+
+static Ref<CompressedTexture2D> _load_ctex(const String &p_file, int p_size, Image::Format p_format) {
+	Ref<Image> image = Image::create_empty(p_size, p_size, true, p_format);
+	image->fill(Color(0.25, 0.5, 0.75, 1.0));
+	String path = TestUtils::get_temp_path(p_file);
+	_save_ctex(path, image);
+
+	Ref<CompressedTexture2D> texture;
+	texture.instantiate();
+	CHECK(texture->load(path) == OK);
+	return texture;
+}
+
+// [SceneTree] in a test case name enables initializing a mock render server,
+// which CompressedTexture2D is dependent on.
+TEST_CASE("[SceneTree][CompressedTexture2D] Mipmap streaming") {
+	ProjectSettings *ps = ProjectSettings::get_singleton();
+	ps->set_setting("rendering/textures/streaming/enabled", true);
+	ps->set_setting("rendering/textures/streaming/initial_size", 32);
+	ps->set_setting("rendering/textures/streaming/memory_budget_mb", 0);
+	const uint64_t initial_usage = CompressedTexture2D::get_streaming_memory_usage();
+
+	SUBCASE("Only the small mipmaps are loaded up front") {
+		Ref<CompressedTexture2D> texture = _load_ctex("streaming_initial.ctex", 256, Image::FORMAT_RGBA8);
+		CHECK(texture->is_streaming());
+		CHECK(texture->get_width() == 256);
+		CHECK(texture->get_height() == 256);
+		CHECK(texture->get_streaming_resident_size() == 32);
+
+		Ref<Image> resident = texture->get_image();
+		REQUIRE(resident.is_valid());
+		CHECK(resident->get_width() == 32);
+		CHECK(resident->has_mipmaps());
+		CHECK(CompressedTexture2D::get_streaming_memory_usage() == initial_usage);
+	}
+
+	SUBCASE("Finer mipmaps are loaded on request") {
+		Ref<CompressedTexture2D> texture = _load_ctex("streaming_request.ctex", 256, Image::FORMAT_RGBA8);
+		texture->request_streaming_size(100);
+		texture->wait_for_streaming();
+		CHECK(texture->get_streaming_resident_size() == 128);
+		CHECK(texture->get_image()->get_width() == 128);
+		CHECK(CompressedTexture2D::get_streaming_memory_usage() - initial_usage == uint64_t(Image::get_image_data_size(128, 128, Image::FORMAT_RGBA8, true) - Image::get_image_data_size(32, 32, Image::FORMAT_RGBA8, true)));
+
+		// Smaller requests never drop mipmaps.
+		texture->request_streaming_size(16);
+		texture->wait_for_streaming();
+		CHECK(texture->get_streaming_resident_size() == 128);
+
+		texture->request_streaming_size(4096);
+		texture->wait_for_streaming();
+		CHECK(texture->get_streaming_resident_size() == 256);
+		CHECK(texture->get_image()->get_width() == 256);
+	}
+
+	SUBCASE("Least recently used textures are evicted when over budget") {
+		ps->set_setting("rendering/textures/streaming/memory_budget_mb", 2);
+
+		// A full 1024×1024 L8 mipmap chain takes about 1.33 MiB, so only one fits in the budget.
+		Ref<CompressedTexture2D> first = _load_ctex("streaming_first.ctex", 1024, Image::FORMAT_L8);
+		Ref<CompressedTexture2D> second = _load_ctex("streaming_second.ctex", 1024, Image::FORMAT_L8);
+
+		first->request_streaming_size(1024);
+		first->wait_for_streaming();
+		CHECK(first->get_streaming_resident_size() == 1024);
+
+		second->request_streaming_size(1024);
+		second->wait_for_streaming();
+		CHECK(second->get_streaming_resident_size() == 1024);
+		CHECK(first->get_streaming_resident_size() == 32);
+		CHECK(first->get_image()->get_width() == 32);
+		CHECK(CompressedTexture2D::get_streaming_memory_usage() - initial_usage <= uint64_t(2 * 1024 * 1024));
+	}
+
+	SUBCASE("Textures sampled outside of 2D drawing are loaded whole and kept") {
+		ps->set_setting("rendering/textures/streaming/memory_budget_mb", 2);
+
+		Ref<CompressedTexture2D> pinned = _load_ctex("streaming_pinned.ctex", 1024, Image::FORMAT_L8);
+		Ref<CompressedTexture2D> drawn = _load_ctex("streaming_drawn.ctex", 1024, Image::FORMAT_L8);
+
+		// What a material or mesh does with the texture.
+		pinned->get_rid();
+		pinned->wait_for_streaming();
+		CHECK(pinned->get_streaming_resident_size() == 1024);
+
+		drawn->request_streaming_size(1024);
+		drawn->wait_for_streaming();
+		CHECK(drawn->get_streaming_resident_size() == 1024);
+		CHECK(pinned->get_streaming_resident_size() == 1024);
+	}
+
+	SUBCASE("Textures without mipmaps are loaded whole") {
+		Ref<Image> image = Image::create_empty(256, 256, false, Image::FORMAT_RGBA8);
+		String path = TestUtils::get_temp_path("streaming_no_mipmaps.ctex");
+		_save_ctex(path, image);
+
+		Ref<CompressedTexture2D> texture;
+		texture.instantiate();
+		CHECK(texture->load(path) == OK);
+		CHECK_FALSE(texture->is_streaming());
+		CHECK(texture->get_streaming_resident_size() == 256);
+		CHECK(texture->get_image()->get_width() == 256);
+	}
+
+	// Freed textures release their streamed mipmaps.
+	CHECK(CompressedTexture2D::get_streaming_memory_usage() == initial_usage);
+
+	ps->set_setting("rendering/textures/streaming/enabled", false);
+	ps->set_setting("rendering/textures/streaming/initial_size", 128);
+	ps->set_setting("rendering/textures/streaming/memory_budget_mb", 512);
+}
+
+} // namespace TestCompressedTexture
+
+#endif // TEST_COMPRESSED_TEXTURE_H
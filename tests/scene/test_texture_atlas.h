@@ -0,0 +1,189 @@
+/**************************************************************************/
+/*  test_texture_atlas.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_TEXTURE_ATLAS_H
+#define TEST_TEXTURE_ATLAS_H
+
+#include "core/io/dir_access.h"
+#include "core/io/resource_loader.h"
+#include "core/io/resource_saver.h"
+#include "scene/resources/texture_atlas.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestTextureAtlas {
+
+static Ref<Image> _make_image(int p_width, int p_height, const Color &p_color) {
+	Ref<Image> image = Image::create_empty(p_width, p_height, false, Image::FORMAT_RGBA8);
+	image->fill(p_color);
+	return image;
+}
+
+// [SceneTree] in a test case name enables initializing a mock render server,
+// which ImageTexture is dependent on.
+TEST_CASE("[SceneTree][TextureAtlas] Adding images until full") {
+	Ref<TextureAtlas> atlas;
+	atlas.instantiate();
+	atlas->set_size(Size2i(256, 256));
+
+	// 16×16 images take 18×18 pixels with the padding, so 14 rows of 14 fit.
+	Vector<int> ids;
+	Vector<Color> colors;
+	while (true) {
+		Ref<Image> source = _make_image(16, 16, Color(ids.size() / 255.0, 0.5, 0, 1));
+		int id = atlas->add_image(source);
+		if (id == -1) {
+			break;
+		}
+		ids.push_back(id);
+		colors.push_back(source->get_pixel(0, 0));
+	}
+	CHECK(ids.size() == 14 * 14);
+	CHECK(atlas->get_image_count() == 14 * 14);
+
+	Ref<Image> image = atlas->get_image();
+	REQUIRE(image.is_valid());
+	for (int i = 0; i < ids.size(); i++) {
+		Rect2i region = atlas->get_image_region(ids[i]);
+		CHECK(region.size == Size2i(16, 16));
+		CHECK(Rect2i(Point2i(), atlas->get_size()).encloses(region));
+		CHECK(image->get_pixelv(region.position) == image->get_pixelv(region.get_end() - Point2i(1, 1)));
+		CHECK(image->get_pixelv(region.position) == colors[i]);
+		for (int j = 0; j < i; j++) {
+			CHECK_FALSE(region.intersects(atlas->get_image_region(ids[j])));
+		}
+	}
+
+	// Images larger than the atlas never fit.
+	CHECK(atlas->add_image(_make_image(300, 10, Color(1, 1, 1, 1))) == -1);
+}
+
+TEST_CASE("[SceneTree][TextureAtlas] Removing images frees their space") {
+	Ref<TextureAtlas> atlas;
+	atlas.instantiate();
+	atlas->set_size(Size2i(128, 128));
+	atlas->set_padding(0);
+
+	Vector<int> ids;
+	for (int i = 0; i < 16; i++) {
+		ids.push_back(atlas->add_image(_make_image(32, 32, Color(0, 1, 0, 1))));
+		CHECK(ids[i] != -1);
+	}
+	CHECK(atlas->add_image(_make_image(32, 32, Color(0, 1, 0, 1))) == -1);
+
+	Rect2i removed_region = atlas->get_image_region(ids[5]);
+	atlas->remove_image(ids[5]);
+	CHECK_FALSE(atlas->has_image(ids[5]));
+	CHECK(atlas->get_image()->get_pixelv(removed_region.position) == Color(0, 0, 0, 0));
+
+	int id = atlas->add_image(_make_image(32, 32, Color(0, 0, 1, 1)));
+	CHECK(id != -1);
+	CHECK(atlas->get_image_region(id) == removed_region);
+
+	// Once empty, the whole atlas is available again, whatever the previous layout.
+	atlas->remove_image(id);
+	for (int i = 0; i < ids.size(); i++) {
+		if (i != 5) {
+			atlas->remove_image(ids[i]);
+		}
+	}
+	CHECK(atlas->get_image_count() == 0);
+	id = atlas->add_image(_make_image(128, 128, Color(1, 0, 0, 1)));
+	CHECK(id != -1);
+	CHECK(atlas->get_image_region(id) == Rect2i(0, 0, 128, 128));
+}
+
+TEST_CASE("[SceneTree][TextureAtlas] Texture updates") {
+	Ref<TextureAtlas> atlas;
+	atlas.instantiate();
+	atlas->set_size(Size2i(64, 64));
+
+	Ref<ImageTexture> texture = atlas->get_texture();
+	REQUIRE(texture.is_valid());
+	CHECK(texture->get_size() == Size2(64, 64));
+
+	int red = atlas->add_image(_make_image(8, 8, Color(1, 0, 0, 1)));
+	int green = atlas->add_image(_make_image(8, 4, Color(0, 1, 0, 1)));
+	atlas->update_texture();
+
+	// The texture stays the same, only its contents are updated.
+	CHECK(atlas->get_texture() == texture);
+	Ref<Image> uploaded = texture->get_image();
+	REQUIRE(uploaded.is_valid());
+	CHECK(uploaded->get_pixelv(atlas->get_image_region(red).position) == Color(1, 0, 0, 1));
+	CHECK(uploaded->get_pixelv(atlas->get_image_region(green).position) == Color(0, 1, 0, 1));
+
+	Ref<AtlasTexture> atlas_texture = atlas->get_image_texture(green);
+	REQUIRE(atlas_texture.is_valid());
+	CHECK(atlas_texture->get_atlas() == texture);
+	CHECK(atlas_texture->get_size() == Size2(8, 4));
+	CHECK(atlas_texture->get_rid() == texture->get_rid());
+}
+
+TEST_CASE("[SceneTree][TextureAtlas] Saving and loading") {
+	Ref<TextureAtlas> atlas;
+	atlas.instantiate();
+	atlas->set_size(Size2i(64, 32));
+	atlas->set_padding(0);
+
+	int red = atlas->add_image(_make_image(16, 16, Color(1, 0, 0, 1)));
+	int removed = atlas->add_image(_make_image(16, 16, Color(0, 1, 0, 1)));
+	int blue = atlas->add_image(_make_image(16, 8, Color(0, 0, 1, 1)));
+	Rect2i removed_region = atlas->get_image_region(removed);
+	atlas->remove_image(removed);
+
+	const String path = TestUtils::get_temp_path("texture_atlas.res");
+	REQUIRE(ResourceSaver::save(atlas, path) == OK);
+	Ref<TextureAtlas> loaded = ResourceLoader::load(path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(loaded.is_valid());
+
+	CHECK(loaded->get_size() == Size2i(64, 32));
+	CHECK(loaded->get_padding() == 0);
+	CHECK(loaded->get_image_count() == 2);
+	CHECK_FALSE(loaded->has_image(removed));
+	REQUIRE(loaded->has_image(red));
+	REQUIRE(loaded->has_image(blue));
+	CHECK(loaded->get_image_region(red) == atlas->get_image_region(red));
+	CHECK(loaded->get_image_region(blue) == atlas->get_image_region(blue));
+	REQUIRE(loaded->get_image().is_valid());
+	CHECK(loaded->get_image()->get_data() == atlas->get_image()->get_data());
+
+	// New images get new IDs and reuse the space of the removed one.
+	int green = loaded->add_image(_make_image(16, 16, Color(0, 1, 0, 1)));
+	CHECK(green > blue);
+	CHECK(loaded->get_image_region(green) == removed_region);
+
+	DirAccess::remove_absolute(path);
+}
+
+} // namespace TestTextureAtlas
+
+#endif // TEST_TEXTURE_ATLAS_H
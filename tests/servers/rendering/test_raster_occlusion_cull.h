@@ -0,0 +1,208 @@
+/**************************************************************************/
+/*  test_raster_occlusion_cull.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RASTER_OCCLUSION_CULL_H
+#define TEST_RASTER_OCCLUSION_CULL_H
+
+#include "servers/rendering/raster_occlusion_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRasterOcclusionCull {
+
+static void add_quad(PackedVector3Array &r_vertices, PackedInt32Array &r_indices, const Vector3 &p_origin, const Vector3 &p_u, const Vector3 &p_v) {
+	int32_t base = r_vertices.size();
+	r_vertices.push_back(p_origin);
+	r_vertices.push_back(p_origin + p_u);
+	r_vertices.push_back(p_origin + p_u + p_v);
+	r_vertices.push_back(p_origin + p_v);
+	r_indices.push_back(base);
+	r_indices.push_back(base + 1);
+	r_indices.push_back(base + 2);
+	r_indices.push_back(base);
+	r_indices.push_back(base + 2);
+	r_indices.push_back(base + 3);
+}
+
+static bool is_box_occluded(RendererSceneOcclusionCull::HZBuffer *p_buffer, const AABB &p_aabb, const Transform3D &p_cam_transform, const Projection &p_cam_projection) {
+	real_t bounds[6] = {
+		p_aabb.position.x, p_aabb.position.y, p_aabb.position.z,
+		p_aabb.position.x + p_aabb.size.x, p_aabb.position.y + p_aabb.size.y, p_aabb.position.z + p_aabb.size.z
+	};
+	uint64_t timeout = 0;
+	return p_buffer->is_occluded(bounds, p_cam_transform.origin, p_cam_transform.affine_inverse(), p_cam_projection, p_cam_projection.get_z_near(), timeout);
+}
+
+TEST_CASE("[RasterOcclusionCull] Rasterized depth and occlusion queries") {
+	RasterOcclusionCull *culler = memnew(RasterOcclusionCull);
+	const RID scenario = RID::from_uint64(1);
+	const RID instance = RID::from_uint64(2);
+	const RID buffer_rid = RID::from_uint64(3);
+
+	culler->add_scenario(scenario);
+	culler->add_buffer(buffer_rid);
+	culler->buffer_set_scenario(buffer_rid, scenario);
+	culler->buffer_set_size(buffer_rid, Vector2i(64, 48));
+
+	// A 10x10 wall, 10 units in front of the camera.
+	PackedVector3Array vertices;
+	PackedInt32Array indices;
+	add_quad(vertices, indices, Vector3(-5, -5, -10), Vector3(10, 0, 0), Vector3(0, 10, 0));
+
+	RID occluder = culler->occluder_allocate();
+	culler->occluder_initialize(occluder);
+	culler->occluder_set_mesh(occluder, vertices, indices);
+	culler->scenario_set_instance(scenario, instance, occluder, Transform3D(), true);
+
+	Transform3D cam_transform;
+	Projection cam_projection;
+	cam_projection.set_perspective(70, 64.0 / 48.0, 0.05, 100);
+
+	culler->buffer_update(buffer_rid, cam_transform, cam_projection, false);
+
+	RasterOcclusionCull::RasterHZBuffer *buffer = static_cast<RasterOcclusionCull::RasterHZBuffer *>(culler->buffer_get_ptr(buffer_rid));
+	REQUIRE(buffer != nullptr);
+	CHECK(buffer->get_triangle_count() == 2);
+
+	const float *depth = buffer->get_depth_buffer();
+	REQUIRE(depth != nullptr);
+	CHECK(depth[24 * 64 + 32] == doctest::Approx(10.0f).epsilon(0.001));
+	CHECK(depth[0] == FLT_MAX);
+
+	CHECK_MESSAGE(is_box_occluded(buffer, AABB(Vector3(-0.5, -0.5, -21), Vector3(1, 1, 1)), cam_transform, cam_projection), "Box behind the wall should be occluded.");
+	CHECK_FALSE_MESSAGE(is_box_occluded(buffer, AABB(Vector3(-0.5, -0.5, -6), Vector3(1, 1, 1)), cam_transform, cam_projection), "Box in front of the wall should be visible.");
+	CHECK_FALSE_MESSAGE(is_box_occluded(buffer, AABB(Vector3(12.5, -0.5, -21), Vector3(1, 1, 1)), cam_transform, cam_projection), "Box beside the wall should be visible.");
+
+	// Turning the camera around leaves the wall outside the frustum.
+	culler->buffer_update(buffer_rid, Transform3D(Basis(Vector3(0, 1, 0), Math_PI), Vector3()), cam_projection, false);
+	CHECK(buffer->get_triangle_count() == 0);
+
+	// A floor passing below and behind the camera gets clipped against the near plane.
+	vertices.clear();
+	indices.clear();
+	add_quad(vertices, indices, Vector3(-50, -1, 20), Vector3(100, 0, 0), Vector3(0, 0, -70));
+	culler->occluder_set_mesh(occluder, vertices, indices);
+	culler->buffer_update(buffer_rid, cam_transform, cam_projection, false);
+	CHECK(buffer->get_triangle_count() > 0);
+
+	bool depth_valid = true;
+	for (int i = 0; i < 64 * 48; i++) {
+		depth_valid = depth_valid && depth[i] > 0.0f && !Math::is_nan(depth[i]);
+	}
+	CHECK_MESSAGE(depth_valid, "Clipped triangles should only produce positive depth.");
+	CHECK(depth[0] < 2.0f); // Bottom row sees the floor close to the camera.
+	CHECK(depth[47 * 64] == FLT_MAX); // Top row sees the sky.
+
+	// Disabling the instance removes it from the buffer.
+	culler->scenario_set_instance(scenario, instance, occluder, Transform3D(), false);
+	culler->buffer_update(buffer_rid, cam_transform, cam_projection, false);
+	CHECK(buffer->get_triangle_count() == 0);
+	CHECK(depth[0] == FLT_MAX);
+
+	culler->scenario_remove_instance(scenario, instance);
+	culler->free_occluder(occluder);
+	culler->remove_buffer(buffer_rid);
+	culler->remove_scenario(scenario);
+	memdelete(culler);
+}
+
+TEST_CASE("[RasterOcclusionCull] Occluders around the camera") {
+	RasterOcclusionCull *culler = memnew(RasterOcclusionCull);
+	const RID scenario = RID::from_uint64(1);
+	const RID buffer_rid = RID::from_uint64(2);
+
+	culler->add_scenario(scenario);
+	culler->add_buffer(buffer_rid);
+	culler->buffer_set_scenario(buffer_rid, scenario);
+	culler->buffer_set_size(buffer_rid, Vector2i(64, 36));
+
+	// A closed unit box occluder.
+	PackedVector3Array vertices;
+	PackedInt32Array indices;
+	add_quad(vertices, indices, Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(0, 1, 0));
+	add_quad(vertices, indices, Vector3(0, 0, 1), Vector3(1, 0, 0), Vector3(0, 1, 0));
+	add_quad(vertices, indices, Vector3(0, 0, 0), Vector3(0, 0, 1), Vector3(0, 1, 0));
+	add_quad(vertices, indices, Vector3(1, 0, 0), Vector3(0, 0, 1), Vector3(0, 1, 0));
+	add_quad(vertices, indices, Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(0, 0, 1));
+	add_quad(vertices, indices, Vector3(0, 1, 0), Vector3(1, 0, 0), Vector3(0, 0, 1));
+
+	RID occluder = culler->occluder_allocate();
+	culler->occluder_initialize(occluder);
+	culler->occluder_set_mesh(occluder, vertices, indices);
+
+	// A ring of 4x4x4 boxes, 10 units away from the camera in eight directions.
+	const int instance_count = 8;
+	for (int i = 0; i < instance_count; i++) {
+		Transform3D direction(Basis(Vector3(0, 1, 0), Math_TAU * i / instance_count), Vector3());
+		Transform3D xform;
+		xform.basis.scale(Vector3(4, 4, 4));
+		xform.origin = direction.xform(Vector3(0, 0, -10)) - Vector3(2, 2, 2);
+		culler->scenario_set_instance(scenario, RID::from_uint64(100 + i), occluder, xform, true);
+	}
+
+	Projection cam_projection;
+	cam_projection.set_perspective(70, 16.0 / 9.0, 0.05, 100);
+
+	RasterOcclusionCull::RasterHZBuffer *buffer = static_cast<RasterOcclusionCull::RasterHZBuffer *>(culler->buffer_get_ptr(buffer_rid));
+	REQUIRE(buffer != nullptr);
+
+	// Turn the camera to face each box in turn.
+	for (int i = 0; i < instance_count; i++) {
+		Transform3D cam_transform(Basis(Vector3(0, 1, 0), Math_TAU * i / instance_count), Vector3());
+		culler->buffer_update(buffer_rid, cam_transform, cam_projection, false);
+		CHECK(buffer->get_triangle_count() > 0);
+
+		// Boxes facing the camera are 8 units away, rotated ones show their edge a bit closer.
+		const float *depth = buffer->get_depth_buffer();
+		REQUIRE(depth != nullptr);
+		CHECK(depth[18 * 64 + 32] > 7.0f);
+		CHECK(depth[18 * 64 + 32] < 8.01f);
+
+		Vector3 behind = cam_transform.xform(Vector3(0, 0, -15));
+		Vector3 in_front = cam_transform.xform(Vector3(0, 0, -5));
+		CHECK_MESSAGE(is_box_occluded(buffer, AABB(behind - Vector3(0.25, 0.25, 0.25), Vector3(0.5, 0.5, 0.5)), cam_transform, cam_projection), "Box behind an occluder should be occluded.");
+		CHECK_FALSE_MESSAGE(is_box_occluded(buffer, AABB(in_front - Vector3(0.25, 0.25, 0.25), Vector3(0.5, 0.5, 0.5)), cam_transform, cam_projection), "Box in front of an occluder should be visible.");
+	}
+
+	for (int i = 0; i < instance_count; i++) {
+		culler->scenario_remove_instance(scenario, RID::from_uint64(100 + i));
+	}
+	culler->buffer_update(buffer_rid, Transform3D(), cam_projection, false);
+	CHECK(buffer->get_triangle_count() == 0);
+
+	culler->free_occluder(occluder);
+	culler->remove_buffer(buffer_rid);
+	culler->remove_scenario(scenario);
+	memdelete(culler);
+}
+
+} // namespace TestRasterOcclusionCull
+
+#endif // TEST_RASTER_OCCLUSION_CULL_H
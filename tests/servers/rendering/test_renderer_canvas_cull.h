@@ -0,0 +1,369 @@
+/**************************************************************************/
+/*  test_renderer_canvas_cull.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_CANVAS_CULL_H
+#define TEST_RENDERER_CANVAS_CULL_H
+
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+class TestRendererCanvasCullInternalsAccessor {
+public:
+	static const RendererCanvasRender::Item *merged_item(RID p_first_item) {
+		RendererCanvasCull::Item *item = RSG::canvas->canvas_item_owner.get_or_null(p_first_item);
+		HashMap<RendererCanvasCull::Item *, RendererCanvasCull::MergedItem>::ConstIterator E = RSG::canvas->merged_items.find(item);
+		return E ? E->value.item : nullptr;
+	}
+
+	static const RendererCanvasRender::Item *item(RID p_item) {
+		return RSG::canvas->canvas_item_owner.get_or_null(p_item);
+	}
+
+	static void resolve_storage_rects(RID p_item) {
+		RSG::canvas->_resolve_storage_rects(RSG::canvas->canvas_item_owner.get_or_null(p_item));
+	}
+};
+
+namespace TestRendererCanvasCull {
+
+// Each call is a new frame, unless drawing the same canvas from another viewport.
+static void render_canvas(RID p_canvas, const Transform2D &p_transform = Transform2D(), bool p_new_frame = true) {
+	RendererCanvasCull::Canvas *canvas = RSG::canvas->canvas_owner.get_or_null(p_canvas);
+	REQUIRE(canvas != nullptr);
+	if (p_new_frame) {
+		RSG::rasterizer->begin_frame(0);
+	}
+	RSG::canvas->render_canvas(RID(), canvas, p_transform, nullptr, nullptr, Rect2(0, 0, 1024, 1024), RS::CANVAS_ITEM_TEXTURE_FILTER_LINEAR, RS::CANVAS_ITEM_TEXTURE_REPEAT_DISABLED, false, false, 0xFFFFFFFF);
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Merge neighboring canvas items") {
+	const bool merge_items_enabled = RSG::canvas->is_merge_items_enabled();
+	RSG::canvas->set_merge_items_enabled(true);
+
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RID canvas = rs->canvas_create();
+	RID texture = rs->texture_2d_placeholder_create();
+	RID other_texture = rs->texture_2d_placeholder_create();
+
+	LocalVector<RID> items;
+	for (int i = 0; i < 8; i++) {
+		RID item = rs->canvas_item_create();
+		rs->canvas_item_set_parent(item, canvas);
+		rs->canvas_item_set_transform(item, Transform2D(0.0, Vector2(i * 20, 0)));
+		rs->canvas_item_add_texture_rect(item, Rect2(0, 0, 16, 16), texture);
+		items.push_back(item);
+	}
+
+	render_canvas(canvas);
+	CHECK_MESSAGE(RSG::canvas->get_merged_batch_count() == 1, "Items sharing a texture should be merged into one batch.");
+	CHECK(RSG::canvas->get_merged_item_count() == 8);
+
+	// Rendering again reuses the cached batch, and still reports it.
+	render_canvas(canvas);
+	CHECK(RSG::canvas->get_merged_batch_count() == 1);
+	CHECK(RSG::canvas->get_merged_item_count() == 8);
+
+	// An item with a different texture splits the run, and is drawn on its own.
+	rs->canvas_item_clear(items[4]);
+	rs->canvas_item_add_texture_rect(items[4], Rect2(0, 0, 16, 16), other_texture);
+	render_canvas(canvas);
+	CHECK(RSG::canvas->get_merged_batch_count() == 2);
+	CHECK(RSG::canvas->get_merged_item_count() == 7);
+
+	// Items that copy the screen to the back buffer are never merged.
+	for (int i = 0; i < 4; i++) {
+		rs->canvas_item_set_copy_to_backbuffer(items[i], true, Rect2());
+	}
+	render_canvas(canvas);
+	CHECK(RSG::canvas->get_merged_batch_count() == 1);
+	CHECK(RSG::canvas->get_merged_item_count() == 3);
+
+	for (const RID &item : items) {
+		rs->free(item);
+	}
+	rs->free(other_texture);
+	rs->free(texture);
+	rs->free(canvas);
+	RSG::canvas->set_merge_items_enabled(merge_items_enabled);
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Merged items keep the transform and modulate of each source") {
+	const bool merge_items_enabled = RSG::canvas->is_merge_items_enabled();
+	RSG::canvas->set_merge_items_enabled(true);
+
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RID canvas = rs->canvas_create();
+	RID texture = rs->texture_2d_placeholder_create();
+
+	RID items[3];
+	for (int i = 0; i < 3; i++) {
+		items[i] = rs->canvas_item_create();
+		rs->canvas_item_set_parent(items[i], canvas);
+		rs->canvas_item_set_transform(items[i], Transform2D(0.5 * i, Size2(1 + i, 1), 0, Vector2(i * 20, 10)));
+		rs->canvas_item_set_modulate(items[i], Color(1, 0.5, 0.25 * i, 1 - 0.25 * i));
+	}
+	rs->canvas_item_add_texture_rect(items[0], Rect2(0, 0, 16, 16), texture, false, Color(0.5, 1, 1, 1));
+	rs->canvas_item_add_nine_patch(items[1], Rect2(0, 0, 16, 16), Rect2(0, 0, 8, 8), texture, Vector2(2, 2), Vector2(2, 2), RS::NINE_PATCH_STRETCH, RS::NINE_PATCH_STRETCH, true, Color(1, 0.5, 1, 1));
+	Vector<Point2> points = { Point2(0, 0), Point2(16, 0), Point2(16, 16) };
+	Vector<Color> colors = { Color(1, 0, 0), Color(0, 1, 0), Color(0, 0, 1) };
+	Vector<Point2> uvs = { Point2(0, 0), Point2(1, 0), Point2(1, 1) };
+	rs->canvas_item_add_primitive(items[2], points, colors, uvs, texture);
+
+	render_canvas(canvas, Transform2D(0.0, Vector2(100, 0)));
+
+	const RendererCanvasRender::Item *merged_item = TestRendererCanvasCullInternalsAccessor::merged_item(items[0]);
+	REQUIRE(merged_item != nullptr);
+	CHECK(merged_item->final_transform == Transform2D());
+	CHECK(merged_item->final_modulate == Color(1, 1, 1, 1));
+
+	const RendererCanvasCull::Item *sources[3];
+	for (int i = 0; i < 3; i++) {
+		sources[i] = RSG::canvas->canvas_item_owner.get_or_null(items[i]);
+		REQUIRE(sources[i] != nullptr);
+	}
+
+	// Each source draws after a transform command with its own final transform.
+	const RendererCanvasRender::Item::Command *c = merged_item->commands;
+	for (int i = 0; i < 3; i++) {
+		REQUIRE(c != nullptr);
+		REQUIRE(c->type == RendererCanvasRender::Item::Command::TYPE_TRANSFORM);
+		CHECK(static_cast<const RendererCanvasRender::Item::CommandTransform *>(c)->xform == sources[i]->final_transform);
+		c = c->next;
+		REQUIRE(c != nullptr);
+
+		const Color &modulate = sources[i]->final_modulate;
+		switch (i) {
+			case 0: {
+				REQUIRE(c->type == RendererCanvasRender::Item::Command::TYPE_RECT);
+				CHECK(static_cast<const RendererCanvasRender::Item::CommandRect *>(c)->modulate == Color(0.5, 1, 1, 1) * modulate);
+			} break;
+			case 1: {
+				REQUIRE(c->type == RendererCanvasRender::Item::Command::TYPE_NINEPATCH);
+				CHECK(static_cast<const RendererCanvasRender::Item::CommandNinePatch *>(c)->color == Color(1, 0.5, 1, 1) * modulate);
+			} break;
+			case 2: {
+				REQUIRE(c->type == RendererCanvasRender::Item::Command::TYPE_PRIMITIVE);
+				const RendererCanvasRender::Item::CommandPrimitive *primitive = static_cast<const RendererCanvasRender::Item::CommandPrimitive *>(c);
+				REQUIRE(primitive->point_count == 3);
+				for (int j = 0; j < 3; j++) {
+					CHECK(primitive->colors[j] == colors[j] * modulate);
+				}
+			} break;
+		}
+		c = c->next;
+	}
+	CHECK(c == nullptr);
+
+	rs->free(items[0]);
+	rs->free(items[1]);
+	rs->free(items[2]);
+	rs->free(texture);
+	rs->free(canvas);
+	RSG::canvas->set_merge_items_enabled(merge_items_enabled);
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Items drawn by several viewports are not merged") {
+	const bool merge_items_enabled = RSG::canvas->is_merge_items_enabled();
+	RSG::canvas->set_merge_items_enabled(true);
+
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RID canvas = rs->canvas_create();
+	RID texture = rs->texture_2d_placeholder_create();
+
+	LocalVector<RID> items;
+	for (int i = 0; i < 4; i++) {
+		RID item = rs->canvas_item_create();
+		rs->canvas_item_set_parent(item, canvas);
+		rs->canvas_item_set_transform(item, Transform2D(0.0, Vector2(i * 20, 0)));
+		rs->canvas_item_add_texture_rect(item, Rect2(0, 0, 16, 16), texture);
+		items.push_back(item);
+	}
+
+	// Two viewports with the same transform share the merged item.
+	render_canvas(canvas);
+	render_canvas(canvas, Transform2D(), false);
+	CHECK(RSG::canvas->get_merged_batch_count() == 2);
+
+	// With different transforms, it would be rebuilt for each of them.
+	render_canvas(canvas);
+	render_canvas(canvas, Transform2D(0.0, Vector2(0, 100)), false);
+	CHECK_MESSAGE(RSG::canvas->get_merged_batch_count() == 1, "Only the first viewport should draw the merged item.");
+
+	render_canvas(canvas);
+	render_canvas(canvas, Transform2D(0.0, Vector2(0, 100)), false);
+	CHECK_MESSAGE(RSG::canvas->get_merged_batch_count() == 0, "Items drawn by several viewports should not be merged.");
+
+	// Merging resumes once a single viewport is left.
+	render_canvas(canvas);
+	render_canvas(canvas);
+	CHECK(RSG::canvas->get_merged_batch_count() == 1);
+
+	for (const RID &item : items) {
+		rs->free(item);
+	}
+	rs->free(texture);
+	rs->free(canvas);
+	RSG::canvas->set_merge_items_enabled(merge_items_enabled);
+}
+
+static LocalVector<int> visible_order;
+
+static void on_item_visible(int p_index) {
+	visible_order.push_back(p_index);
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Threaded culling keeps the draw order") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RID canvas = rs->canvas_create();
+	RID parent = rs->canvas_item_create();
+	rs->canvas_item_set_parent(parent, canvas);
+
+	// Enough children to be culled on the worker threads with the default settings.
+	const int item_count = 1500;
+	LocalVector<RID> items;
+	for (int i = 0; i < item_count; i++) {
+		RID item = rs->canvas_item_create();
+		rs->canvas_item_set_parent(item, parent);
+		rs->canvas_item_set_transform(item, Transform2D(0.0, Vector2((i % 50) * 20, (item_count - i) * 0.5)));
+		rs->canvas_item_set_visibility_notifier(item, true, Rect2(0, 0, 8, 8), callable_mp_static(&on_item_visible).bind(i), Callable());
+		items.push_back(item);
+	}
+
+	// Visibility notifiers are registered in the order items are culled in.
+	visible_order.clear();
+	render_canvas(canvas);
+	RSG::canvas->update_visibility_notifiers();
+	REQUIRE(visible_order.size() == (uint32_t)item_count);
+	bool in_tree_order = true;
+	for (int i = 0; i < item_count; i++) {
+		in_tree_order = in_tree_order && visible_order[i] == i;
+	}
+	CHECK_MESSAGE(in_tree_order, "Children should be culled in tree order.");
+
+	// Y-sorting reverses the order, as the last children are at the top.
+	for (const RID &item : items) {
+		rs->canvas_item_set_visibility_notifier(item, false, Rect2(), Callable(), Callable());
+	}
+	for (int i = 0; i < item_count; i++) {
+		rs->canvas_item_set_visibility_notifier(items[i], true, Rect2(0, 0, 8, 8), callable_mp_static(&on_item_visible).bind(i), Callable());
+	}
+	rs->canvas_item_set_sort_children_by_y(parent, true);
+
+	visible_order.clear();
+	render_canvas(canvas);
+	RSG::canvas->update_visibility_notifiers();
+	REQUIRE(visible_order.size() == (uint32_t)item_count);
+	bool in_y_order = true;
+	for (int i = 0; i < item_count; i++) {
+		in_y_order = in_y_order && visible_order[i] == item_count - 1 - i;
+	}
+	CHECK_MESSAGE(in_y_order, "Y-sorted children should be culled from top to bottom.");
+
+	for (const RID &item : items) {
+		rs->free(item);
+	}
+	rs->free(parent);
+	rs->free(canvas);
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Threaded culling resolves storage rects before the tasks") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RID canvas = rs->canvas_create();
+	RID parent = rs->canvas_item_create();
+	rs->canvas_item_set_parent(parent, canvas);
+
+	const int item_count = 1500;
+	const int multimesh_index = item_count / 2;
+	LocalVector<RID> items;
+	for (int i = 0; i < item_count; i++) {
+		RID item = rs->canvas_item_create();
+		rs->canvas_item_set_parent(item, parent);
+		rs->canvas_item_set_transform(item, Transform2D(0.0, Vector2((i % 50) * 20, (i / 50) * 20)));
+		rs->canvas_item_set_visibility_notifier(item, true, Rect2(0, 0, 8, 8), callable_mp_static(&on_item_visible).bind(i), Callable());
+		items.push_back(item);
+	}
+	for (int i = 0; i < item_count; i++) {
+		if (i != multimesh_index) {
+			rs->canvas_item_add_rect(items[i], Rect2(0, 0, 8, 8), Color(1, 1, 1));
+		}
+	}
+
+	// Changing the instances leaves the multimesh dirty until its AABB is queried.
+	RID multimesh = rs->multimesh_create();
+	rs->multimesh_allocate_data(multimesh, 4, RS::MULTIMESH_TRANSFORM_2D);
+	for (int i = 0; i < 4; i++) {
+		rs->multimesh_instance_set_transform_2d(multimesh, i, Transform2D(0.0, Vector2(i * 2, 0)));
+	}
+	rs->canvas_item_add_multimesh(items[multimesh_index], multimesh);
+
+	const RendererCanvasRender::Item *multimesh_item = TestRendererCanvasCullInternalsAccessor::item(items[multimesh_index]);
+	const RendererCanvasRender::Item *rect_item = TestRendererCanvasCullInternalsAccessor::item(items[0]);
+	CHECK(multimesh_item->rect_from_storage);
+	CHECK_FALSE(rect_item->rect_from_storage);
+
+	SUBCASE("Only rects from storage are resolved up front") {
+		REQUIRE(multimesh_item->rect_dirty);
+		REQUIRE(rect_item->rect_dirty);
+		TestRendererCanvasCullInternalsAccessor::resolve_storage_rects(parent);
+		CHECK_FALSE_MESSAGE(multimesh_item->rect_dirty, "The multimesh rect should be resolved on the calling thread.");
+		CHECK_MESSAGE(rect_item->rect_dirty, "Other rects should be left to the cull tasks.");
+	}
+
+	SUBCASE("The multimesh item is culled in order with its siblings") {
+		visible_order.clear();
+		render_canvas(canvas);
+		RSG::canvas->update_visibility_notifiers();
+		REQUIRE(visible_order.size() == (uint32_t)item_count);
+		bool in_tree_order = true;
+		for (int i = 0; i < item_count; i++) {
+			in_tree_order = in_tree_order && visible_order[i] == i;
+		}
+		CHECK(in_tree_order);
+		CHECK_FALSE(multimesh_item->rect_dirty);
+	}
+
+	SUBCASE("Clearing the item forgets the storage dependency") {
+		rs->canvas_item_clear(items[multimesh_index]);
+		CHECK_FALSE(multimesh_item->rect_from_storage);
+	}
+
+	for (const RID &item : items) {
+		rs->free(item);
+	}
+	rs->free(multimesh);
+	rs->free(parent);
+	rs->free(canvas);
+}
+
+} // namespace TestRendererCanvasCull
+
+#endif // TEST_RENDERER_CANVAS_CULL_H
@@ -0,0 +1,357 @@
+/**************************************************************************/
+/*  test_renderer_scene_cull.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_SCENE_CULL_H
+#define TEST_RENDERER_SCENE_CULL_H
+
+#include "core/math/dynamic_bvh.h"
+#include "core/math/geometry_3d.h"
+#include "servers/rendering/renderer_scene_cull.h"
+#include "servers/rendering_server.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererSceneCull {
+
+TEST_CASE("[RendererSceneCull] Instance bounds array") {
+	RendererSceneCull::InstanceBoundsArray bounds;
+	bounds.push_back(RendererSceneCull::InstanceBounds(AABB(Vector3(1, 2, 3), Vector3(4, 5, 6))));
+	bounds.push_back(RendererSceneCull::InstanceBounds(AABB(Vector3(-1, -2, -3), Vector3(1, 1, 1))));
+	CHECK(bounds.size() == 2);
+
+	RendererSceneCull::InstanceBounds first = bounds[0];
+	CHECK(first.bounds[0] == 1);
+	CHECK(first.bounds[2] == 3);
+	CHECK(first.bounds[3] == 5);
+	CHECK(first.bounds[5] == 9);
+
+	// Removing the first instance swaps the last one in, like instance removal from a scenario.
+	bounds.set(0, bounds[1]);
+	bounds.pop_back();
+	CHECK(bounds.size() == 1);
+	CHECK(bounds[0].bounds[0] == -1);
+	CHECK(bounds[0].bounds[4] == -1);
+
+	bounds.reset();
+	CHECK(bounds.size() == 0);
+}
+
+TEST_CASE("[RendererSceneCull] Block frustum culling matches per-instance culling") {
+	// Camera at the origin looking down -Z, seeing x and y in [-10, 10] at a distance of 10.
+	Projection projection;
+	projection.set_perspective(90, 1, 0.1, 100);
+	RendererSceneCull::Frustum frustum(projection.get_projection_planes(Transform3D()));
+
+	const AABB aabbs[] = {
+		AABB(Vector3(-0.5, -0.5, -10.5), Vector3(1, 1, 1)), // In front.
+		AABB(Vector3(-0.5, -0.5, 9.5), Vector3(1, 1, 1)), // Behind.
+		AABB(Vector3(-0.5, -0.5, -200.5), Vector3(1, 1, 1)), // Past the far plane.
+		AABB(Vector3(-20, -0.5, -10.5), Vector3(20, 1, 1)), // Crossing the left plane.
+		AABB(Vector3(-30, -0.5, -10.5), Vector3(10, 1, 1)), // Left of the left plane.
+	};
+	const bool expected_inside[] = { true, false, false, true, false };
+	const uint32_t kinds = sizeof(aabbs) / sizeof(aabbs[0]);
+
+	// Two full blocks and a partial one.
+	const uint32_t instance_count = RendererSceneCull::InstanceBoundsArray::CULL_BLOCK_SIZE * 2 + 3;
+	RendererSceneCull::InstanceBoundsArray bounds;
+	for (uint32_t i = 0; i < instance_count; i++) {
+		bounds.push_back(RendererSceneCull::InstanceBounds(aabbs[i % kinds]));
+	}
+
+	LocalVector<uint8_t> inside;
+	inside.resize(instance_count);
+	for (uint32_t from = 0; from < instance_count; from += RendererSceneCull::InstanceBoundsArray::CULL_BLOCK_SIZE) {
+		uint32_t to = MIN(from + RendererSceneCull::InstanceBoundsArray::CULL_BLOCK_SIZE, instance_count);
+		bounds.cull_frustum(frustum, from, to, &inside[from]);
+	}
+
+	for (uint32_t i = 0; i < kinds; i++) {
+		CHECK(RendererSceneCull::InstanceBounds(aabbs[i]).in_frustum(frustum) == expected_inside[i]);
+	}
+
+	bool all_match = true;
+	for (uint32_t i = 0; i < instance_count; i++) {
+		all_match = all_match && bool(inside[i]) == expected_inside[i % kinds];
+	}
+	CHECK_MESSAGE(all_match, "Block frustum culling should give the same result as InstanceBounds::in_frustum().");
+}
+
+TEST_CASE("[RendererSceneCull] Multi-view BVH culling matches per-view queries") {
+	// A row of unit boxes along the X axis, 2 units apart.
+	DynamicBVH bvh;
+	const int instance_count = 150;
+	for (int i = 0; i < instance_count; i++) {
+		bvh.insert(AABB(Vector3(i * 2 - 0.5, -0.5, -0.5), Vector3(1, 1, 1)), (void *)(intptr_t)(i + 1));
+	}
+
+	// More views than fit in a single multi-query. Each one is a box around instance 2 * i,
+	// wide enough to also reach the instances on either side.
+	const int view_count = DynamicBVH::MAX_CONVEX_MULTI_QUERIES + 6;
+	LocalVector<Vector<Plane>> view_planes;
+	LocalVector<Vector<Vector3>> view_points;
+	for (int i = 0; i < view_count; i++) {
+		Transform3D xform(Basis(), Vector3(i * 4, 0, 0));
+		Vector<Plane> planes = Geometry3D::build_box_planes(Vector3(2.2, 1, 1));
+		for (int j = 0; j < planes.size(); j++) {
+			planes.write[j] = xform.xform(planes[j]);
+		}
+		view_planes.push_back(planes);
+		view_points.push_back(Geometry3D::compute_convex_mesh_points(&planes[0], planes.size()));
+	}
+
+	struct CullConvex {
+		LocalVector<intptr_t> *result;
+		bool operator()(void *p_data) {
+			result->push_back((intptr_t)p_data);
+			return false;
+		}
+	};
+
+	struct CullConvexMulti {
+		LocalVector<LocalVector<intptr_t>> *results;
+		uint32_t offset = 0;
+		bool operator()(void *p_data, uint64_t p_mask) {
+			for (uint32_t i = 0; i < DynamicBVH::MAX_CONVEX_MULTI_QUERIES; i++) {
+				if (p_mask & (uint64_t(1) << i)) {
+					(*results)[offset + i].push_back((intptr_t)p_data);
+				}
+			}
+			return false;
+		}
+	};
+
+	LocalVector<LocalVector<intptr_t>> expected;
+	expected.resize(view_count);
+	for (int i = 0; i < view_count; i++) {
+		CullConvex cull;
+		cull.result = &expected[i];
+		bvh.convex_query(view_planes[i].ptr(), view_planes[i].size(), view_points[i].ptr(), view_points[i].size(), cull);
+	}
+
+	LocalVector<LocalVector<intptr_t>> results;
+	results.resize(view_count);
+	DynamicBVH::ConvexQuery queries[DynamicBVH::MAX_CONVEX_MULTI_QUERIES];
+	for (uint32_t from = 0; from < (uint32_t)view_count; from += DynamicBVH::MAX_CONVEX_MULTI_QUERIES) {
+		uint32_t count = MIN(view_count - from, DynamicBVH::MAX_CONVEX_MULTI_QUERIES);
+		for (uint32_t i = 0; i < count; i++) {
+			queries[i].planes = view_planes[from + i].ptr();
+			queries[i].plane_count = view_planes[from + i].size();
+			queries[i].points = view_points[from + i].ptr();
+			queries[i].point_count = view_points[from + i].size();
+		}
+		CullConvexMulti cull;
+		cull.results = &results;
+		cull.offset = from;
+		bvh.convex_query_multi(queries, count, cull);
+	}
+
+	// Instances 2 * i - 1, 2 * i and 2 * i + 1, except for the first view which has nothing on its left.
+	CHECK(expected[0].size() == 2);
+	LocalVector<intptr_t> second = expected[1];
+	second.sort();
+	REQUIRE(second.size() == 3);
+	CHECK(second[0] == 2);
+	CHECK(second[1] == 3);
+	CHECK(second[2] == 4);
+
+	bool all_match = true;
+	for (int i = 0; i < view_count; i++) {
+		all_match = all_match && expected[i].size() == (i == 0 ? 2u : 3u);
+		all_match = all_match && results[i].size() == expected[i].size();
+		for (uint32_t j = 0; all_match && j < expected[i].size(); j++) {
+			all_match = results[i][j] == expected[i][j];
+		}
+	}
+	CHECK_MESSAGE(all_match, "Multi-view culling should report the same instances, in the same order, as one query per view.");
+}
+
+TEST_CASE("[RendererSceneCull] Deferred BVH refit matches per-instance updates") {
+	// A 20x10 grid of unit boxes, 3 units apart.
+	DynamicBVH bvh_update;
+	DynamicBVH bvh_refit;
+	const int instance_count = 200;
+	LocalVector<AABB> aabbs;
+	LocalVector<DynamicBVH::ID> ids_update;
+	LocalVector<DynamicBVH::ID> ids_refit;
+	for (int i = 0; i < instance_count; i++) {
+		aabbs.push_back(AABB(Vector3(i % 20 * 3, 0, i / 20 * 3), Vector3(1, 1, 1)));
+		ids_update.push_back(bvh_update.insert(aabbs[i], (void *)(intptr_t)(i + 1)));
+		ids_refit.push_back(bvh_refit.insert(aabbs[i], (void *)(intptr_t)(i + 1)));
+	}
+
+	// A crowd walking along X, with every tenth instance teleported away on the first frame.
+	// The others end up 1 unit further, so each one still fits in a single tile queried below.
+	const int frames = 4;
+	for (int frame = 0; frame < frames; frame++) {
+		for (int i = 0; i < instance_count; i++) {
+			if (i % 10 == 0) {
+				aabbs[i].position = Vector3(100 + i, 50, 0);
+			} else {
+				aabbs[i].position.x += 0.25;
+			}
+		}
+
+		for (int i = 0; i < instance_count; i++) {
+			bvh_update.update(ids_update[i], aabbs[i]);
+		}
+
+		for (int i = 0; i < instance_count; i++) {
+			bvh_refit.update_deferred(ids_refit[i], aabbs[i]);
+		}
+		bvh_refit.refit();
+	}
+
+	struct CullAABB {
+		LocalVector<intptr_t> *result;
+		bool operator()(void *p_data) {
+			result->push_back((intptr_t)p_data);
+			return false;
+		}
+	};
+
+	// Tiles covering the grid, and the area the teleported instances were moved to.
+	LocalVector<AABB> queries;
+	for (int z = 0; z < 3; z++) {
+		for (int x = 0; x < 7; x++) {
+			queries.push_back(AABB(Vector3(x * 10, -1, z * 10), Vector3(10, 3, 10)));
+		}
+	}
+	const AABB teleported(Vector3(99, 49, -1), Vector3(200, 3, 3));
+	queries.push_back(teleported);
+
+	bool all_match = true;
+	int total = 0;
+	for (const AABB &query : queries) {
+		LocalVector<intptr_t> expected;
+		for (int j = 0; j < instance_count; j++) {
+			if (aabbs[j].intersects(query)) {
+				expected.push_back(j + 1);
+			}
+		}
+
+		LocalVector<intptr_t> from_update;
+		CullAABB cull_update;
+		cull_update.result = &from_update;
+		bvh_update.aabb_query(query, cull_update);
+
+		LocalVector<intptr_t> from_refit;
+		CullAABB cull_refit;
+		cull_refit.result = &from_refit;
+		bvh_refit.aabb_query(query, cull_refit);
+
+		from_update.sort();
+		from_refit.sort();
+		total += expected.size();
+		all_match = all_match && from_update.size() == expected.size() && from_refit.size() == expected.size();
+		for (uint32_t j = 0; all_match && j < expected.size(); j++) {
+			all_match = from_update[j] == expected[j] && from_refit[j] == expected[j];
+		}
+	}
+	// Every instance is in exactly one of the queried areas.
+	CHECK(total == instance_count);
+	CHECK_MESSAGE(all_match, "Refit BVH should find the same instances as a BVH updated per instance.");
+
+	// Removing instances right after deferred updates must not leave stale leaves behind.
+	for (int i = 0; i < instance_count; i += 2) {
+		aabbs[i].position.y += 0.1;
+		bvh_refit.update_deferred(ids_refit[i], aabbs[i]);
+		bvh_refit.remove(ids_refit[i]);
+	}
+	bvh_refit.refit();
+	CHECK(bvh_refit.get_leaf_count() == instance_count / 2);
+}
+
+TEST_CASE("[SceneTree][RendererSceneCull] Bulk instance updates") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RID scenario = rs->scenario_create();
+	RID mesh = rs->mesh_create();
+
+	const int instance_count = 100;
+	Vector<RID> instances;
+	Vector<float> transforms;
+	Vector<float> aabbs;
+	for (int i = 0; i < instance_count; i++) {
+		RID instance = rs->instance_create2(mesh, scenario);
+		rs->instance_attach_object_instance_id(instance, ObjectID(uint64_t(i + 1)));
+		instances.push_back(instance);
+
+		// Identity basis, placed along the X axis.
+		const float transform[12] = { 1, 0, 0, i * 10.0f, 0, 1, 0, 0, 0, 0, 1, 0 };
+		for (int j = 0; j < 12; j++) {
+			transforms.push_back(transform[j]);
+		}
+		const float aabb[6] = { -0.5, -0.5, -0.5, 1, 1, 1 };
+		for (int j = 0; j < 6; j++) {
+			aabbs.push_back(aabb[j]);
+		}
+	}
+
+	rs->instances_set_custom_aabbs(instances, aabbs);
+	rs->instances_set_transforms(instances, transforms);
+
+	Vector<ObjectID> found = rs->instances_cull_aabb(AABB(Vector3(49, -1, -1), Vector3(2, 2, 2)), scenario);
+	REQUIRE(found.size() == 1);
+	CHECK(found[0] == ObjectID(uint64_t(6)));
+
+	// Move everything up, the old position must be empty.
+	for (int i = 0; i < instance_count; i++) {
+		transforms.write[i * 12 + 7] = 100;
+	}
+	rs->instances_set_transforms(instances, transforms);
+	CHECK(rs->instances_cull_aabb(AABB(Vector3(49, -1, -1), Vector3(2, 2, 2)), scenario).is_empty());
+	CHECK(rs->instances_cull_aabb(AABB(Vector3(49, 99, -1), Vector3(2, 2, 2)), scenario).size() == 1);
+
+	Vector<RID> hidden;
+	for (int i = 0; i < instance_count; i += 2) {
+		hidden.push_back(instances[i]);
+	}
+	rs->instances_set_visible(hidden, false);
+	CHECK(rs->instances_cull_aabb(AABB(Vector3(-1, 99, -1), Vector3(1000, 2, 2)), scenario).size() == instance_count / 2);
+	rs->instances_set_visible(hidden, true);
+	CHECK(rs->instances_cull_aabb(AABB(Vector3(-1, 99, -1), Vector3(1000, 2, 2)), scenario).size() == instance_count);
+
+	// Mismatched sizes are rejected without touching any instance.
+	ERR_PRINT_OFF;
+	transforms.resize(transforms.size() - 1);
+	rs->instances_set_transforms(instances, transforms);
+	ERR_PRINT_ON;
+	CHECK(rs->instances_cull_aabb(AABB(Vector3(49, 99, -1), Vector3(2, 2, 2)), scenario).size() == 1);
+
+	for (const RID &instance : instances) {
+		rs->free(instance);
+	}
+	rs->free(mesh);
+	rs->free(scenario);
+}
+
+} // namespace TestRendererSceneCull
+
+#endif // TEST_RENDERER_SCENE_CULL_H
@@ -0,0 +1,249 @@
+/**************************************************************************/
+/*  test_shader_compiler.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SHADER_COMPILER_H
+#define TEST_SHADER_COMPILER_H
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "servers/rendering/shader_compiler.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+class TestShaderCompilerInternalsAccessor {
+public:
+	static String get_cache_key(const ShaderCompiler &p_compiler, RS::ShaderMode p_mode, const String &p_code, const ShaderCompiler::IdentifierActions &p_actions) {
+		return p_compiler._get_cache_key(p_mode, p_code, p_actions);
+	}
+
+	// Replaces the cached uniform block, so a result coming from a cache can be told apart from a new compilation.
+	static bool mark_memory_cache(ShaderCompiler &p_compiler, const String &p_key, const String &p_marker) {
+		const ShaderCompiler::CacheEntry *cached = p_compiler.compile_cache.getptr(p_key);
+		if (!cached) {
+			return false;
+		}
+		ShaderCompiler::CacheEntry entry = *cached;
+		entry.gen_code.uniforms = p_marker;
+		p_compiler.compile_cache.insert(p_key, entry);
+		return true;
+	}
+
+	static bool mark_disk_cache(ShaderCompiler &p_compiler, const String &p_key, const String &p_marker) {
+		const ShaderCompiler::CacheEntry *cached = p_compiler.compile_cache.getptr(p_key);
+		if (!cached) {
+			return false;
+		}
+		ShaderCompiler::CacheEntry entry = *cached;
+		entry.gen_code.uniforms = p_marker;
+		p_compiler._save_to_cache(p_key, entry);
+		return true;
+	}
+};
+
+namespace TestShaderCompiler {
+
+struct CompileResult {
+	Error error = FAILED;
+	ShaderCompiler::GeneratedCode gen_code;
+	HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+	int blend_mode = 0;
+	bool unshaded = false;
+	bool uses_screen_texture = false;
+	bool writes_modulate = false;
+};
+
+static ShaderCompiler::IdentifierActions make_canvas_item_actions(CompileResult &r_result) {
+	ShaderCompiler::IdentifierActions actions;
+	actions.entry_point_stages["vertex"] = ShaderCompiler::STAGE_VERTEX;
+	actions.entry_point_stages["fragment"] = ShaderCompiler::STAGE_FRAGMENT;
+	actions.render_mode_values["blend_add"] = Pair<int *, int>(&r_result.blend_mode, 1);
+	actions.render_mode_values["blend_mul"] = Pair<int *, int>(&r_result.blend_mode, 2);
+	actions.render_mode_flags["unshaded"] = &r_result.unshaded;
+	actions.usage_flag_pointers["SCREEN_TEXTURE"] = &r_result.uses_screen_texture;
+	actions.write_flag_pointers["COLOR"] = &r_result.writes_modulate;
+	actions.uniforms = &r_result.uniforms;
+	return actions;
+}
+
+static CompileResult compile_canvas_item(ShaderCompiler &p_compiler, const String &p_code) {
+	CompileResult result;
+	ShaderCompiler::IdentifierActions actions = make_canvas_item_actions(result);
+	result.error = p_compiler.compile(RS::SHADER_CANVAS_ITEM, p_code, &actions, "", result.gen_code);
+	return result;
+}
+
+static String get_canvas_item_cache_key(const ShaderCompiler &p_compiler, const String &p_code) {
+	CompileResult result;
+	return TestShaderCompilerInternalsAccessor::get_cache_key(p_compiler, RS::SHADER_CANVAS_ITEM, p_code, make_canvas_item_actions(result));
+}
+
+static void check_same_result(const CompileResult &p_a, const CompileResult &p_b) {
+	CHECK(p_a.error == p_b.error);
+	CHECK(p_a.gen_code.uniforms == p_b.gen_code.uniforms);
+	CHECK(p_a.gen_code.uniform_total_size == p_b.gen_code.uniform_total_size);
+	CHECK(p_a.gen_code.texture_uniforms.size() == p_b.gen_code.texture_uniforms.size());
+	CHECK(p_a.gen_code.code.size() == p_b.gen_code.code.size());
+	for (const KeyValue<String, String> &E : p_a.gen_code.code) {
+		CHECK(p_b.gen_code.code.has(E.key));
+		CHECK(p_b.gen_code.code[E.key] == E.value);
+	}
+	CHECK(p_a.blend_mode == p_b.blend_mode);
+	CHECK(p_a.unshaded == p_b.unshaded);
+	CHECK(p_a.writes_modulate == p_b.writes_modulate);
+	CHECK(p_a.uniforms.size() == p_b.uniforms.size());
+	for (const KeyValue<StringName, ShaderLanguage::ShaderNode::Uniform> &E : p_a.uniforms) {
+		CHECK(p_b.uniforms.has(E.key));
+		CHECK(p_b.uniforms[E.key].type == E.value.type);
+		CHECK(p_b.uniforms[E.key].order == E.value.order);
+		CHECK(p_b.uniforms[E.key].default_value.size() == E.value.default_value.size());
+	}
+}
+
+static const char *test_shader = R"(
+shader_type canvas_item;
+render_mode blend_mul, unshaded;
+
+uniform vec4 tint : source_color = vec4(1.0, 0.5, 0.25, 1.0);
+uniform float strength : hint_range(0.0, 2.0) = 1.0;
+
+void fragment() {
+	COLOR = texture(TEXTURE, UV) * tint * strength;
+}
+)";
+
+TEST_CASE("[SceneTree][ShaderCompiler] Compiled shaders are reused") {
+	ShaderCompiler::DefaultIdentifierActions default_actions;
+	default_actions.renames["COLOR"] = "color";
+	default_actions.renames["TEXTURE"] = "color_texture";
+	default_actions.renames["UV"] = "uv";
+	default_actions.base_uniform_string = "material.";
+
+	ShaderCompiler compiler;
+	compiler.initialize(default_actions);
+
+	CompileResult first = compile_canvas_item(compiler, test_shader);
+	REQUIRE(first.error == OK);
+	CHECK(first.blend_mode == 2);
+	CHECK(first.unshaded);
+	CHECK(first.writes_modulate);
+	CHECK_FALSE(first.uses_screen_texture);
+	CHECK(first.uniforms.size() == 2);
+
+	const String cache_key = get_canvas_item_cache_key(compiler, test_shader);
+	const String marker = "// Read from the cache.";
+
+	SUBCASE("Compiling the same code again gives the same result") {
+		CompileResult second = compile_canvas_item(compiler, test_shader);
+		check_same_result(first, second);
+
+		REQUIRE(TestShaderCompilerInternalsAccessor::mark_memory_cache(compiler, cache_key, marker));
+		CompileResult third = compile_canvas_item(compiler, test_shader);
+		CHECK_MESSAGE(third.gen_code.uniforms == marker, "The second compilation should come from the memory cache.");
+		// The effects on the caller's actions are replayed from the cache too.
+		CHECK(third.blend_mode == 2);
+		CHECK(third.unshaded);
+		CHECK(third.writes_modulate);
+		CHECK(third.uniforms.size() == 2);
+	}
+
+	SUBCASE("Compilers with other default actions don't share results") {
+		default_actions.base_uniform_string = "params.";
+		ShaderCompiler other;
+		other.initialize(default_actions);
+		CompileResult second = compile_canvas_item(other, test_shader);
+		REQUIRE(second.error == OK);
+		CHECK(second.gen_code.code["fragment"] != first.gen_code.code["fragment"]);
+	}
+
+	SUBCASE("Results are read back from the disk cache") {
+		String cache_dir = TestUtils::get_temp_path("shader_compiler_cache");
+		DirAccess::make_dir_recursive_absolute(cache_dir);
+		Ref<DirAccess> da = DirAccess::open(cache_dir);
+		REQUIRE(da.is_valid());
+		da->erase_contents_recursive(); // Left over from an interrupted run.
+		ShaderCompiler::set_shader_cache_dir(cache_dir);
+
+		ShaderCompiler writer;
+		writer.initialize(default_actions);
+		check_same_result(first, compile_canvas_item(writer, test_shader));
+
+		String compiler_dir = cache_dir.path_join("compiler");
+		PackedStringArray cache_files = DirAccess::get_files_at(compiler_dir);
+		REQUIRE(cache_files.size() == 1);
+		String cache_file = compiler_dir.path_join(cache_files[0]);
+		CHECK(cache_file.get_extension() == "cache");
+
+		// A new compiler has an empty memory cache, so this comes from disk.
+		ShaderCompiler reader;
+		reader.initialize(default_actions);
+		check_same_result(first, compile_canvas_item(reader, test_shader));
+
+		// Rewrite the file with a marker that a new compilation can't produce.
+		REQUIRE(TestShaderCompilerInternalsAccessor::mark_disk_cache(writer, cache_key, marker));
+		ShaderCompiler marked_reader;
+		marked_reader.initialize(default_actions);
+		CompileResult marked = compile_canvas_item(marked_reader, test_shader);
+		CHECK_MESSAGE(marked.gen_code.uniforms == marker, "The result should be read back from the disk cache.");
+		CHECK(marked.blend_mode == 2);
+		CHECK(marked.uniforms.size() == 2);
+
+		// A corrupt file is ignored and the shader is compiled again.
+		Ref<FileAccess> f = FileAccess::open(cache_file, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string("garbage");
+		f.unref();
+
+		ShaderCompiler fallback;
+		fallback.initialize(default_actions);
+		ERR_PRINT_OFF;
+		CompileResult recompiled = compile_canvas_item(fallback, test_shader);
+		ERR_PRINT_ON;
+		check_same_result(first, recompiled);
+		CHECK(recompiled.gen_code.uniforms != marker);
+
+		ShaderCompiler::set_shader_cache_dir(String());
+		da->erase_contents_recursive();
+		da.unref();
+		DirAccess::remove_absolute(cache_dir);
+	}
+
+	SUBCASE("Errors are not cached") {
+		String broken = String(test_shader).replace("strength;", "missing;");
+		ERR_PRINT_OFF;
+		CHECK(compile_canvas_item(compiler, broken).error != OK);
+		CHECK(compile_canvas_item(compiler, broken).error != OK);
+		ERR_PRINT_ON;
+	}
+}
+
+} // namespace TestShaderCompiler
+
+#endif // TEST_SHADER_COMPILER_H
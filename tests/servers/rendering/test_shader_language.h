@@ -0,0 +1,109 @@
+/**************************************************************************/
+/*  test_shader_language.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SHADER_LANGUAGE_H
+#define TEST_SHADER_LANGUAGE_H
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "servers/rendering/shader_language.h"
+#include "servers/rendering/shader_types.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestShaderLanguage {
+
+static Error compile_shader(ShaderLanguage &p_parser, const String &p_code) {
+	// The list of shader types is in the same order as RS::ShaderMode.
+	String type = ShaderLanguage::get_shader_type(p_code);
+	int mode = 0;
+	for (const String &E : ShaderTypes::get_singleton()->get_types_list()) {
+		if (E == type) {
+			break;
+		}
+		mode++;
+	}
+	if (mode == RS::SHADER_MAX) {
+		return ERR_INVALID_DATA;
+	}
+
+	ShaderLanguage::ShaderCompileInfo info;
+	info.functions = ShaderTypes::get_singleton()->get_functions(RS::ShaderMode(mode));
+	info.render_modes = ShaderTypes::get_singleton()->get_modes(RS::ShaderMode(mode));
+	info.shader_types = ShaderTypes::get_singleton()->get_types();
+	return p_parser.compile(p_code, info);
+}
+
+static Vector<String> load_shader_corpus() {
+	Vector<String> corpus;
+	String dir_path = TestUtils::get_data_path("shaders");
+	for (const String &file : DirAccess::get_files_at(dir_path)) {
+		if (file.get_extension() == "gdshader") {
+			corpus.push_back(FileAccess::get_file_as_string(dir_path.path_join(file)));
+		}
+	}
+	return corpus;
+}
+
+TEST_CASE("[ShaderLanguage] Tokenizer") {
+	ShaderLanguage parser;
+	String tokens = parser.token_debug("float x = 0XFFu + 1.5e1f;\nuniform dus_name;");
+	CHECK(tokens == "1: TYPE_FLOAT\n"
+					"1: IDENTIFIER(x)\n"
+					"1: OP_ASSIGN\n"
+					"1: UINT_CONSTANT(255)\n"
+					"1: OP_ADD\n"
+					"1: FLOAT_CONSTANT(15)\n"
+					"1: SEMICOLON\n"
+					"2: UNIFORM\n"
+					"2: IDENTIFIER(_name)\n"
+					"2: SEMICOLON\n");
+}
+
+TEST_CASE("[SceneTree][ShaderLanguage] Shader corpus compiles") {
+	Vector<String> corpus = load_shader_corpus();
+	REQUIRE(corpus.size() > 0);
+
+	// The same parser is reused, like in ShaderCompiler, so nodes left over from
+	// one shader must not leak into the next.
+	ShaderLanguage parser;
+	for (int pass = 0; pass < 2; pass++) {
+		for (const String &code : corpus) {
+			Error err = compile_shader(parser, code);
+			CHECK_MESSAGE(err == OK, parser.get_error_text());
+			CHECK(parser.get_shader() != nullptr);
+		}
+	}
+}
+
+} // namespace TestShaderLanguage
+
+#endif // TEST_SHADER_LANGUAGE_H